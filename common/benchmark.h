@@ -0,0 +1,381 @@
+/**
+ * @file benchmark.h
+ * @brief Benchmark harness: warmup, adaptive repetition, robust statistics and speedup.
+ * 
+ * A case is a callable that performs one run and returns its elapsed time. The harness
+ * discards a few warmup runs, then repeats until the 95% confidence interval of the
+ * mean is tight enough or the case's time budget is spent, and reports min, median,
+ * p95 and standard deviation. Speedup and parallel efficiency are computed against
+ * the same case at one worker (thread or process).
+ */
+#ifndef COMMON_BENCHMARK_H
+#define COMMON_BENCHMARK_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief How long and how precisely each case is measured.
+ */
+struct BenchmarkOptions {
+    int warmupRuns = 2;             // Untimed runs before sampling (caches, page faults, thread pools)
+    int minRuns = 5;
+    int maxRuns = 50;               // Raised to minRuns when smaller
+    double targetPrecision = 0.03;  // Stop once the 95% CI half-width is within this fraction of the mean
+    double maxSeconds = 0.5;        // Stop once the samples of a case add up to this (after minRuns)
+
+    // Combines every process's stop decision so all ranks run the same number of repetitions
+    // (MPI programs pass masterDecision() from mpibenchmark.h). Empty -> the local decision stands.
+    std::function<bool(bool)> agree;
+};
+
+/**
+ * @brief Summary of the timed runs of one case.
+ */
+struct BenchmarkStats {
+    int runs = 0;
+    double min = 0.0;
+    double median = 0.0;
+    double mean = 0.0;
+    double p95 = 0.0;
+    double stddev = 0.0;            // Sample standard deviation
+    double ciHalfWidth = 0.0;       // 95% confidence half-width of the mean
+    bool converged = false;         // Reached targetPrecision before a run or time limit
+    bool failed = false;            // A run reported an error; the statistics are incomplete
+
+    /**
+     * @brief CI half-width relative to the mean.
+     */
+    double relativeError() const { return (mean > 0.0) ? ciHalfWidth / mean : 0.0; }
+};
+
+/**
+ * @brief Two-sided 95% Student t critical value for `degrees` degrees of freedom.
+ */
+inline double studentT95(int degrees) {
+    static const double kTable[] = {12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+                                    2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+                                    2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+    if (degrees < 1)
+        return 0.0;
+    if (degrees <= 30)
+        return kTable[degrees - 1];
+    return 1.960 + 2.4 / degrees;      // Within 0.01 of the exact value beyond 30
+}
+
+/**
+ * @brief Computes the statistics of a set of run times.
+ * 
+ * Percentiles use the nearest-rank method on the sorted samples.
+ */
+inline BenchmarkStats summarizeSamples(std::vector<double> samples) {
+    BenchmarkStats stats;
+    stats.runs = static_cast<int>(samples.size());
+    if (samples.empty())
+        return stats;
+
+    std::sort(samples.begin(), samples.end());
+    const size_t kCount = samples.size();
+    stats.min = samples.front();
+    stats.median = (kCount % 2 == 1) ? samples[kCount / 2] : 0.5 * (samples[kCount / 2 - 1] + samples[kCount / 2]);
+    const size_t kP95Rank = static_cast<size_t>(std::ceil(0.95 * kCount));
+    stats.p95 = samples[std::max<size_t>(kP95Rank, 1) - 1];
+
+    double sum = 0.0;
+    for (const double kSample : samples)
+        sum += kSample;
+    stats.mean = sum / kCount;
+
+    if (kCount > 1) {
+        double squares = 0.0;
+        for (const double kSample : samples)
+            squares += (kSample - stats.mean) * (kSample - stats.mean);
+        stats.stddev = std::sqrt(squares / (kCount - 1));
+        stats.ciHalfWidth = studentT95(static_cast<int>(kCount) - 1) * stats.stddev / std::sqrt(static_cast<double>(kCount));
+    }
+    return stats;
+}
+
+/**
+ * @brief Measures one case adaptively.
+ * 
+ * @param options Warmup, repetition and precision settings.
+ * @param run Performs one run and returns its time in seconds, or a negative value
+ *        on error, which stops the case and marks it failed. In MPI programs every
+ *        rank must return the same value, e.g. the slowest rank's time.
+ * @return Statistics of the timed (non-warmup) runs.
+ */
+inline BenchmarkStats runBenchmark(const BenchmarkOptions& options, const std::function<double()>& run) {
+    auto agree = [&](bool done) { return options.agree ? options.agree(done) : done; };
+    const int kMaxRuns = std::max(options.maxRuns, options.minRuns);
+
+    bool failed = false;
+    for (int i = 0; i < options.warmupRuns && !failed; ++i)
+        failed = run() < 0.0;
+    failed = agree(failed);
+
+    std::vector<double> samples;
+    double measured = 0.0;
+    bool converged = false;
+    while (!failed) {
+        const double kElapsed = run();
+        if (kElapsed < 0.0) {
+            failed = agree(true);
+            break;
+        }
+        samples.push_back(kElapsed);
+        measured += kElapsed;
+
+        const int kRuns = static_cast<int>(samples.size());
+        bool done = kRuns >= kMaxRuns;
+        if (kRuns >= options.minRuns) {
+            converged = summarizeSamples(samples).relativeError() <= options.targetPrecision;
+            done = done || converged || measured >= options.maxSeconds;
+        }
+        if (agree(done))
+            break;
+    }
+
+    BenchmarkStats stats = summarizeSamples(samples);
+    stats.converged = converged && !failed;
+    stats.failed = failed;
+    return stats;
+}
+
+/**
+ * @brief Parses one of the shared harness options, if `arg` is one.
+ * 
+ * Recognises --warmup=N, --min-runs=N, --max-runs=N (raised to --min-runs when below it),
+ * --precision=F (fraction of the mean) and --max-time=S (seconds per case).
+ * 
+ * @param arg Command-line argument.
+ * @param options Options to update.
+ * @param error Receives a message if the value is invalid.
+ * @return True if the argument was a harness option (valid or not).
+ */
+inline bool parseBenchmarkOption(const std::string& arg, BenchmarkOptions& options, std::string& error) {
+    const size_t kEquals = arg.find('=');
+    if (kEquals == std::string::npos)
+        return false;
+    const std::string kName = arg.substr(0, kEquals);
+    const char* kValue = arg.c_str() + kEquals + 1;
+
+    if (kName == "--warmup") {
+        options.warmupRuns = std::atoi(kValue);
+    } else if (kName == "--min-runs") {
+        options.minRuns = std::atoi(kValue);
+    } else if (kName == "--max-runs") {
+        options.maxRuns = std::atoi(kValue);
+    } else if (kName == "--precision") {
+        options.targetPrecision = std::atof(kValue);
+    } else if (kName == "--max-time") {
+        options.maxSeconds = std::atof(kValue);
+    } else {
+        return false;
+    }
+
+    if (options.warmupRuns < 0 || options.minRuns < 1 || options.maxRuns < 1 || options.targetPrecision < 0.0 ||
+        options.maxSeconds < 0.0)
+        error = "invalid harness option '" + arg + "' (need warmup >= 0, run counts >= 1, precision and time >= 0)";
+    return true;
+}
+
+/**
+ * @brief Usage text of the shared harness options.
+ */
+inline std::string benchmarkUsage() {
+    return "[--warmup=N] [--min-runs=N] [--max-runs=N] [--precision=F] [--max-time=S]";
+}
+
+/**
+ * @brief One-line description of the harness settings for the configuration block.
+ */
+inline std::string describeBenchmarkOptions(const BenchmarkOptions& options) {
+    std::ostringstream text;
+    text << options.warmupRuns << " warmup, " << options.minRuns << "-" << std::max(options.maxRuns, options.minRuns)
+         << " runs until +/-"
+         << options.targetPrecision * 100 << "% (95% CI) or " << options.maxSeconds << " s per case";
+    return text.str();
+}
+
+/**
+ * @brief A named per-run figure measured alongside the time, e.g. a hardware counter.
+ */
+struct BenchmarkMetric {
+    std::string name;
+    double value = 0.0;         // Mean over the timed runs
+};
+
+/**
+ * @brief A measured case with its identity and scaling figures.
+ */
+struct BenchmarkResult {
+    std::string group;          // e.g. element type or workload
+    std::string name;           // Kernel or method
+    long long size = 0;         // Problem size
+    int workers = 1;            // Threads or processes
+    BenchmarkStats stats;
+    double speedup = 0.0;       // Median at 1 worker / this median (0 -> no baseline)
+    double efficiency = 0.0;    // speedup / workers
+    std::vector<BenchmarkMetric> metrics;   // Extra figures of the case, if it collects any
+};
+
+/**
+ * @brief Returns the metric called `name` of a result, or null if it has none.
+ */
+inline const BenchmarkMetric* findMetric(const BenchmarkResult& result, const std::string& name) {
+    for (const BenchmarkMetric& kMetric : result.metrics) {
+        if (kMetric.name == name)
+            return &kMetric;
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Formats a metric value compactly (4 significant digits).
+ */
+inline std::string formatMetric(double value) {
+    std::ostringstream text;
+    text << std::setprecision(4) << value;
+    return text.str();
+}
+
+/**
+ * @brief Ordered collection of cases that are run and reported together.
+ */
+class BenchmarkSuite {
+public:
+    explicit BenchmarkSuite(BenchmarkOptions options = BenchmarkOptions()) : options_(std::move(options)) {}
+
+    /**
+     * @brief Registers a case; see runBenchmark() for the contract of `run`.
+     * 
+     * @param metrics Called once the case is measured with its number of timed runs;
+     *        returns the case's extra figures (empty -> none).
+     */
+    void add(const std::string& group, const std::string& name, long long size, int workers, std::function<double()> run,
+             std::function<std::vector<BenchmarkMetric>(int)> metrics = nullptr) {
+        BenchmarkResult result;
+        result.group = group;
+        result.name = name;
+        result.size = size;
+        result.workers = workers;
+        results_.push_back(result);
+        runs_.push_back(std::move(run));
+        metrics_.push_back(std::move(metrics));
+    }
+
+    /**
+     * @brief Measures every case in registration order, then fills in speedup and efficiency.
+     * 
+     * @return False if any case failed; later cases still run.
+     */
+    bool run() {
+        bool allPassed = true;
+        for (size_t i = 0; i < results_.size(); ++i) {
+            results_[i].stats = runBenchmark(options_, runs_[i]);
+            if (metrics_[i])
+                results_[i].metrics = metrics_[i](results_[i].stats.runs);
+            allPassed = allPassed && !results_[i].stats.failed;
+        }
+
+        for (BenchmarkResult& result : results_) {
+            const BenchmarkResult* kBaseline = find(result.group, result.name, result.size, 1);
+            if (kBaseline != nullptr && result.stats.median > 0.0 && !kBaseline->stats.failed) {
+                result.speedup = kBaseline->stats.median / result.stats.median;
+                result.efficiency = result.speedup / result.workers;
+            }
+        }
+        return allPassed;
+    }
+
+    /**
+     * @brief Returns the case with the given identity, or nullptr.
+     */
+    const BenchmarkResult* find(const std::string& group, const std::string& name, long long size, int workers) const {
+        for (const BenchmarkResult& result : results_) {
+            if (result.group == group && result.name == name && result.size == size && result.workers == workers)
+                return &result;
+        }
+        return nullptr;
+    }
+
+    const std::vector<BenchmarkResult>& results() const { return results_; }
+    const BenchmarkOptions& options() const { return options_; }
+
+    /**
+     * @brief Prints one row per case: repetitions, timing statistics, scaling and any metrics.
+     * 
+     * A CI marked with '*' did not reach the target precision within the limits. Metric
+     * columns follow the order the metrics first appear in; "-" marks a missing one.
+     */
+    void printReport(std::ostream& out = std::cout) const {
+        std::vector<std::string> headers = {"Group", "Case", "Size", "Workers", "Runs", "Min (s)", "Median (s)",
+                                            "p95 (s)", "Stddev (s)", "CI +/-", "Speedup", "Efficiency"};
+        std::vector<int> widths = {12, 14, 10, 9, 6, 12, 12, 12, 12, 9, 9, 11};
+        const std::vector<std::string> kMetricNames = metricNames();
+        for (const std::string& kName : kMetricNames) {
+            headers.push_back(kName);
+            widths.push_back(std::max<int>(12, static_cast<int>(kName.size()) + 2));
+        }
+        int lineLength = 0;
+        for (const int kWidth : widths)
+            lineLength += kWidth;
+
+        for (size_t i = 0; i < headers.size(); ++i)
+            out << std::left << std::setw(widths[i]) << headers[i];
+        out << "\n" << std::string(lineLength, '-') << "\n";
+
+        for (const BenchmarkResult& kResult : results_) {
+            const BenchmarkStats& kStats = kResult.stats;
+            std::ostringstream error, speedup, efficiency;
+            error << std::fixed << std::setprecision(1) << kStats.relativeError() * 100 << "%" << (kStats.converged ? "" : "*");
+            if (kResult.speedup > 0.0) {
+                speedup << std::fixed << std::setprecision(2) << kResult.speedup << "x";
+                efficiency << std::fixed << std::setprecision(0) << kResult.efficiency * 100 << "%";
+            }
+            std::vector<std::string> cells = {
+                kResult.group, kResult.name, std::to_string(kResult.size), std::to_string(kResult.workers),
+                std::to_string(kStats.runs), std::to_string(kStats.min), std::to_string(kStats.median),
+                std::to_string(kStats.p95), std::to_string(kStats.stddev), kStats.failed ? "FAILED" : error.str(),
+                kResult.speedup > 0.0 ? speedup.str() : "-", kResult.speedup > 0.0 ? efficiency.str() : "-"};
+            for (const std::string& kName : kMetricNames) {
+                const BenchmarkMetric* kMetric = findMetric(kResult, kName);
+                cells.push_back(kMetric != nullptr ? formatMetric(kMetric->value) : "-");
+            }
+            for (size_t i = 0; i < cells.size(); ++i)
+                out << std::left << std::setw(widths[i]) << cells[i];
+            out << "\n";
+        }
+    }
+
+    /**
+     * @brief Names of every metric any case collected, in order of first appearance.
+     */
+    std::vector<std::string> metricNames() const {
+        std::vector<std::string> names;
+        for (const BenchmarkResult& kResult : results_) {
+            for (const BenchmarkMetric& kMetric : kResult.metrics) {
+                if (std::find(names.begin(), names.end(), kMetric.name) == names.end())
+                    names.push_back(kMetric.name);
+            }
+        }
+        return names;
+    }
+
+private:
+    BenchmarkOptions options_;
+    std::vector<BenchmarkResult> results_;
+    std::vector<std::function<double()>> runs_;
+    std::vector<std::function<std::vector<BenchmarkMetric>(int)>> metrics_;
+};
+
+#endif // COMMON_BENCHMARK_H
\ No newline at end of file
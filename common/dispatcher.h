@@ -0,0 +1,227 @@
+/**
+ * @file dispatcher.h
+ * @brief Tag-multiplexed message dispatcher: a non-blocking progress loop with handlers per tag.
+ * 
+ * Each rank registers a handler per tag and calls progress() from its main loop. Sends
+ * are non-blocking, so any number of requests of any type can be in flight, and control
+ * tags are probed by name before data, so a control message never waits behind a
+ * backlog of large data messages from the same sender.
+ */
+#ifndef COMMON_DISPATCHER_H
+#define COMMON_DISPATCHER_H
+
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <mpi.h>
+#include <vector>
+
+/**
+ * @brief A received message as seen by a handler.
+ */
+struct IncomingMessage {
+    int source = 0;
+    int tag = 0;
+    const char* data = nullptr;     // Valid only for the duration of the handler call
+    int length = 0;                 // Bytes in data
+
+    /**
+     * @brief Number of whole elements of T in the payload.
+     */
+    template <typename T>
+    int count() const { return length / static_cast<int>(sizeof(T)); }
+
+    /**
+     * @brief Copies the i-th element of type T out of the payload.
+     */
+    template <typename T>
+    T get(int i) const {
+        T value;
+        std::memcpy(&value, data + static_cast<size_t>(i) * sizeof(T), sizeof(T));
+        return value;
+    }
+};
+
+/**
+ * @brief How urgently messages of a tag are picked up.
+ */
+enum class MessageClass { Control, Data };
+
+/**
+ * @brief Receives and dispatches messages by tag and owns the buffers of posted sends.
+ * 
+ * Handlers run inside progress(); they may post() replies but must not call progress()
+ * themselves.
+ */
+class MessageDispatcher {
+public:
+    using Handler = std::function<void(const IncomingMessage&)>;
+
+    /**
+     * @brief Creates a dispatcher on a communicator.
+     * 
+     * @param comm Communicator the messages travel on.
+     * @param prioritizeControl Probe control tags individually before data; false
+     *        dispatches strictly in arrival order (MPI_ANY_TAG only).
+     */
+    explicit MessageDispatcher(MPI_Comm comm, bool prioritizeControl = true)
+        : comm_(comm), prioritizeControl_(prioritizeControl) {}
+
+    MessageDispatcher(const MessageDispatcher&) = delete;
+    MessageDispatcher& operator=(const MessageDispatcher&) = delete;
+
+    ~MessageDispatcher() { drain(); }
+
+    /**
+     * @brief Registers the handler of a tag, replacing any previous one.
+     * 
+     * @param tag Message tag.
+     * @param handler Called once per message with that tag.
+     * @param messageClass Control tags are probed ahead of data on every progress call.
+     */
+    void on(int tag, Handler handler, MessageClass messageClass = MessageClass::Data) {
+        handlers_[tag] = std::move(handler);
+        if (messageClass == MessageClass::Control)
+            controlTags_.push_back(tag);
+    }
+
+    /**
+     * @brief Starts a non-blocking send; the dispatcher keeps the payload alive until it completes.
+     * 
+     * @param dest Destination rank.
+     * @param tag Message tag.
+     * @param payload Bytes to send, taken over by the dispatcher.
+     */
+    void post(int dest, int tag, std::vector<char> payload) {
+        sendBuffers_.push_back(std::move(payload));
+        sendRequests_.emplace_back();
+        const std::vector<char>& kBuffer = sendBuffers_.back();
+        MPI_Isend(kBuffer.data(), static_cast<int>(kBuffer.size()), MPI_CHAR, dest, tag, comm_, &sendRequests_.back());
+    }
+
+    /**
+     * @brief Posts a copy of an array of trivially copyable elements.
+     */
+    template <typename T>
+    void post(int dest, int tag, const T* data, int count) {
+        std::vector<char> payload(static_cast<size_t>(count) * sizeof(T));
+        if (count > 0)
+            std::memcpy(payload.data(), data, payload.size());
+        post(dest, tag, std::move(payload));
+    }
+
+    /**
+     * @brief Dispatches what has arrived and retires completed sends, without blocking.
+     * 
+     * Pending control messages are all handled first. Then up to kDataBurst messages of
+     * any tag are handled in arrival order, so a flood of data cannot starve the caller.
+     * 
+     * @return Number of messages dispatched.
+     */
+    int progress() {
+        int dispatched = 0;
+        if (prioritizeControl_) {
+            for (const int kTag : controlTags_) {
+                while (dispatchOne(kTag))
+                    ++dispatched;
+            }
+        }
+        for (int i = 0; i < kDataBurst && dispatchOne(MPI_ANY_TAG); ++i)
+            ++dispatched;
+        retireSends();
+        return dispatched;
+    }
+
+    /**
+     * @brief Calls progress() until `done` returns true.
+     */
+    void runUntil(const std::function<bool()>& done) {
+        while (!done())
+            progress();
+    }
+
+    /**
+     * @brief Blocks until every posted send has completed.
+     */
+    void drain() {
+        if (!sendRequests_.empty())
+            MPI_Waitall(static_cast<int>(sendRequests_.size()), sendRequests_.data(), MPI_STATUSES_IGNORE);
+        sendRequests_.clear();
+        sendBuffers_.clear();
+    }
+
+    /**
+     * @brief Number of posted sends that have not completed yet.
+     */
+    size_t pendingSends() const { return sendRequests_.size(); }
+
+private:
+    static constexpr int kDataBurst = 4;
+
+    /**
+     * @brief Receives and handles one message with the given tag if one is waiting.
+     */
+    bool dispatchOne(int tag) {
+        int found = 0;
+        MPI_Message message;
+        MPI_Status status;
+        MPI_Improbe(MPI_ANY_SOURCE, tag, comm_, &found, &message, &status);
+        if (!found)
+            return false;
+
+        int length = 0;
+        MPI_Get_count(&status, MPI_CHAR, &length);
+        if (length > static_cast<int>(receiveBuffer_.size()))
+            receiveBuffer_.resize(length);
+        MPI_Mrecv(receiveBuffer_.data(), length, MPI_CHAR, &message, MPI_STATUS_IGNORE);
+
+        const auto kHandler = handlers_.find(status.MPI_TAG);
+        if (kHandler == handlers_.end()) {
+            std::cerr << "* * * Error: no handler for tag " << status.MPI_TAG << " (message from process "
+                << status.MPI_SOURCE << " dropped) * * *\n";
+            return true;
+        }
+        kHandler->second(IncomingMessage{status.MPI_SOURCE, status.MPI_TAG, receiveBuffer_.data(), length});
+        return true;
+    }
+
+    /**
+     * @brief Frees the buffers of sends that have completed.
+     */
+    void retireSends() {
+        if (sendRequests_.empty())
+            return;
+        int completed = 0;
+        completedIndices_.resize(sendRequests_.size());
+        MPI_Testsome(static_cast<int>(sendRequests_.size()), sendRequests_.data(), &completed, completedIndices_.data(),
+                     MPI_STATUSES_IGNORE);
+        if (completed == MPI_UNDEFINED || completed == 0)
+            return;
+
+        // Completed requests are now MPI_REQUEST_NULL; compact both lists in step
+        size_t kept = 0;
+        for (size_t i = 0; i < sendRequests_.size(); ++i) {
+            if (sendRequests_[i] == MPI_REQUEST_NULL)
+                continue;
+            if (kept != i) {
+                sendRequests_[kept] = sendRequests_[i];
+                sendBuffers_[kept] = std::move(sendBuffers_[i]);
+            }
+            ++kept;
+        }
+        sendRequests_.resize(kept);
+        sendBuffers_.resize(kept);
+    }
+
+    MPI_Comm comm_;
+    bool prioritizeControl_;
+    std::map<int, Handler> handlers_;
+    std::vector<int> controlTags_;
+    std::vector<char> receiveBuffer_;                // Grows to the largest message and is reused
+    std::vector<std::vector<char>> sendBuffers_;     // Payloads of in-flight sends, parallel to sendRequests_
+    std::vector<MPI_Request> sendRequests_;
+    std::vector<int> completedIndices_;
+};
+
+#endif // COMMON_DISPATCHER_H
\ No newline at end of file
@@ -0,0 +1,188 @@
+/**
+ * @file hybrid.h
+ * @brief Hybrid MPI+OpenMP start-up: thread support level and per-rank team sizing.
+ * 
+ * Lets a program run one MPI process per socket or node with an OpenMP team inside
+ * it, instead of one single-threaded process per core.
+ */
+#ifndef COMMON_HYBRID_H
+#define COMMON_HYBRID_H
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mpi.h>
+#include <omp.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+/**
+ * @brief Placement of the calling rank and the OpenMP team it runs.
+ */
+struct HybridContext {
+    int worldRank = 0;
+    int worldSize = 1;
+    int localRank = 0;                  // Rank among the processes sharing this node
+    int localSize = 1;                  // Number of processes sharing this node
+    int nodeCores = 1;                  // Hardware threads on this node
+    int rankCores = 1;                  // Cores this rank may use
+    int numThreads = 1;                 // OpenMP team size used by every parallel region
+    int threadLevel = MPI_THREAD_SINGLE;    // Thread support granted by the MPI library
+    bool threadsFromEnv = false;        // Team size taken from OMP_NUM_THREADS
+    std::string processorName;
+    MPI_Comm nodeComm = MPI_COMM_NULL;  // Processes sharing this node
+};
+
+/**
+ * @brief Returns a display name for an MPI thread support level.
+ * 
+ * @param level One of the MPI_THREAD_* constants.
+ * @return Name of the level.
+ */
+inline std::string threadLevelName(int level) {
+    switch (level) {
+        case MPI_THREAD_SINGLE: return "MPI_THREAD_SINGLE";
+        case MPI_THREAD_FUNNELED: return "MPI_THREAD_FUNNELED";
+        case MPI_THREAD_SERIALIZED: return "MPI_THREAD_SERIALIZED";
+        case MPI_THREAD_MULTIPLE: return "MPI_THREAD_MULTIPLE";
+        default: return "unknown";
+    }
+}
+
+/**
+ * @brief Counts the CPUs the calling process is allowed to run on.
+ * 
+ * When the launcher binds each rank (e.g. `mpirun --bind-to socket`), this is the size
+ * of the rank's binding; an unbound rank sees every CPU of the node.
+ * 
+ * @return Number of CPUs in the affinity mask, or 0 when it cannot be read.
+ */
+inline int countAffinityCores() {
+#ifdef __linux__
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    if (sched_getaffinity(0, sizeof(cpuSet), &cpuSet) == 0)
+        return CPU_COUNT(&cpuSet);
+#endif
+    return 0;
+}
+
+/**
+ * @brief Initializes MPI with thread support and sizes the OpenMP team of this rank.
+ * 
+ * Aborts when the library cannot provide `requiredLevel`. The team size comes from
+ * OMP_NUM_THREADS when it is set. Otherwise a bound rank uses the cores of its
+ * binding, and unbound ranks split the node's cores evenly between them, so the
+ * ranks on a node never ask for more threads than it has cores.
+ * 
+ * @param argc Pointer to the argument count passed to main.
+ * @param argv Pointer to the argument vector passed to main.
+ * @param requiredLevel Minimum MPI_THREAD_* level the program needs.
+ * @return Placement of the calling rank; release it with finalizeHybrid().
+ */
+inline HybridContext initHybrid(int* argc, char*** argv, int requiredLevel) {
+    HybridContext context;
+    MPI_Init_thread(argc, argv, requiredLevel, &context.threadLevel);
+    MPI_Comm_size(MPI_COMM_WORLD, &context.worldSize);
+    MPI_Comm_rank(MPI_COMM_WORLD, &context.worldRank);
+
+    if (context.threadLevel < requiredLevel) {
+        if (context.worldRank == 0) {
+            std::cerr << "* * * Error: MPI library provides " << threadLevelName(context.threadLevel) << " but "
+                << threadLevelName(requiredLevel) << " is required * * *\n\n";
+        }
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+
+    char processorName[MPI_MAX_PROCESSOR_NAME];
+    int nameLen;
+    MPI_Get_processor_name(processorName, &nameLen);
+    context.processorName.assign(processorName, nameLen);
+
+    // Processes that can share memory live on the same node
+    MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, context.worldRank, MPI_INFO_NULL, &context.nodeComm);
+    MPI_Comm_size(context.nodeComm, &context.localSize);
+    MPI_Comm_rank(context.nodeComm, &context.localRank);
+
+    context.nodeCores = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    const int kAffinityCores = countAffinityCores();
+    if (kAffinityCores > 0 && kAffinityCores < context.nodeCores) {
+        context.rankCores = kAffinityCores;
+    } else {
+        // Unbound: hand out the node's cores round-robin, at least one per rank
+        context.rankCores = std::max(1, context.nodeCores / context.localSize +
+                                        (context.localRank < context.nodeCores % context.localSize ? 1 : 0));
+    }
+
+    context.threadsFromEnv = (std::getenv("OMP_NUM_THREADS") != nullptr);
+    context.numThreads = context.threadsFromEnv ? omp_get_max_threads() : context.rankCores;
+    omp_set_num_threads(context.numThreads);
+    return context;
+}
+
+/**
+ * @brief Releases the node communicator and finalizes MPI.
+ * 
+ * @param context Context returned by initHybrid().
+ */
+inline void finalizeHybrid(HybridContext& context) {
+    MPI_Comm_free(&context.nodeComm);
+    MPI_Finalize();
+}
+
+/**
+ * @brief Prints one line per rank with its node, cores and OpenMP team size on the master.
+ * 
+ * Collective over MPI_COMM_WORLD. Ends with a warning when any node runs more threads
+ * than it has cores.
+ * 
+ * @param context Placement of the calling rank.
+ */
+inline void printHybridLayout(const HybridContext& context) {
+    constexpr int kMasterRank = 0;
+    constexpr int kFields = 5;
+
+    const int kLocal[kFields] = {context.localRank, context.localSize, context.nodeCores, context.rankCores, context.numThreads};
+    std::vector<int> all(static_cast<size_t>(kFields) * context.worldSize);
+    MPI_Gather(kLocal, kFields, MPI_INT, all.data(), kFields, MPI_INT, kMasterRank, MPI_COMM_WORLD);
+
+    // Host names are fixed-size so they fit a plain gather
+    std::vector<char> names(static_cast<size_t>(MPI_MAX_PROCESSOR_NAME) * context.worldSize);
+    std::string localName = context.processorName;
+    localName.resize(MPI_MAX_PROCESSOR_NAME, '\0');
+    MPI_Gather(localName.data(), MPI_MAX_PROCESSOR_NAME, MPI_CHAR, names.data(), MPI_MAX_PROCESSOR_NAME, MPI_CHAR,
+               kMasterRank, MPI_COMM_WORLD);
+
+    // Threads per node, summed over the ranks that share it
+    int nodeThreads = 0;
+    MPI_Allreduce(&context.numThreads, &nodeThreads, 1, MPI_INT, MPI_SUM, context.nodeComm);
+    const int kOversubscribed = (nodeThreads > context.nodeCores) ? 1 : 0;
+    int anyOversubscribed = 0;
+    MPI_Reduce(&kOversubscribed, &anyOversubscribed, 1, MPI_INT, MPI_MAX, kMasterRank, MPI_COMM_WORLD);
+
+    if (context.worldRank != kMasterRank)
+        return;
+
+    std::cout << "\nThread support: " << threadLevelName(context.threadLevel)
+        << "\nTeam size: " << (context.threadsFromEnv ? "OMP_NUM_THREADS" : "cores local to each rank") << "\n";
+    for (int r = 0; r < context.worldSize; ++r) {
+        const int* fields = all.data() + static_cast<size_t>(r) * kFields;
+        std::cout << "[Process " << r << " - " << names.data() + static_cast<size_t>(r) * MPI_MAX_PROCESSOR_NAME << "] "
+            << "local rank " << fields[0] << "/" << fields[1] << ", " << fields[3] << " of " << fields[2]
+            << " cores, " << fields[4] << " OpenMP threads\n";
+    }
+
+    if (anyOversubscribed) {
+        std::cout << "\n- - - Warning: More threads than cores on a node - expect performance impacts due to context switching - - -\n";
+    } else {
+        std::cout << "\n+ + + Good: Every thread can run on a separate core + + +\n";
+    }
+}
+
+#endif // COMMON_HYBRID_H
\ No newline at end of file
@@ -0,0 +1,1308 @@
+/**
+ * @file matrix.h
+ * @brief Dense matrix type, element traits and OpenMP multiply kernels.
+ * 
+ * Shared by the OpenMP matrix benchmark and the MPI programs so every rank runs
+ * the same single-node kernels on its local blocks.
+ */
+#ifndef COMMON_MATRIX_H
+#define COMMON_MATRIX_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <new>
+#include <omp.h>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define MATRIX_HAS_X86_SIMD 1
+#endif
+
+/**
+ * @brief Non-owning view over a rectangular region of a row-major matrix.
+ * 
+ * Elements of a row are contiguous, and consecutive rows are `stride` elements
+ * apart. A view can describe a whole matrix or any sub-block of it without copying.
+ * 
+ * @tparam T Element type (const-qualified for read-only views).
+ */
+template <typename T>
+struct MatrixView {
+    T* data = nullptr;
+    int rows = 0;
+    int cols = 0;
+    int stride = 0;
+
+    T& operator()(int i, int j) const { return data[static_cast<size_t>(i) * stride + j]; }
+    T* row(int i) const { return data + static_cast<size_t>(i) * stride; }
+
+    /**
+     * @brief Returns a view over a sub-block starting at (rowOffset, colOffset).
+     * 
+     * @param rowOffset First row of the sub-block.
+     * @param colOffset First column of the sub-block.
+     * @param numRows Number of rows in the sub-block.
+     * @param numCols Number of columns in the sub-block.
+     * @return View sharing this view's storage and stride.
+     */
+    MatrixView block(int rowOffset, int colOffset, int numRows, int numCols) const {
+        return {row(rowOffset) + colOffset, numRows, numCols, stride};
+    }
+
+    /**
+     * @brief Converts a writable view into a read-only view of the same storage.
+     */
+    template <typename U = T, typename = typename std::enable_if<!std::is_const<U>::value>::type>
+    operator MatrixView<const U>() const { return {data, rows, cols, stride}; }
+};
+
+/**
+ * @brief Dense row-major matrix backed by a single aligned buffer.
+ * 
+ * All rows live in one allocation aligned to a cache line, and the row stride is
+ * padded up to a whole number of cache lines so every row starts aligned. This
+ * replaces a vector of row vectors, which costs one heap allocation per row and a
+ * pointer chase on every element access.
+ * 
+ * @tparam T Element type.
+ */
+template <typename T>
+class Matrix {
+public:
+    static constexpr size_t kAlignment = 64;    // Cache line size in bytes
+    static constexpr int kStrideMultiple = static_cast<int>(kAlignment / sizeof(T));
+
+    Matrix() = default;
+
+    /**
+     * @brief Allocates a zero-initialized matrix.
+     * 
+     * @param rows Number of rows.
+     * @param cols Number of columns.
+     */
+    Matrix(int rows, int cols) : Matrix(rows, cols, UninitializedTag{}) {
+        std::memset(buffer_.get(), 0, static_cast<size_t>(rows_) * stride_ * sizeof(T));
+    }
+
+    /**
+     * @brief Allocates a matrix without touching its memory.
+     * 
+     * The pages are only mapped when first written, so the caller decides which
+     * threads touch them first (see zero()).
+     * 
+     * @param rows Number of rows.
+     * @param cols Number of columns.
+     * @return Matrix with unspecified contents.
+     */
+    static Matrix uninitialized(int rows, int cols) {
+        return Matrix(rows, cols, UninitializedTag{});
+    }
+
+    Matrix(const Matrix& other) : Matrix(other.rows_, other.cols_) {
+        std::memcpy(buffer_.get(), other.buffer_.get(), static_cast<size_t>(rows_) * stride_ * sizeof(T));
+    }
+
+    Matrix& operator=(const Matrix& other) {
+        if (this != &other)
+            *this = Matrix(other);
+        return *this;
+    }
+
+    Matrix(Matrix&&) noexcept = default;
+    Matrix& operator=(Matrix&&) noexcept = default;
+
+    int rows() const { return rows_; }
+    int cols() const { return cols_; }
+    int stride() const { return stride_; }
+
+    T* data() { return buffer_.get(); }
+    const T* data() const { return buffer_.get(); }
+
+    T* row(int i) { return buffer_.get() + static_cast<size_t>(i) * stride_; }
+    const T* row(int i) const { return buffer_.get() + static_cast<size_t>(i) * stride_; }
+
+    T& operator()(int i, int j) { return row(i)[j]; }
+    const T& operator()(int i, int j) const { return row(i)[j]; }
+
+    MatrixView<T> view() { return {data(), rows_, cols_, stride_}; }
+    MatrixView<const T> view() const { return {data(), rows_, cols_, stride_}; }
+
+    /**
+     * @brief Zeroes the matrix in parallel, one block of rows per thread.
+     * 
+     * Uses the same static row partition as the row-parallel kernels, so on a fresh
+     * matrix each page is first touched by the thread that will later write it.
+     * 
+     * @param numThreads Number of OpenMP threads to use.
+     */
+    void zero(int numThreads) {
+        #pragma omp parallel for schedule(static) num_threads(numThreads)
+        for (int i = 0; i < rows_; ++i) {
+            std::memset(row(i), 0, static_cast<size_t>(stride_) * sizeof(T));
+        }
+    }
+
+private:
+    struct UninitializedTag {};
+
+    Matrix(int rows, int cols, UninitializedTag)
+        : rows_(rows), cols_(cols),
+          stride_((cols + kStrideMultiple - 1) / kStrideMultiple * kStrideMultiple),
+          buffer_(allocate(static_cast<size_t>(rows) * stride_)) {}
+
+    struct AlignedDeleter {
+        void operator()(T* ptr) const { std::free(ptr); }
+    };
+
+    /**
+     * @brief Allocates a cache-line aligned buffer of `count` elements.
+     * 
+     * @param count Number of elements to allocate.
+     * @return Owning pointer to the buffer.
+     */
+    static std::unique_ptr<T[], AlignedDeleter> allocate(size_t count) {
+        // aligned_alloc requires the byte count to be a multiple of the alignment
+        const size_t bytes = std::max(kAlignment, (count * sizeof(T) + kAlignment - 1) / kAlignment * kAlignment);
+        void* ptr = std::aligned_alloc(kAlignment, bytes);
+        if (ptr == nullptr)
+            throw std::bad_alloc();
+        return std::unique_ptr<T[], AlignedDeleter>(static_cast<T*>(ptr));
+    }
+
+    int rows_ = 0;
+    int cols_ = 0;
+    int stride_ = 0;
+    std::unique_ptr<T[], AlignedDeleter> buffer_;
+};
+
+/**
+ * @brief Compile-time properties of a benchmark element type.
+ * 
+ * Each supported type selects how random bits map to a value, the accumulator used
+ * by the scalar dot-product kernels and whether an AVX2 micro-kernel exists for it.
+ * 
+ * @tparam T Element type.
+ */
+template <typename T>
+struct ElementTraits;
+
+template <>
+struct ElementTraits<int32_t> {
+    using Accumulator = int64_t;    // Widened so the running sum never hits signed overflow
+    static constexpr const char* kName = "int32";
+    static constexpr bool kHasAvx2Kernel = true;
+    static int32_t fromBits(uint64_t bits) { return 1 + static_cast<int32_t>(((bits >> 32) * 100) >> 32); }  // 1-100
+};
+
+template <>
+struct ElementTraits<int64_t> {
+    using Accumulator = int64_t;
+    static constexpr const char* kName = "int64";
+    static constexpr bool kHasAvx2Kernel = false;   // AVX2 has no 64-bit integer multiply
+    static int64_t fromBits(uint64_t bits) { return 1 + static_cast<int64_t>(((bits >> 32) * 100) >> 32); }  // 1-100
+};
+
+template <>
+struct ElementTraits<float> {
+    using Accumulator = double;     // Widened to limit rounding error over long dot products
+    static constexpr const char* kName = "float";
+    static constexpr bool kHasAvx2Kernel = true;
+    static float fromBits(uint64_t bits) { return static_cast<float>(bits >> 40) * 0x1.0p-24f; }    // [0, 1)
+};
+
+template <>
+struct ElementTraits<double> {
+    using Accumulator = double;
+    static constexpr const char* kName = "double";
+    static constexpr bool kHasAvx2Kernel = true;
+    static double fromBits(uint64_t bits) { return static_cast<double>(bits >> 11) * 0x1.0p-53; }  // [0, 1)
+};
+
+/**
+ * @brief SplitMix64 pseudo-random generator.
+ * 
+ * Tiny, fast and statistically solid for benchmark data. Because its state is a
+ * single counter, any number of independent streams can be derived from a key.
+ */
+struct SplitMix64 {
+    uint64_t state;
+
+    explicit SplitMix64(uint64_t seed) : state(seed) {}
+
+    uint64_t next() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+};
+
+/**
+ * @brief Initializes a matrix with random values in parallel.
+ * 
+ * Every row draws from its own SplitMix64 stream keyed on the seed and the row
+ * index, so rows can be filled by any thread in any order and the contents are
+ * bit-identical whatever the thread count. Rows are shared with a static schedule,
+ * matching the row partition of the kernels for first-touch placement.
+ * 
+ * @param seed Seed identifying the matrix contents.
+ * @param matrix Reference to the matrix to be initialized.
+ * @param rows Number of rows in the matrix.
+ * @param cols Number of columns in the matrix.
+ * @param numThreads Number of OpenMP threads to use.
+ */
+template <typename T>
+void initMatrix(uint64_t seed, Matrix<T>& matrix, int rows, int cols, int numThreads) {
+    #pragma omp parallel for schedule(static) num_threads(numThreads)
+    for (int i = 0; i < rows; ++i) {
+        SplitMix64 rng(SplitMix64(seed ^ (static_cast<uint64_t>(i) * 0xD1B54A32D192ED03ULL)).next());
+        T* row = matrix.row(i);
+        for (int j = 0; j < cols; ++j) {
+            row[j] = ElementTraits<T>::fromBits(rng.next());
+        }
+    }
+}
+
+/**
+ * @brief Performs matrix multiplication using OpenMP with outer loop parallelization.
+ * 
+ * Multiplies two square matrices using the standard matrix multiplication algorithm
+ * with OpenMP parallelization applied to the outermost loop (i-loop). This approach
+ * distributes rows of the result matrix across different threads.
+ * 
+ * @param matrix1 First input matrix (left operand).
+ * @param matrix2 Second input matrix (right operand).
+ * @param resultMatrix Reference to the output matrix where results are stored.
+ * @param size Dimension of the square matrices (size x size).
+ * @param numThreads Number of OpenMP threads to use for parallelization.
+ * @return Execution time in seconds.
+ */
+template <typename T>
+double multiplyOuterParallel(const Matrix<T>& matrix1, const Matrix<T>& matrix2, Matrix<T>& resultMatrix, int size, int numThreads) {
+    using Accumulator = typename ElementTraits<T>::Accumulator;
+
+    double startTime;
+    double endTime;
+
+    startTime = omp_get_wtime();
+
+    #pragma omp parallel for num_threads(numThreads)
+    for (int i = 0; i < size; ++i) {
+        for (int j = 0; j < size; ++j) {
+            Accumulator sum = 0;
+            for (int k = 0; k < size; ++k) {
+                sum += static_cast<Accumulator>(matrix1(i, k)) * matrix2(k, j);
+            }
+            resultMatrix(i, j) += static_cast<T>(sum);
+        }
+    }
+
+    endTime = omp_get_wtime();
+
+    return (endTime - startTime);
+}
+
+/**
+ * @brief Performs matrix multiplication using OpenMP with inner loop parallelization.
+ * 
+ * Multiplies two square matrices using the standard matrix multiplication algorithm
+ * with OpenMP parallelization applied to the middle loop (j-loop). This approach
+ * distributes columns of each row across different threads, with the outer loop
+ * remaining sequential.
+ * 
+ * @param matrix1 First input matrix (left operand).
+ * @param matrix2 Second input matrix (right operand).
+ * @param resultMatrix Reference to the output matrix where results are stored.
+ * @param size Dimension of the square matrices (size x size).
+ * @param numThreads Number of OpenMP threads to use for parallelization.
+ * @return Execution time in seconds.
+ */
+template <typename T>
+double multiplyInnerParallel(const Matrix<T>& matrix1, const Matrix<T>& matrix2, Matrix<T>& resultMatrix, int size, int numThreads) {
+    using Accumulator = typename ElementTraits<T>::Accumulator;
+
+    double startTime;
+    double endTime;
+
+    startTime = omp_get_wtime();
+
+    for (int i = 0; i < size; ++i) {
+        #pragma omp parallel for num_threads(numThreads)
+        for (int j = 0; j < size; ++j) {
+            Accumulator sum = 0;
+            for (int k = 0; k < size; ++k) {
+                sum += static_cast<Accumulator>(matrix1(i, k)) * matrix2(k, j);
+            }
+            resultMatrix(i, j) += static_cast<T>(sum);
+        }
+    }
+
+    endTime = omp_get_wtime();
+
+    return (endTime - startTime);
+}
+
+/**
+ * @brief Computes one row of the result matrix using an orphaned worksharing loop.
+ * 
+ * The `omp for` here binds to whichever parallel region is active at the call site,
+ * so the caller can keep one team alive across every row. The loop is `nowait`: with
+ * a static schedule and the same iteration count on every row, each thread always
+ * owns the same columns, and rows never read each other's results, so no barrier
+ * is needed between rows.
+ * 
+ * @param matrix1 First input matrix (left operand).
+ * @param matrix2 Second input matrix (right operand).
+ * @param resultMatrix Reference to the output matrix where results are stored.
+ * @param row Index of the result row to compute.
+ * @param size Dimension of the square matrices (size x size).
+ */
+template <typename T>
+void multiplyRowOrphaned(const Matrix<T>& matrix1, const Matrix<T>& matrix2, Matrix<T>& resultMatrix, int row, int size) {
+    using Accumulator = typename ElementTraits<T>::Accumulator;
+
+    #pragma omp for schedule(static) nowait
+    for (int j = 0; j < size; ++j) {
+        Accumulator sum = 0;
+        for (int k = 0; k < size; ++k) {
+            sum += static_cast<Accumulator>(matrix1(row, k)) * matrix2(k, j);
+        }
+        resultMatrix(row, j) += static_cast<T>(sum);
+    }
+}
+
+/**
+ * @brief Performs inner loop parallelized matrix multiplication inside a single persistent team.
+ * 
+ * Distributes the j-loop across threads like multiplyInnerParallel, but opens one
+ * parallel region around the whole i-loop instead of one per row. Every thread runs
+ * the sequential i-loop and shares each row's columns through the orphaned loop in
+ * multiplyRowOrphaned. This replaces `size` fork/join barriers with a single one at
+ * the end of the region.
+ * 
+ * @param matrix1 First input matrix (left operand).
+ * @param matrix2 Second input matrix (right operand).
+ * @param resultMatrix Reference to the output matrix where results are stored.
+ * @param size Dimension of the square matrices (size x size).
+ * @param numThreads Number of OpenMP threads to use for parallelization.
+ * @return Execution time in seconds.
+ */
+template <typename T>
+double multiplyInnerPersistent(const Matrix<T>& matrix1, const Matrix<T>& matrix2, Matrix<T>& resultMatrix, int size, int numThreads) {
+    double startTime;
+    double endTime;
+
+    startTime = omp_get_wtime();
+
+    #pragma omp parallel num_threads(numThreads)
+    for (int i = 0; i < size; ++i) {
+        multiplyRowOrphaned(matrix1, matrix2, resultMatrix, i, size);
+    }
+
+    endTime = omp_get_wtime();
+
+    return (endTime - startTime);
+}
+
+/**
+ * @brief Performs matrix multiplication using OpenMP with collapsed loop parallelization.
+ * 
+ * Multiplies two square matrices using the standard matrix multiplication algorithm
+ * with OpenMP parallelization applied using the collapse(2) clause. This approach
+ * combines the outer two loops (i and j loops) into a single parallel iteration
+ * space, potentially providing better load balancing across threads.
+ * 
+ * @param matrix1 First input matrix (left operand).
+ * @param matrix2 Second input matrix (right operand).
+ * @param resultMatrix Reference to the output matrix where results are stored.
+ * @param size Dimension of the square matrices (size x size).
+ * @param numThreads Number of OpenMP threads to use for parallelization.
+ * @return Execution time in seconds.
+ */
+template <typename T>
+double multiplyCollapseParallel(const Matrix<T>& matrix1, const Matrix<T>& matrix2, Matrix<T>& resultMatrix, int size, int numThreads) {
+    using Accumulator = typename ElementTraits<T>::Accumulator;
+
+    double startTime;
+    double endTime;
+
+    startTime = omp_get_wtime();
+
+    #pragma omp parallel for collapse(2) num_threads(numThreads)
+    for (int i = 0; i < size; ++i) {
+        for (int j = 0; j < size; ++j) {
+            Accumulator sum = 0;
+            for (int k = 0; k < size; ++k) {
+                sum += static_cast<Accumulator>(matrix1(i, k)) * matrix2(k, j);
+            }
+            resultMatrix(i, j) += static_cast<T>(sum);
+        }
+    }
+
+    endTime = omp_get_wtime();
+
+    return (endTime - startTime);
+}
+
+/**
+ * @brief Performs cache-blocked matrix multiplication using OpenMP across output tiles.
+ * 
+ * Splits the result matrix into `blockSize` x `blockSize` tiles and distributes the
+ * tiles across threads with collapse(2). Each thread walks the shared dimension in
+ * tiles of the same size and runs an i-k-j micro-loop over each tile pair, so the
+ * innermost loop streams contiguously along rows of both `matrix2` and the result
+ * instead of walking `matrix2` down its columns. Every tile of the result is owned by
+ * exactly one thread, so no synchronization is needed.
+ * 
+ * @param matrix1 First input matrix (left operand).
+ * @param matrix2 Second input matrix (right operand).
+ * @param resultMatrix Reference to the output matrix where results are stored.
+ * @param size Dimension of the square matrices (size x size).
+ * @param numThreads Number of OpenMP threads to use for parallelization.
+ * @param blockSize Edge length of a square tile in elements.
+ * @return Execution time in seconds.
+ */
+template <typename T>
+double multiplyTiledParallel(const Matrix<T>& matrix1, const Matrix<T>& matrix2, Matrix<T>& resultMatrix, int size, int numThreads,
+    int blockSize) {
+    double startTime;
+    double endTime;
+
+    const MatrixView<const T> a = matrix1.view();
+    const MatrixView<const T> b = matrix2.view();
+    const MatrixView<T> c = resultMatrix.view();
+
+    startTime = omp_get_wtime();
+
+    #pragma omp parallel for collapse(2) schedule(static) num_threads(numThreads)
+    for (int ii = 0; ii < size; ii += blockSize) {
+        for (int jj = 0; jj < size; jj += blockSize) {
+            const int iEnd = std::min(ii + blockSize, size);
+            const int jEnd = std::min(jj + blockSize, size);
+
+            for (int kk = 0; kk < size; kk += blockSize) {
+                const int kEnd = std::min(kk + blockSize, size);
+
+                // i-k-j micro-loop over the current tile
+                for (int i = ii; i < iEnd; ++i) {
+                    const T* aRow = a.row(i);
+                    T* cRow = c.row(i);
+                    for (int k = kk; k < kEnd; ++k) {
+                        const T aValue = aRow[k];
+                        const T* bRow = b.row(k);
+                        for (int j = jj; j < jEnd; ++j) {
+                            cRow[j] += aValue * bRow[j];
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    endTime = omp_get_wtime();
+
+    return (endTime - startTime);
+}
+
+// Register block of C computed by one micro-kernel call (kMr rows x kNr columns)
+constexpr int kMr = 4;
+constexpr int kNr = 16;
+
+/**
+ * @brief Instruction sets available for the micro-kernel.
+ */
+enum class SimdLevel { Portable, Avx2, Avx512 };
+
+/**
+ * @brief Returns a display name for a SIMD level.
+ * 
+ * @param level The SIMD level.
+ * @return Name of the instruction set.
+ */
+inline std::string simdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::Avx512: return "AVX-512";
+        case SimdLevel::Avx2: return "AVX2";
+        default: return "Portable (omp simd)";
+    }
+}
+
+/**
+ * @brief Detects the widest instruction set supported by the running CPU.
+ * 
+ * AVX2 is only reported together with FMA, and AVX-512 together with its DQ
+ * extension, since the floating-point and 64-bit integer kernels rely on them.
+ * 
+ * @return The best SIMD level for the micro-kernel.
+ */
+inline SimdLevel detectSimdLevel() {
+#ifdef MATRIX_HAS_X86_SIMD
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq"))
+        return SimdLevel::Avx512;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        return SimdLevel::Avx2;
+#endif
+    return SimdLevel::Portable;
+}
+
+/**
+ * @brief Returns the SIMD level the micro-kernel actually uses for element type T.
+ * 
+ * @tparam T Element type.
+ * @param level The SIMD level supported by the CPU.
+ * @return `level`, or Portable when no kernel exists for T at that level.
+ */
+template <typename T>
+SimdLevel effectiveSimdLevel(SimdLevel level) {
+    if (level == SimdLevel::Avx2 && !ElementTraits<T>::kHasAvx2Kernel)
+        return SimdLevel::Portable;
+    return level;
+}
+
+/**
+ * @brief Signature shared by all micro-kernel implementations.
+ * 
+ * Computes a kMr x kNr block of C from a packed A slice (kc columns of kMr rows,
+ * stored column by column) and a packed B slice (kc rows of kNr columns, stored row
+ * by row). The block is written, not accumulated, into the contiguous `cTile`.
+ * 
+ * @tparam T Element type.
+ */
+template <typename T>
+using MicroKernel = void (*)(int kc, const T* packedA, const T* packedB, T* cTile);
+
+/**
+ * @brief Portable micro-kernel vectorized by the compiler through `omp simd`.
+ */
+template <typename T>
+void microKernelPortable(int kc, const T* packedA, const T* packedB, T* cTile) {
+    T acc[kMr][kNr] = {};
+
+    for (int k = 0; k < kc; ++k) {
+        const T* bRow = packedB + k * kNr;
+        for (int r = 0; r < kMr; ++r) {
+            const T aValue = packedA[k * kMr + r];
+            #pragma omp simd
+            for (int j = 0; j < kNr; ++j) {
+                acc[r][j] += aValue * bRow[j];
+            }
+        }
+    }
+
+    for (int r = 0; r < kMr; ++r)
+        std::memcpy(cTile + r * kNr, acc[r], kNr * sizeof(T));
+}
+
+#ifdef MATRIX_HAS_X86_SIMD
+/**
+ * @brief AVX2 int32 micro-kernel holding the 4x16 block of C in eight 256-bit registers.
+ */
+__attribute__((target("avx2")))
+inline void microKernelAvx2(int kc, const int32_t* packedA, const int32_t* packedB, int32_t* cTile) {
+    __m256i c00 = _mm256_setzero_si256(), c01 = _mm256_setzero_si256();
+    __m256i c10 = _mm256_setzero_si256(), c11 = _mm256_setzero_si256();
+    __m256i c20 = _mm256_setzero_si256(), c21 = _mm256_setzero_si256();
+    __m256i c30 = _mm256_setzero_si256(), c31 = _mm256_setzero_si256();
+
+    for (int k = 0; k < kc; ++k) {
+        const __m256i b0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(packedB + k * kNr));
+        const __m256i b1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(packedB + k * kNr + 8));
+        const int32_t* a = packedA + k * kMr;
+
+        __m256i aValue = _mm256_set1_epi32(a[0]);
+        c00 = _mm256_add_epi32(c00, _mm256_mullo_epi32(aValue, b0));
+        c01 = _mm256_add_epi32(c01, _mm256_mullo_epi32(aValue, b1));
+        aValue = _mm256_set1_epi32(a[1]);
+        c10 = _mm256_add_epi32(c10, _mm256_mullo_epi32(aValue, b0));
+        c11 = _mm256_add_epi32(c11, _mm256_mullo_epi32(aValue, b1));
+        aValue = _mm256_set1_epi32(a[2]);
+        c20 = _mm256_add_epi32(c20, _mm256_mullo_epi32(aValue, b0));
+        c21 = _mm256_add_epi32(c21, _mm256_mullo_epi32(aValue, b1));
+        aValue = _mm256_set1_epi32(a[3]);
+        c30 = _mm256_add_epi32(c30, _mm256_mullo_epi32(aValue, b0));
+        c31 = _mm256_add_epi32(c31, _mm256_mullo_epi32(aValue, b1));
+    }
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(cTile + 0 * kNr), c00);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(cTile + 0 * kNr + 8), c01);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(cTile + 1 * kNr), c10);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(cTile + 1 * kNr + 8), c11);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(cTile + 2 * kNr), c20);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(cTile + 2 * kNr + 8), c21);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(cTile + 3 * kNr), c30);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(cTile + 3 * kNr + 8), c31);
+}
+
+/**
+ * @brief AVX2 float micro-kernel holding the 4x16 block of C in eight 256-bit registers.
+ */
+__attribute__((target("avx2,fma")))
+inline void microKernelAvx2(int kc, const float* packedA, const float* packedB, float* cTile) {
+    __m256 acc[kMr][2];
+    for (int r = 0; r < kMr; ++r)
+        acc[r][0] = acc[r][1] = _mm256_setzero_ps();
+
+    for (int k = 0; k < kc; ++k) {
+        const __m256 b0 = _mm256_loadu_ps(packedB + k * kNr);
+        const __m256 b1 = _mm256_loadu_ps(packedB + k * kNr + 8);
+        for (int r = 0; r < kMr; ++r) {
+            const __m256 aValue = _mm256_broadcast_ss(packedA + k * kMr + r);
+            acc[r][0] = _mm256_fmadd_ps(aValue, b0, acc[r][0]);
+            acc[r][1] = _mm256_fmadd_ps(aValue, b1, acc[r][1]);
+        }
+    }
+
+    for (int r = 0; r < kMr; ++r) {
+        _mm256_storeu_ps(cTile + r * kNr, acc[r][0]);
+        _mm256_storeu_ps(cTile + r * kNr + 8, acc[r][1]);
+    }
+}
+
+/**
+ * @brief AVX2 double micro-kernel holding the 4x16 block of C in sixteen 256-bit registers.
+ */
+__attribute__((target("avx2,fma")))
+inline void microKernelAvx2(int kc, const double* packedA, const double* packedB, double* cTile) {
+    __m256d acc[kMr][4];
+    for (int r = 0; r < kMr; ++r)
+        for (int v = 0; v < 4; ++v)
+            acc[r][v] = _mm256_setzero_pd();
+
+    for (int k = 0; k < kc; ++k) {
+        const double* b = packedB + k * kNr;
+        const __m256d b0 = _mm256_loadu_pd(b);
+        const __m256d b1 = _mm256_loadu_pd(b + 4);
+        const __m256d b2 = _mm256_loadu_pd(b + 8);
+        const __m256d b3 = _mm256_loadu_pd(b + 12);
+        for (int r = 0; r < kMr; ++r) {
+            const __m256d aValue = _mm256_broadcast_sd(packedA + k * kMr + r);
+            acc[r][0] = _mm256_fmadd_pd(aValue, b0, acc[r][0]);
+            acc[r][1] = _mm256_fmadd_pd(aValue, b1, acc[r][1]);
+            acc[r][2] = _mm256_fmadd_pd(aValue, b2, acc[r][2]);
+            acc[r][3] = _mm256_fmadd_pd(aValue, b3, acc[r][3]);
+        }
+    }
+
+    for (int r = 0; r < kMr; ++r)
+        for (int v = 0; v < 4; ++v)
+            _mm256_storeu_pd(cTile + r * kNr + v * 4, acc[r][v]);
+}
+
+/**
+ * @brief AVX-512 int32 micro-kernel holding the 4x16 block of C in four 512-bit registers.
+ */
+__attribute__((target("avx512f")))
+inline void microKernelAvx512(int kc, const int32_t* packedA, const int32_t* packedB, int32_t* cTile) {
+    __m512i c0 = _mm512_setzero_si512();
+    __m512i c1 = _mm512_setzero_si512();
+    __m512i c2 = _mm512_setzero_si512();
+    __m512i c3 = _mm512_setzero_si512();
+
+    for (int k = 0; k < kc; ++k) {
+        const __m512i b = _mm512_loadu_si512(packedB + k * kNr);
+        const int32_t* a = packedA + k * kMr;
+
+        c0 = _mm512_add_epi32(c0, _mm512_mullo_epi32(_mm512_set1_epi32(a[0]), b));
+        c1 = _mm512_add_epi32(c1, _mm512_mullo_epi32(_mm512_set1_epi32(a[1]), b));
+        c2 = _mm512_add_epi32(c2, _mm512_mullo_epi32(_mm512_set1_epi32(a[2]), b));
+        c3 = _mm512_add_epi32(c3, _mm512_mullo_epi32(_mm512_set1_epi32(a[3]), b));
+    }
+
+    _mm512_storeu_si512(cTile + 0 * kNr, c0);
+    _mm512_storeu_si512(cTile + 1 * kNr, c1);
+    _mm512_storeu_si512(cTile + 2 * kNr, c2);
+    _mm512_storeu_si512(cTile + 3 * kNr, c3);
+}
+
+/**
+ * @brief AVX-512 int64 micro-kernel holding the 4x16 block of C in eight 512-bit registers.
+ */
+__attribute__((target("avx512f,avx512dq")))
+inline void microKernelAvx512(int kc, const int64_t* packedA, const int64_t* packedB, int64_t* cTile) {
+    __m512i acc[kMr][2];
+    for (int r = 0; r < kMr; ++r)
+        acc[r][0] = acc[r][1] = _mm512_setzero_si512();
+
+    for (int k = 0; k < kc; ++k) {
+        const __m512i b0 = _mm512_loadu_si512(packedB + k * kNr);
+        const __m512i b1 = _mm512_loadu_si512(packedB + k * kNr + 8);
+        for (int r = 0; r < kMr; ++r) {
+            const __m512i aValue = _mm512_set1_epi64(packedA[k * kMr + r]);
+            acc[r][0] = _mm512_add_epi64(acc[r][0], _mm512_mullo_epi64(aValue, b0));
+            acc[r][1] = _mm512_add_epi64(acc[r][1], _mm512_mullo_epi64(aValue, b1));
+        }
+    }
+
+    for (int r = 0; r < kMr; ++r) {
+        _mm512_storeu_si512(cTile + r * kNr, acc[r][0]);
+        _mm512_storeu_si512(cTile + r * kNr + 8, acc[r][1]);
+    }
+}
+
+/**
+ * @brief AVX-512 float micro-kernel holding the 4x16 block of C in four 512-bit registers.
+ */
+__attribute__((target("avx512f")))
+inline void microKernelAvx512(int kc, const float* packedA, const float* packedB, float* cTile) {
+    __m512 acc[kMr];
+    for (int r = 0; r < kMr; ++r)
+        acc[r] = _mm512_setzero_ps();
+
+    for (int k = 0; k < kc; ++k) {
+        const __m512 b = _mm512_loadu_ps(packedB + k * kNr);
+        for (int r = 0; r < kMr; ++r)
+            acc[r] = _mm512_fmadd_ps(_mm512_set1_ps(packedA[k * kMr + r]), b, acc[r]);
+    }
+
+    for (int r = 0; r < kMr; ++r)
+        _mm512_storeu_ps(cTile + r * kNr, acc[r]);
+}
+
+/**
+ * @brief AVX-512 double micro-kernel holding the 4x16 block of C in eight 512-bit registers.
+ */
+__attribute__((target("avx512f")))
+inline void microKernelAvx512(int kc, const double* packedA, const double* packedB, double* cTile) {
+    __m512d acc[kMr][2];
+    for (int r = 0; r < kMr; ++r)
+        acc[r][0] = acc[r][1] = _mm512_setzero_pd();
+
+    for (int k = 0; k < kc; ++k) {
+        const __m512d b0 = _mm512_loadu_pd(packedB + k * kNr);
+        const __m512d b1 = _mm512_loadu_pd(packedB + k * kNr + 8);
+        for (int r = 0; r < kMr; ++r) {
+            const __m512d aValue = _mm512_set1_pd(packedA[k * kMr + r]);
+            acc[r][0] = _mm512_fmadd_pd(aValue, b0, acc[r][0]);
+            acc[r][1] = _mm512_fmadd_pd(aValue, b1, acc[r][1]);
+        }
+    }
+
+    for (int r = 0; r < kMr; ++r) {
+        _mm512_storeu_pd(cTile + r * kNr, acc[r][0]);
+        _mm512_storeu_pd(cTile + r * kNr + 8, acc[r][1]);
+    }
+}
+#endif
+
+/**
+ * @brief Selects the micro-kernel implementation for an element type and SIMD level.
+ * 
+ * Overload resolution on the packed pointer types picks the intrinsic kernel for T,
+ * so every type gets the lane count that matches its register width.
+ * 
+ * @tparam T Element type.
+ * @param level The SIMD level supported by the CPU.
+ * @return Pointer to the matching micro-kernel.
+ */
+template <typename T>
+MicroKernel<T> selectMicroKernel(SimdLevel level) {
+#ifdef MATRIX_HAS_X86_SIMD
+    if (level == SimdLevel::Avx512)
+        return microKernelAvx512;
+    if constexpr (ElementTraits<T>::kHasAvx2Kernel) {
+        if (level == SimdLevel::Avx2)
+            return microKernelAvx2;
+    }
+#endif
+    return microKernelPortable<T>;
+}
+
+/**
+ * @brief Packs a tile of A into kMr-row panels laid out column by column.
+ * 
+ * Rows past the end of the tile are zero padded so the micro-kernel never branches.
+ * 
+ * @param a View over the mc x kc tile of A.
+ * @param packed Destination buffer of at least ceil(mc / kMr) * kMr * kc elements.
+ */
+template <typename T>
+void packA(const MatrixView<const T>& a, T* packed) {
+    for (int ir = 0; ir < a.rows; ir += kMr) {
+        const int mr = std::min(kMr, a.rows - ir);
+        for (int k = 0; k < a.cols; ++k) {
+            for (int r = 0; r < kMr; ++r) {
+                *packed++ = (r < mr) ? a(ir + r, k) : T(0);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Packs a tile of B into kNr-column panels laid out row by row.
+ * 
+ * Columns past the end of the tile are zero padded so the micro-kernel never branches.
+ * 
+ * @param b View over the kc x nc tile of B.
+ * @param packed Destination buffer of at least ceil(nc / kNr) * kNr * kc elements.
+ */
+template <typename T>
+void packB(const MatrixView<const T>& b, T* packed) {
+    for (int jr = 0; jr < b.cols; jr += kNr) {
+        const int nr = std::min(kNr, b.cols - jr);
+        for (int k = 0; k < b.rows; ++k) {
+            const T* bRow = b.row(k) + jr;
+            for (int j = 0; j < kNr; ++j) {
+                *packed++ = (j < nr) ? bRow[j] : T(0);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Accumulates the product of two views into a third with the packed SIMD micro-kernel.
+ * 
+ * Uses the same output-tile decomposition as multiplyTiledParallel. For every step
+ * along the shared dimension, each thread packs its A and B tiles into contiguous
+ * panels and covers the result tile with kMr x kNr register blocks computed by
+ * the micro-kernel for the requested instruction set. The operands may be any
+ * conforming rectangular blocks, so distributed callers can apply it to local panels.
+ * 
+ * @param a View over the m x k left operand.
+ * @param b View over the k x n right operand.
+ * @param c View over the m x n result, accumulated into (c += a * b).
+ * @param numThreads Number of OpenMP threads to use for parallelization.
+ * @param blockSize Edge length of a square tile in elements.
+ * @param simdLevel Instruction set supported by the CPU.
+ */
+template <typename T>
+void multiplySimdViews(const MatrixView<const T>& a, const MatrixView<const T>& b, const MatrixView<T>& c, int numThreads,
+    int blockSize, SimdLevel simdLevel) {
+    const int kRows = c.rows;
+    const int kCols = c.cols;
+    const int kDepth = a.cols;
+    const MicroKernel<T> microKernel = selectMicroKernel<T>(simdLevel);
+
+    // Packed panels are padded to whole register blocks
+    const int kPaddedRows = (blockSize + kMr - 1) / kMr * kMr;
+    const int kPaddedCols = (blockSize + kNr - 1) / kNr * kNr;
+
+    #pragma omp parallel num_threads(numThreads)
+    {
+        std::vector<T> packedA(static_cast<size_t>(kPaddedRows) * blockSize);
+        std::vector<T> packedB(static_cast<size_t>(kPaddedCols) * blockSize);
+        T cTile[kMr * kNr];
+
+        #pragma omp for collapse(2) schedule(static)
+        for (int ii = 0; ii < kRows; ii += blockSize) {
+            for (int jj = 0; jj < kCols; jj += blockSize) {
+                const int mc = std::min(blockSize, kRows - ii);
+                const int nc = std::min(blockSize, kCols - jj);
+
+                for (int kk = 0; kk < kDepth; kk += blockSize) {
+                    const int kc = std::min(blockSize, kDepth - kk);
+
+                    packA<T>(a.block(ii, kk, mc, kc), packedA.data());
+                    packB<T>(b.block(kk, jj, kc, nc), packedB.data());
+
+                    // Cover the result tile with register blocks
+                    for (int ir = 0; ir < mc; ir += kMr) {
+                        const int mr = std::min(kMr, mc - ir);
+                        for (int jr = 0; jr < nc; jr += kNr) {
+                            const int nr = std::min(kNr, nc - jr);
+                            microKernel(kc, packedA.data() + ir * kc, packedB.data() + jr * kc, cTile);
+
+                            for (int r = 0; r < mr; ++r) {
+                                T* cRow = c.row(ii + ir + r) + jj + jr;
+                                const T* tileRow = cTile + r * kNr;
+                                #pragma omp simd
+                                for (int j = 0; j < nr; ++j) {
+                                    cRow[j] += tileRow[j];
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Performs tiled matrix multiplication with a packed SIMD micro-kernel.
+ * 
+ * Square-matrix entry point to multiplySimdViews used by the benchmark.
+ * 
+ * @param matrix1 First input matrix (left operand).
+ * @param matrix2 Second input matrix (right operand).
+ * @param resultMatrix Reference to the output matrix where results are stored.
+ * @param size Dimension of the square matrices (size x size).
+ * @param numThreads Number of OpenMP threads to use for parallelization.
+ * @param blockSize Edge length of a square tile in elements.
+ * @param simdLevel Instruction set supported by the CPU.
+ * @return Execution time in seconds.
+ */
+template <typename T>
+double multiplySimdParallel(const Matrix<T>& matrix1, const Matrix<T>& matrix2, Matrix<T>& resultMatrix, int size, int numThreads,
+    int blockSize, SimdLevel simdLevel) {
+    double startTime;
+    double endTime;
+
+    startTime = omp_get_wtime();
+
+    multiplySimdViews<T>(matrix1.view().block(0, 0, size, size), matrix2.view().block(0, 0, size, size),
+        resultMatrix.view().block(0, 0, size, size), numThreads, blockSize, simdLevel);
+
+    endTime = omp_get_wtime();
+
+    return (endTime - startTime);
+}
+
+/**
+ * @brief Tuning parameters for the recursive task-based multiply.
+ */
+struct RecursiveParams {
+    int cutoff = 128;               // Sub-problems with every dimension at or below this run the blocked leaf kernel
+    int taskDepth = 4;              // Recursion depth below which sub-products are spawned as tasks
+    int strassenThreshold = 0;      // Square sub-problems at or above this use Strassen-Winograd (0 -> never)
+    int blockSize = 64;             // Tile edge for the leaf kernel
+};
+
+/**
+ * @brief Serial cache-blocked multiply-accumulate over views (C += A * B).
+ * 
+ * Same tile walk and i-k-j micro-loop as multiplyTiledParallel, used as the leaf of
+ * the recursive multiply where the parallelism already comes from tasks.
+ * 
+ * @param a View over the m x k left operand.
+ * @param b View over the k x n right operand.
+ * @param c View over the m x n result to accumulate into.
+ * @param blockSize Edge length of a square tile in elements.
+ */
+template <typename T>
+void multiplyBlockedSerial(const MatrixView<const T>& a, const MatrixView<const T>& b, const MatrixView<T>& c, int blockSize) {
+    for (int ii = 0; ii < a.rows; ii += blockSize) {
+        const int iEnd = std::min(ii + blockSize, a.rows);
+        for (int kk = 0; kk < a.cols; kk += blockSize) {
+            const int kEnd = std::min(kk + blockSize, a.cols);
+            for (int jj = 0; jj < b.cols; jj += blockSize) {
+                const int jEnd = std::min(jj + blockSize, b.cols);
+
+                for (int i = ii; i < iEnd; ++i) {
+                    const T* aRow = a.row(i);
+                    T* cRow = c.row(i);
+                    for (int k = kk; k < kEnd; ++k) {
+                        const T aValue = aRow[k];
+                        const T* bRow = b.row(k);
+                        #pragma omp simd
+                        for (int j = jj; j < jEnd; ++j) {
+                            cRow[j] += aValue * bRow[j];
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Writes `out = x + sign * y` element by element.
+ */
+template <typename T>
+void combineViews(const MatrixView<const T>& x, const MatrixView<const T>& y, T sign, const MatrixView<T>& out) {
+    for (int i = 0; i < out.rows; ++i) {
+        const T* xRow = x.row(i);
+        const T* yRow = y.row(i);
+        T* outRow = out.row(i);
+        #pragma omp simd
+        for (int j = 0; j < out.cols; ++j) {
+            outRow[j] = xRow[j] + sign * yRow[j];
+        }
+    }
+}
+
+/**
+ * @brief Accumulates `c += sign * m` element by element.
+ */
+template <typename T>
+void accumulateView(const MatrixView<T>& c, const MatrixView<const T>& m, T sign) {
+    for (int i = 0; i < c.rows; ++i) {
+        const T* mRow = m.row(i);
+        T* cRow = c.row(i);
+        #pragma omp simd
+        for (int j = 0; j < c.cols; ++j) {
+            cRow[j] += sign * mRow[j];
+        }
+    }
+}
+
+template <typename T>
+void multiplyRecursive(const MatrixView<const T>& a, const MatrixView<const T>& b, const MatrixView<T>& c,
+    int depth, const RecursiveParams& params);
+
+/**
+ * @brief One Strassen-Winograd step on an even square problem (C += A * B).
+ * 
+ * Forms the 8 operand sums, computes the 7 half-size products as tasks into zeroed
+ * temporaries (each recursing through multiplyRecursive), then folds them into the
+ * four quadrants of C as 4 more tasks.
+ * 
+ * @param a View over the n x n left operand.
+ * @param b View over the n x n right operand.
+ * @param c View over the n x n result to accumulate into.
+ * @param depth Current recursion depth.
+ * @param params Recursion tuning parameters.
+ */
+template <typename T>
+void multiplyStrassenWinograd(const MatrixView<const T>& a, const MatrixView<const T>& b, const MatrixView<T>& c,
+    int depth, const RecursiveParams& params) {
+    const int h = a.rows / 2;
+    const bool spawn = depth < params.taskDepth;
+
+    const MatrixView<const T> a11 = a.block(0, 0, h, h), a12 = a.block(0, h, h, h);
+    const MatrixView<const T> a21 = a.block(h, 0, h, h), a22 = a.block(h, h, h, h);
+    const MatrixView<const T> b11 = b.block(0, 0, h, h), b12 = b.block(0, h, h, h);
+    const MatrixView<const T> b21 = b.block(h, 0, h, h), b22 = b.block(h, h, h, h);
+
+    // Operand sums: S1..S4 from A and T1..T4 from B
+    Matrix<T> s1 = Matrix<T>::uninitialized(h, h), s2 = Matrix<T>::uninitialized(h, h);
+    Matrix<T> s3 = Matrix<T>::uninitialized(h, h), s4 = Matrix<T>::uninitialized(h, h);
+    Matrix<T> t1 = Matrix<T>::uninitialized(h, h), t2 = Matrix<T>::uninitialized(h, h);
+    Matrix<T> t3 = Matrix<T>::uninitialized(h, h), t4 = Matrix<T>::uninitialized(h, h);
+    combineViews<T>(a21, a22, T(1), s1.view());
+    combineViews<T>(s1.view(), a11, T(-1), s2.view());
+    combineViews<T>(a11, a21, T(-1), s3.view());
+    combineViews<T>(a12, s2.view(), T(-1), s4.view());
+    combineViews<T>(b12, b11, T(-1), t1.view());
+    combineViews<T>(b22, t1.view(), T(-1), t2.view());
+    combineViews<T>(b22, b12, T(-1), t3.view());
+    combineViews<T>(t2.view(), b21, T(-1), t4.view());
+
+    // Seven products into zeroed temporaries
+    std::vector<Matrix<T>> m;
+    for (int i = 0; i < 7; ++i)
+        m.emplace_back(h, h);
+
+    const MatrixView<const T> lhs[7] = {a11, a12, s4.view(), a22, s1.view(), s2.view(), s3.view()};
+    const MatrixView<const T> rhs[7] = {b11, b21, b22, t4.view(), t1.view(), t2.view(), t3.view()};
+    for (int i = 0; i < 7; ++i) {
+        #pragma omp task if(spawn) shared(lhs, rhs, m, params)
+        multiplyRecursive<T>(lhs[i], rhs[i], m[i].view(), depth + 1, params);
+    }
+    #pragma omp taskwait
+
+    // C11 += M1 + M2, C12 += M1 + M6 + M5 + M3, C21 += M1 + M6 + M7 - M4, C22 += M1 + M6 + M7 + M5
+    const MatrixView<T> c11 = c.block(0, 0, h, h), c12 = c.block(0, h, h, h);
+    const MatrixView<T> c21 = c.block(h, 0, h, h), c22 = c.block(h, h, h, h);
+    #pragma omp task if(spawn) shared(m)
+    {
+        accumulateView<T>(c11, m[0].view(), T(1));
+        accumulateView<T>(c11, m[1].view(), T(1));
+    }
+    #pragma omp task if(spawn) shared(m)
+    {
+        accumulateView<T>(c12, m[0].view(), T(1));
+        accumulateView<T>(c12, m[5].view(), T(1));
+        accumulateView<T>(c12, m[4].view(), T(1));
+        accumulateView<T>(c12, m[2].view(), T(1));
+    }
+    #pragma omp task if(spawn) shared(m)
+    {
+        accumulateView<T>(c21, m[0].view(), T(1));
+        accumulateView<T>(c21, m[5].view(), T(1));
+        accumulateView<T>(c21, m[6].view(), T(1));
+        accumulateView<T>(c21, m[3].view(), T(-1));
+    }
+    #pragma omp task if(spawn) shared(m)
+    {
+        accumulateView<T>(c22, m[0].view(), T(1));
+        accumulateView<T>(c22, m[5].view(), T(1));
+        accumulateView<T>(c22, m[6].view(), T(1));
+        accumulateView<T>(c22, m[4].view(), T(1));
+    }
+    #pragma omp taskwait
+}
+
+/**
+ * @brief Recursive divide-and-conquer multiply-accumulate (C += A * B) built on tasks.
+ * 
+ * Problems with every dimension at or below the cutoff run the serial blocked leaf
+ * kernel. Even square problems at or above the Strassen threshold take one
+ * Strassen-Winograd step. Everything else splits all three dimensions in half. The
+ * four quadrants of C become independent tasks, and each runs its two half-size
+ * products one after the other, since both accumulate into the same quadrant.
+ * Below the configured task depth the recursion continues without spawning tasks.
+ * 
+ * @param a View over the m x k left operand.
+ * @param b View over the k x n right operand.
+ * @param c View over the m x n result to accumulate into.
+ * @param depth Current recursion depth.
+ * @param params Recursion tuning parameters.
+ */
+template <typename T>
+void multiplyRecursive(const MatrixView<const T>& a, const MatrixView<const T>& b, const MatrixView<T>& c,
+    int depth, const RecursiveParams& params) {
+    const int m = a.rows;
+    const int k = a.cols;
+    const int n = b.cols;
+
+    if (m <= params.cutoff && k <= params.cutoff && n <= params.cutoff) {
+        multiplyBlockedSerial<T>(a, b, c, params.blockSize);
+        return;
+    }
+
+    if (params.strassenThreshold > 0 && m >= params.strassenThreshold && m == k && k == n && m % 2 == 0) {
+        multiplyStrassenWinograd<T>(a, b, c, depth, params);
+        return;
+    }
+
+    // Split every dimension (a dimension of 1 cannot split and stays whole)
+    const int m1 = (m + 1) / 2, k1 = (k + 1) / 2, n1 = (n + 1) / 2;
+    const int mParts = (m > 1) ? 2 : 1, kParts = (k > 1) ? 2 : 1, nParts = (n > 1) ? 2 : 1;
+    const bool spawn = depth < params.taskDepth;
+
+    for (int bi = 0; bi < mParts; ++bi) {
+        for (int bj = 0; bj < nParts; ++bj) {
+            #pragma omp task if(spawn) firstprivate(bi, bj) shared(a, b, c, params)
+            {
+                const int rowStart = bi * m1, rows = (bi == 0) ? std::min(m1, m) : m - m1;
+                const int colStart = bj * n1, cols = (bj == 0) ? std::min(n1, n) : n - n1;
+                for (int bk = 0; bk < kParts; ++bk) {
+                    const int depthStart = bk * k1, depthLen = (bk == 0) ? std::min(k1, k) : k - k1;
+                    multiplyRecursive<T>(a.block(rowStart, depthStart, rows, depthLen), b.block(depthStart, colStart, depthLen, cols),
+                        c.block(rowStart, colStart, rows, cols), depth + 1, params);
+                }
+            }
+        }
+    }
+    #pragma omp taskwait
+}
+
+/**
+ * @brief Performs recursive divide-and-conquer matrix multiplication using OpenMP tasks.
+ * 
+ * One thread of the team starts the recursion in multiplyRecursive and the others
+ * execute the tasks it spawns. Task parallelism adapts to the recursion tree instead
+ * of a fixed iteration space, which keeps all cores busy on large problems.
+ * 
+ * @param matrix1 First input matrix (left operand).
+ * @param matrix2 Second input matrix (right operand).
+ * @param resultMatrix Reference to the output matrix where results are stored.
+ * @param size Dimension of the square matrices (size x size).
+ * @param numThreads Number of OpenMP threads to use for parallelization.
+ * @param params Recursion tuning parameters (cutoff, task depth, Strassen threshold).
+ * @return Execution time in seconds.
+ */
+template <typename T>
+double multiplyRecursiveTasks(const Matrix<T>& matrix1, const Matrix<T>& matrix2, Matrix<T>& resultMatrix, int size, int numThreads,
+    const RecursiveParams& params) {
+    double startTime;
+    double endTime;
+
+    const MatrixView<const T> a = matrix1.view().block(0, 0, size, size);
+    const MatrixView<const T> b = matrix2.view().block(0, 0, size, size);
+    const MatrixView<T> c = resultMatrix.view().block(0, 0, size, size);
+
+    startTime = omp_get_wtime();
+
+    #pragma omp parallel num_threads(numThreads)
+    #pragma omp single
+    multiplyRecursive<T>(a, b, c, 0, params);
+
+    endTime = omp_get_wtime();
+
+    return (endTime - startTime);
+}
+
+/**
+ * @brief Checks a matrix product with Freivalds' randomized algorithm.
+ * 
+ * Instead of recomputing the O(n^3) product, each round draws a random vector x and
+ * compares A(Bx) against Cx in O(n^2). Integer types are compared exactly in modular
+ * arithmetic of the element width, so wrap-around in a kernel cannot cause a false
+ * alarm, with x drawn from {0, 1} (a wrong C survives a round with probability at most
+ * 1/2). Floating-point types draw x from [-1, 1) and accept, per row i, a rounding
+ * error of 4 * sqrt(size) * epsilon times the root-sum-square of C(i, j) * x(j): every
+ * entry carries the usual statistical bound for accumulated rounding, and the entries'
+ * independent errors add in quadrature. |A|(|B||x|) / sqrt(size) stands in for that
+ * sum when C(i, j) cancels to near zero. Scaling by the linear sum instead would let
+ * n entries' worth of slack hide one wrong entry; this way an error in C(i, j) is
+ * caught once it exceeds about 4 * size * epsilon times the row's typical entry
+ * (0.05% for float at size 1000), still well above what the kernels produce.
+ * 
+ * @param matrix1 First input matrix (left operand).
+ * @param matrix2 Second input matrix (right operand).
+ * @param resultMatrix The product to check.
+ * @param size Dimension of the square matrices (size x size).
+ * @param rounds Number of independent random vectors to try.
+ * @param seed Seed for the random vectors.
+ * @param numThreads Number of OpenMP threads to use.
+ * @return True when every round agrees.
+ */
+template <typename T>
+bool verifyFreivalds(const Matrix<T>& matrix1, const Matrix<T>& matrix2, const Matrix<T>& resultMatrix,
+    int size, int rounds, uint64_t seed, int numThreads) {
+    // Integers wrap modulo 2^64 (then compare at T's width); floats widen to double
+    using Wide = typename std::conditional<std::is_integral<T>::value, uint64_t, double>::type;
+
+    const double kTolerance = std::is_integral<T>::value ? 0.0 : 4.0 * std::sqrt(static_cast<double>(size)) * std::numeric_limits<T>::epsilon();
+    std::vector<Wide> x(size), bx(size);
+    std::vector<double> bxBound(size);
+    SplitMix64 rng(seed);
+    bool isCorrect = true;
+
+    for (int round = 0; round < rounds && isCorrect; ++round) {
+        for (int j = 0; j < size; ++j) {
+            const uint64_t bits = rng.next();
+            if constexpr (std::is_integral<T>::value)
+                x[j] = bits >> 63;
+            else
+                x[j] = static_cast<double>(bits >> 11) * 0x1.0p-52 - 1.0;
+        }
+
+        // bx = B * x
+        #pragma omp parallel for schedule(static) num_threads(numThreads)
+        for (int i = 0; i < size; ++i) {
+            const T* bRow = matrix2.row(i);
+            Wide sum = 0;
+            double bound = 0;
+            for (int j = 0; j < size; ++j) {
+                sum += static_cast<Wide>(bRow[j]) * x[j];
+                if constexpr (!std::is_integral<T>::value)
+                    bound += std::abs(static_cast<double>(bRow[j]) * x[j]);
+            }
+            bx[i] = sum;
+            bxBound[i] = bound;
+        }
+
+        // Compare A * bx against C * x row by row
+        #pragma omp parallel for schedule(static) num_threads(numThreads) reduction(&&: isCorrect)
+        for (int i = 0; i < size; ++i) {
+            const T* aRow = matrix1.row(i);
+            const T* cRow = resultMatrix.row(i);
+            Wide abx = 0;
+            Wide cx = 0;
+            double bound = 0;
+            double cxSquares = 0;
+            for (int k = 0; k < size; ++k) {
+                abx += static_cast<Wide>(aRow[k]) * bx[k];
+                cx += static_cast<Wide>(cRow[k]) * x[k];
+                if constexpr (!std::is_integral<T>::value) {
+                    bound += std::abs(static_cast<double>(aRow[k])) * bxBound[k];
+                    const double kTerm = static_cast<double>(cRow[k]) * x[k];
+                    cxSquares += kTerm * kTerm;
+                }
+            }
+
+            if constexpr (std::is_integral<T>::value) {
+                using Unsigned = typename std::make_unsigned<T>::type;
+                isCorrect = isCorrect && (static_cast<Unsigned>(abx) == static_cast<Unsigned>(cx));
+            } else {
+                // Written so that NaN fails the check
+                const double kRadius = std::max(std::sqrt(cxSquares), bound / std::sqrt(static_cast<double>(size)));
+                isCorrect = isCorrect && (std::abs(abx - cx) <= kTolerance * kRadius + std::numeric_limits<T>::min());
+            }
+        }
+    }
+
+    return isCorrect;
+}
+
+#endif // COMMON_MATRIX_H
\ No newline at end of file
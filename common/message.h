@@ -0,0 +1,191 @@
+/**
+ * @file message.h
+ * @brief Variable-length MPI messages: probe-sized receives, pooled buffers and struct datatypes.
+ * 
+ * Receivers learn a message's size with a matched probe before receiving it, so no
+ * fixed-size buffer is needed and each payload lands directly in its final storage.
+ * Counts are ints, which limits a single message to 2^31 - 1 elements of its type.
+ */
+#ifndef COMMON_MESSAGE_H
+#define COMMON_MESSAGE_H
+
+#include <cstddef>
+#include <mpi.h>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Maps a C++ type to the MPI datatype used to send it.
+ * 
+ * @tparam T Element type.
+ */
+template <typename T>
+struct MpiType;
+
+template <> struct MpiType<char> { static MPI_Datatype get() { return MPI_CHAR; } };
+template <> struct MpiType<int> { static MPI_Datatype get() { return MPI_INT; } };
+template <> struct MpiType<long long> { static MPI_Datatype get() { return MPI_LONG_LONG; } };
+template <> struct MpiType<float> { static MPI_Datatype get() { return MPI_FLOAT; } };
+template <> struct MpiType<double> { static MPI_Datatype get() { return MPI_DOUBLE; } };
+
+/**
+ * @brief Waits for a matching message and reports its element count.
+ * 
+ * Uses a matched probe, so the message is reserved for the caller even with
+ * MPI_ANY_SOURCE or other threads receiving on the same communicator.
+ * 
+ * @param source Source rank or MPI_ANY_SOURCE.
+ * @param tag Tag or MPI_ANY_TAG.
+ * @param comm Communicator.
+ * @param datatype Element type the message will be received as.
+ * @param message Receives the matched message handle for MPI_Mrecv.
+ * @param status Receives the source and tag of the message.
+ * @return Number of `datatype` elements in the message.
+ */
+inline int probeMessage(int source, int tag, MPI_Comm comm, MPI_Datatype datatype, MPI_Message* message, MPI_Status* status) {
+    MPI_Mprobe(source, tag, comm, message, status);
+    int count = 0;
+    MPI_Get_count(status, datatype, &count);
+    return count;
+}
+
+/**
+ * @brief Sends a contiguous range of elements without staging it.
+ * 
+ * @param data First element.
+ * @param count Number of elements.
+ * @param dest Destination rank.
+ * @param tag Message tag.
+ * @param comm Communicator.
+ */
+template <typename T>
+void sendArray(const T* data, int count, int dest, int tag, MPI_Comm comm) {
+    MPI_Send(data, count, MpiType<T>::get(), dest, tag, comm);
+}
+
+/**
+ * @brief Sends a string's characters; the receiver learns the length from the message.
+ */
+inline void sendString(const std::string& text, int dest, int tag, MPI_Comm comm) {
+    sendArray(text.data(), static_cast<int>(text.size()), dest, tag, comm);
+}
+
+/**
+ * @brief Receives a message of unknown length straight into a vector.
+ * 
+ * The vector is resized once to the probed count and the payload is received into
+ * its storage, so large transfers are never copied through an intermediate buffer.
+ * 
+ * @param out Destination, resized to the message length.
+ * @param source Source rank or MPI_ANY_SOURCE.
+ * @param tag Tag or MPI_ANY_TAG.
+ * @param comm Communicator.
+ * @param status Optional status of the received message.
+ */
+template <typename T>
+void recvVector(std::vector<T>& out, int source, int tag, MPI_Comm comm, MPI_Status* status = MPI_STATUS_IGNORE) {
+    MPI_Message message;
+    MPI_Status probeStatus;
+    out.resize(probeMessage(source, tag, comm, MpiType<T>::get(), &message, &probeStatus));
+    MPI_Mrecv(out.data(), static_cast<int>(out.size()), MpiType<T>::get(), &message, MPI_STATUS_IGNORE);
+    if (status != MPI_STATUS_IGNORE)
+        *status = probeStatus;
+}
+
+/**
+ * @brief Receives a string of unknown length, allocating exactly once.
+ * 
+ * @param source Source rank or MPI_ANY_SOURCE.
+ * @param tag Tag or MPI_ANY_TAG.
+ * @param comm Communicator.
+ * @param status Optional status of the received message.
+ * @return The received text.
+ */
+inline std::string recvString(int source, int tag, MPI_Comm comm, MPI_Status* status = MPI_STATUS_IGNORE) {
+    MPI_Message message;
+    MPI_Status probeStatus;
+    std::string text(probeMessage(source, tag, comm, MPI_CHAR, &message, &probeStatus), '\0');
+    MPI_Mrecv(&text[0], static_cast<int>(text.size()), MPI_CHAR, &message, MPI_STATUS_IGNORE);
+    if (status != MPI_STATUS_IGNORE)
+        *status = probeStatus;
+    return text;
+}
+
+/**
+ * @brief Receive buffer reused across messages of varying length.
+ * 
+ * Grows to the largest message seen and never shrinks, so a stream of receives
+ * allocates only when a new maximum arrives.
+ * 
+ * @tparam T Element type of the messages.
+ */
+template <typename T>
+class MessagePool {
+public:
+    /**
+     * @brief Receives the next matching message into the pooled buffer.
+     * 
+     * @param source Source rank or MPI_ANY_SOURCE.
+     * @param tag Tag or MPI_ANY_TAG.
+     * @param comm Communicator.
+     * @param status Optional status of the received message.
+     * @return Number of elements received; they stay valid until the next receive.
+     */
+    int receive(int source, int tag, MPI_Comm comm, MPI_Status* status = MPI_STATUS_IGNORE) {
+        MPI_Message message;
+        MPI_Status probeStatus;
+        const int kCount = probeMessage(source, tag, comm, MpiType<T>::get(), &message, &probeStatus);
+        if (static_cast<size_t>(kCount) > buffer_.size())
+            buffer_.resize(kCount);
+        MPI_Mrecv(buffer_.data(), kCount, MpiType<T>::get(), &message, MPI_STATUS_IGNORE);
+        if (status != MPI_STATUS_IGNORE)
+            *status = probeStatus;
+        return kCount;
+    }
+
+    const T* data() const { return buffer_.data(); }
+    size_t capacity() const { return buffer_.size(); }
+
+private:
+    std::vector<T> buffer_;
+};
+
+/**
+ * @brief One member of a struct described to MPI.
+ */
+struct StructField {
+    MPI_Aint offset;        // offsetof(Struct, member)
+    MPI_Datatype type;      // Datatype of one element of the member
+    int count;              // Number of elements (1 for scalars)
+};
+
+/**
+ * @brief Builds a committed datatype for a trivially copyable struct.
+ * 
+ * The extent is resized to sizeof(Struct), so arrays of the struct can be sent with
+ * a count and trailing padding is skipped rather than transferred.
+ * 
+ * @tparam Struct The struct being described.
+ * @param fields Members to transfer, with offsets from offsetof.
+ * @return Datatype to be released with MPI_Type_free.
+ */
+template <typename Struct>
+MPI_Datatype makeStructType(const std::vector<StructField>& fields) {
+    std::vector<int> counts;
+    std::vector<MPI_Aint> offsets;
+    std::vector<MPI_Datatype> types;
+    for (const StructField& field : fields) {
+        counts.push_back(field.count);
+        offsets.push_back(field.offset);
+        types.push_back(field.type);
+    }
+
+    MPI_Datatype packedType, structType;
+    MPI_Type_create_struct(static_cast<int>(fields.size()), counts.data(), offsets.data(), types.data(), &packedType);
+    MPI_Type_create_resized(packedType, 0, sizeof(Struct), &structType);
+    MPI_Type_commit(&structType);
+    MPI_Type_free(&packedType);
+    return structType;
+}
+
+#endif // COMMON_MESSAGE_H
\ No newline at end of file
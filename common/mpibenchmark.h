@@ -0,0 +1,50 @@
+/**
+ * @file mpibenchmark.h
+ * @brief MPI side of the benchmark harness: the shared stop decision and the slowest rank's time.
+ * 
+ * Needs only MPI, so the pure MPI programs use the harness without the OpenMP runtime.
+ */
+#ifndef COMMON_MPIBENCHMARK_H
+#define COMMON_MPIBENCHMARK_H
+
+#include <functional>
+#include <mpi.h>
+
+#include "benchmark.h"
+
+/**
+ * @brief Stop decision for BenchmarkOptions::agree that every rank takes from the master.
+ * 
+ * Collective over `comm` on every call. The ranks then leave a repetition loop
+ * together instead of some waiting in the next run's collectives.
+ */
+inline std::function<bool(bool)> masterDecision(MPI_Comm comm) {
+    return [comm](bool done) {
+        MPI_Bcast(&done, 1, MPI_CXX_BOOL, 0, comm);
+        return done;
+    };
+}
+
+/**
+ * @brief Copy of `options` whose ranks all follow the stop decision of rank 0 of `comm`.
+ */
+inline BenchmarkOptions collectiveOptions(const BenchmarkOptions& options, MPI_Comm comm) {
+    BenchmarkOptions shared = options;
+    shared.agree = masterDecision(comm);
+    return shared;
+}
+
+/**
+ * @brief Time of one run as the harness samples it: the slowest rank's, or -1 if any rank failed.
+ * 
+ * Collective over `comm`.
+ */
+inline double slowestRun(double elapsed, bool isCorrect, MPI_Comm comm) {
+    double slowest = 0.0;
+    bool isAllCorrect = false;
+    MPI_Allreduce(&elapsed, &slowest, 1, MPI_DOUBLE, MPI_MAX, comm);
+    MPI_Allreduce(&isCorrect, &isAllCorrect, 1, MPI_CXX_BOOL, MPI_LAND, comm);
+    return isAllCorrect ? slowest : -1.0;
+}
+
+#endif // COMMON_MPIBENCHMARK_H
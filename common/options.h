@@ -0,0 +1,172 @@
+/**
+ * @file options.h
+ * @brief Command-line helpers shared by the benchmark programs and the driver.
+ * 
+ * Integer lists accept ranges, so a scaling sweep is written once ("1:cores:x2")
+ * instead of being baked into a program. An option file given with --config=FILE
+ * holds the same options as the command line, one per line:
+ * 
+ *     # Shared by every program reading the file
+ *     threads = 1:cores:x2
+ *     max-time = 1
+ * 
+ *     [matrix]
+ *     sizes = 64:1024:x2
+ *     no-verify
+ * 
+ * `key = value` becomes `--key=value` and a bare `key` becomes `--key`. Lines before
+ * the first [section] apply to every program; a section applies only to the program
+ * (or driver kernel) of that name. The file's options take the place of --config on
+ * the command line, so options after it override the file.
+ */
+#ifndef COMMON_OPTIONS_H
+#define COMMON_OPTIONS_H
+
+#include <algorithm>
+#include <exception>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Parses one list entry bound: a non-negative integer or "cores" (hardware threads).
+ */
+inline bool parseListValue(const std::string& text, int& value) {
+    if (text == "cores") {
+        value = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+        return true;
+    }
+    size_t parsed = 0;
+    try {
+        value = std::stoi(text, &parsed);
+    } catch (const std::exception&) {
+        return false;
+    }
+    return parsed == text.size() && value >= 0;
+}
+
+/**
+ * @brief Parses a comma-separated list of non-negative integers and ranges.
+ * 
+ * Entries are a value ("16"), an arithmetic range ("100:1000:+100", step 1 if omitted)
+ * or a geometric range ("1:64:x2"). "cores" stands for the number of hardware threads.
+ * Ranges include their first value and every step up to the last value.
+ * 
+ * @param list Text such as "1,2,4" or "10:1000000:x10".
+ * @param values Receives the parsed values.
+ * @return False if an entry is empty, not a number, negative or a malformed range.
+ */
+inline bool parseIntList(const std::string& list, std::vector<int>& values) {
+    values.clear();
+    std::stringstream stream(list);
+    std::string entry;
+    while (std::getline(stream, entry, ',')) {
+        const size_t kFirstColon = entry.find(':');
+        int first = 0;
+        if (kFirstColon == std::string::npos) {
+            if (!parseListValue(entry, first))
+                return false;
+            values.push_back(first);
+            continue;
+        }
+
+        const size_t kSecondColon = entry.find(':', kFirstColon + 1);
+        const std::string kStep = (kSecondColon == std::string::npos) ? "+1" : entry.substr(kSecondColon + 1);
+        int last = 0;
+        int step = 0;
+        if (!parseListValue(entry.substr(0, kFirstColon), first) ||
+            !parseListValue(entry.substr(kFirstColon + 1, kSecondColon - kFirstColon - 1), last) || last < first ||
+            kStep.size() < 2 || (kStep[0] != '+' && kStep[0] != 'x') || !parseListValue(kStep.substr(1), step))
+            return false;
+        const bool kGeometric = (kStep[0] == 'x');
+        if ((kGeometric && (step < 2 || first < 1)) || (!kGeometric && step < 1))
+            return false;
+        for (long long value = first; value <= last; value = kGeometric ? value * step : value + step)
+            values.push_back(static_cast<int>(value));
+    }
+    return !values.empty();
+}
+
+/**
+ * @brief Reads the options of an option file (see the file comment for the format).
+ * 
+ * @param path Option file.
+ * @param section Name of the reading program; lines of other sections are skipped.
+ * @param args Receives the options as `--key[=value]`, appended in file order.
+ * @param error Set when the file cannot be read or a line is malformed.
+ * @param includeShared False -> only the program's own section, not the lines before the first section.
+ * @return False on error.
+ */
+inline bool readOptionsFile(const std::string& path, const std::string& section, std::vector<std::string>& args,
+                            std::string& error, bool includeShared = true) {
+    std::ifstream in(path);
+    if (!in) {
+        error = "cannot read option file '" + path + "'";
+        return false;
+    }
+
+    const auto trim = [](const std::string& text) {
+        const size_t kBegin = text.find_first_not_of(" \t\r");
+        return kBegin == std::string::npos ? std::string() : text.substr(kBegin, text.find_last_not_of(" \t\r") - kBegin + 1);
+    };
+    std::string current;    // Empty -> shared lines before the first section
+    std::string line;
+    for (int lineNumber = 1; std::getline(in, line); ++lineNumber) {
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty())
+            continue;
+        if (line.front() == '[') {
+            if (line.back() != ']' || line.size() < 3) {
+                error = path + ":" + std::to_string(lineNumber) + ": malformed section '" + line + "'";
+                return false;
+            }
+            current = trim(line.substr(1, line.size() - 2));
+            continue;
+        }
+        if (current.empty() ? !includeShared : current != section)
+            continue;
+
+        const size_t kEquals = line.find('=');
+        const std::string kKey = trim(line.substr(0, kEquals));
+        if (kKey.empty() || kKey.rfind("--", 0) == 0 || kKey == "config") {
+            error = path + ":" + std::to_string(lineNumber) + ": invalid option '" + line + "'";
+            return false;
+        }
+        args.push_back("--" + kKey + (kEquals == std::string::npos ? "" : "=" + trim(line.substr(kEquals + 1))));
+    }
+    return true;
+}
+
+/**
+ * @brief Collects the command-line arguments with every --config=FILE replaced by the file's options.
+ * 
+ * @param argc Argument count from main.
+ * @param argv Arguments from main; argv[0] is skipped.
+ * @param section Name of the program, selecting its section of option files.
+ * @param args Receives the arguments in effect.
+ * @param error Set if an option file cannot be used.
+ * @return False on error.
+ */
+inline bool expandArguments(int argc, char** argv, const std::string& section, std::vector<std::string>& args,
+                            std::string& error) {
+    args.clear();
+    for (int i = 1; i < argc; ++i) {
+        const std::string kArg = argv[i];
+        if (kArg.rfind("--config=", 0) != 0)
+            args.push_back(kArg);
+        else if (!readOptionsFile(kArg.substr(9), section, args, error))
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Usage text of the option-file option.
+ */
+inline std::string optionsUsage() {
+    return "[--config=FILE]";
+}
+
+#endif // COMMON_OPTIONS_H
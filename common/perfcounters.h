@@ -0,0 +1,367 @@
+/**
+ * @file perfcounters.h
+ * @brief Optional hardware counters and per-thread barrier idle time around timed regions.
+ * 
+ * PerfCounters counts cycles, instructions and last-level cache misses for the whole
+ * process through Linux perf_event. BarrierIdleProfile collects how long each OpenMP
+ * thread waited at barriers, fed by the loops that time their own barriers and, when
+ * built with BENCHMARK_OMPT against an OMPT-capable runtime (LLVM libomp), by an
+ * OMPT tool for every implicit barrier. CounterProbe turns begin()/end() around each
+ * timed run into BenchmarkMetric values for the harness tables.
+ * 
+ * Counters the kernel or the machine does not offer (no PMU in a VM, strict
+ * perf_event_paranoid) are reported as unavailable instead of failing the run.
+ */
+#ifndef COMMON_PERFCOUNTERS_H
+#define COMMON_PERFCOUNTERS_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <omp.h>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(BENCHMARK_OMPT) && defined(__has_include)
+#if __has_include(<omp-tools.h>)
+#include <omp-tools.h>
+#define BENCHMARK_HAS_OMPT 1
+#endif
+#endif
+
+/**
+ * @brief Events counted by PerfCounters.
+ */
+enum class CounterEvent { Cycles, Instructions, LlcMisses };
+
+const std::vector<CounterEvent> kAllCounterEvents = {CounterEvent::Cycles, CounterEvent::Instructions,
+                                                     CounterEvent::LlcMisses};
+
+/**
+ * @brief Returns the metric name of an event, e.g. "cycles".
+ */
+inline std::string counterEventName(CounterEvent event) {
+    switch (event) {
+        case CounterEvent::Cycles: return "cycles";
+        case CounterEvent::Instructions: return "instructions";
+        case CounterEvent::LlcMisses: return "llc_misses";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief One reading of every counter; only the available ones are meaningful.
+ */
+struct CounterReading {
+    double values[3] = {0.0, 0.0, 0.0};     // Indexed by CounterEvent, scaled for multiplexing
+
+    double operator[](CounterEvent event) const { return values[static_cast<int>(event)]; }
+};
+
+/**
+ * @brief Process-wide user-space hardware counters.
+ * 
+ * Every counter is opened with `inherit`, so threads created afterwards count into it
+ * and a read sums them too. Construct it before the first parallel region, while the
+ * OpenMP thread pool does not exist yet; threads that already run are not counted.
+ */
+class PerfCounters {
+public:
+    PerfCounters() {
+        for (int& fd : fds_)
+            fd = -1;
+#ifdef __linux__
+        const uint64_t kConfigs[3] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES};
+        for (int e = 0; e < 3; ++e) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = kConfigs[e];
+            attr.inherit = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            fds_[e] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        }
+#endif
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    ~PerfCounters() {
+#ifdef __linux__
+        for (const int kFd : fds_) {
+            if (kFd >= 0)
+                close(kFd);
+        }
+#endif
+    }
+
+    bool available(CounterEvent event) const { return fds_[static_cast<int>(event)] >= 0; }
+
+    bool anyAvailable() const {
+        for (const CounterEvent kEvent : kAllCounterEvents) {
+            if (available(kEvent))
+                return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Lists the available counters, or explains that there are none.
+     */
+    std::string describe() const {
+        std::string names;
+        for (const CounterEvent kEvent : kAllCounterEvents) {
+            if (available(kEvent))
+                names += (names.empty() ? "" : ", ") + counterEventName(kEvent);
+        }
+        return names.empty() ? "unavailable (no PMU access; see /proc/sys/kernel/perf_event_paranoid)" : names;
+    }
+
+    /**
+     * @brief Reads every available counter, scaled up when the kernel multiplexed it.
+     */
+    CounterReading read() const {
+        CounterReading reading;
+#ifdef __linux__
+        for (int e = 0; e < 3; ++e) {
+            uint64_t data[3] = {0, 0, 0};   // value, time enabled, time running
+            if (fds_[e] < 0 || ::read(fds_[e], data, sizeof(data)) != static_cast<ssize_t>(sizeof(data)))
+                continue;
+            reading.values[e] = (data[2] > 0 && data[2] < data[1])
+                ? static_cast<double>(data[0]) * data[1] / data[2] : static_cast<double>(data[0]);
+        }
+#endif
+        return reading;
+    }
+
+private:
+    int fds_[3];
+};
+
+/**
+ * @brief Accumulated barrier wait per OpenMP thread.
+ * 
+ * add() is called by thread `tid` only, so slots need no synchronisation; each sits
+ * on its own cache line. Read the totals outside parallel regions.
+ */
+class BarrierIdleProfile {
+public:
+    explicit BarrierIdleProfile(int maxThreads)
+        : maxThreads_(std::max(1, maxThreads)), slots_(new Slot[std::max(1, maxThreads)]) {}
+
+    void add(int tid, double seconds) {
+        if (tid >= 0 && tid < maxThreads_) {
+            slots_[tid].seconds += seconds;
+            slots_[tid].recorded = true;
+        }
+    }
+
+    double seconds(int tid) const { return (tid >= 0 && tid < maxThreads_) ? slots_[tid].seconds : 0.0; }
+
+    /**
+     * @brief True once any thread recorded a wait, i.e. idle time is being measured.
+     */
+    bool recorded() const {
+        for (int t = 0; t < maxThreads_; ++t) {
+            if (slots_[t].recorded)
+                return true;
+        }
+        return false;
+    }
+
+    int maxThreads() const { return maxThreads_; }
+
+private:
+    struct alignas(64) Slot {
+        double seconds = 0.0;
+        bool recorded = false;
+    };
+
+    int maxThreads_;
+    std::unique_ptr<Slot[]> slots_;
+};
+
+#ifdef BENCHMARK_HAS_OMPT
+/**
+ * @brief Profile the OMPT tool adds implicit-barrier waits to; null -> not recorded.
+ */
+inline BarrierIdleProfile*& omptIdleProfile() {
+    static BarrierIdleProfile* profile = nullptr;
+    return profile;
+}
+
+inline void omptSyncRegionWait(ompt_sync_region_t kind, ompt_scope_endpoint_t endpoint, ompt_data_t*, ompt_data_t*,
+                               const void*) {
+    // Explicit barriers are timed by the loops themselves; taskwait and taskgroup are not barriers
+    if (kind == ompt_sync_region_barrier_explicit || kind == ompt_sync_region_taskwait ||
+        kind == ompt_sync_region_taskgroup || kind == ompt_sync_region_reduction)
+        return;
+    thread_local double beginTime = 0.0;
+    if (endpoint == ompt_scope_begin) {
+        beginTime = omp_get_wtime();
+    } else if (BarrierIdleProfile* profile = omptIdleProfile()) {
+        profile->add(omp_get_thread_num(), omp_get_wtime() - beginTime);
+    }
+}
+
+/**
+ * @brief True once the runtime has started the tool and accepted the barrier callback.
+ */
+inline bool& omptBarrierCallbackSet() {
+    static bool isSet = false;
+    return isSet;
+}
+
+inline int omptInitialize(ompt_function_lookup_t lookup, int, ompt_data_t*) {
+    ompt_set_callback_t setCallback = reinterpret_cast<ompt_set_callback_t>(lookup("ompt_set_callback"));
+    if (setCallback != nullptr) {
+        const ompt_set_result_t kResult =
+            setCallback(ompt_callback_sync_region_wait, reinterpret_cast<ompt_callback_t>(&omptSyncRegionWait));
+        omptBarrierCallbackSet() = (kResult != ompt_set_error && kResult != ompt_set_never);
+    }
+    return 1;   // Non-zero keeps the tool active
+}
+
+inline void omptFinalize(ompt_data_t*) {}
+
+/**
+ * @brief OMPT entry point the runtime looks up at start-up; one definition per program.
+ */
+extern "C" ompt_start_tool_result_t* ompt_start_tool(unsigned int, const char*) {
+    static ompt_start_tool_result_t result = {&omptInitialize, &omptFinalize, {0}};
+    return &result;
+}
+#endif
+
+/**
+ * @brief Directs implicit-barrier waits to `profile` (null -> stop); no-op without OMPT.
+ */
+inline void setOmptIdleProfile(BarrierIdleProfile* profile) {
+#ifdef BENCHMARK_HAS_OMPT
+    omptIdleProfile() = profile;
+#else
+    (void)profile;
+#endif
+}
+
+/**
+ * @brief True if implicit barriers are timed through OMPT in this run.
+ * 
+ * Decided at run time: a runtime that ships <omp-tools.h> but never starts tools
+ * (GCC's libgomp) leaves the callback unregistered.
+ */
+inline bool hasOmptBarrierTiming() {
+#ifdef BENCHMARK_HAS_OMPT
+    (void)omp_get_max_threads();   // Initializes the runtime, which starts the tool
+    return omptBarrierCallbackSet();
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Collects counters and barrier idle time over the timed runs of one case.
+ * 
+ * Call begin() and end() around the timed region of every run, warmup included;
+ * metrics() then averages the last `timedRuns` of them.
+ */
+class CounterProbe {
+public:
+    /**
+     * @param counters Process counters (null -> none).
+     * @param idle Barrier profile the case's parallel regions add to (null -> none).
+     * @param numThreads Team size of the case, for the mean idle time per thread.
+     */
+    CounterProbe(const PerfCounters* counters, BarrierIdleProfile* idle, int numThreads)
+        : counters_(counters), idle_(idle), numThreads_(std::max(1, numThreads)) {}
+
+    void begin() {
+        if (counters_ != nullptr)
+            start_ = counters_->read();
+        idleStart_.assign(numThreads_, 0.0);
+        for (int t = 0; t < numThreads_ && idle_ != nullptr; ++t)
+            idleStart_[t] = idle_->seconds(t);
+    }
+
+    void end() {
+        Sample sample;
+        if (counters_ != nullptr) {
+            const CounterReading kEnd = counters_->read();
+            for (int e = 0; e < 3; ++e)
+                sample.counters.values[e] = kEnd.values[e] - start_.values[e];
+        }
+        for (int t = 0; t < numThreads_ && idle_ != nullptr; ++t) {
+            const double kIdle = idle_->seconds(t) - idleStart_[t];
+            sample.idleMax = std::max(sample.idleMax, kIdle);
+            sample.idleTotal += kIdle;
+        }
+        samples_.push_back(sample);
+    }
+
+    /**
+     * @brief Per-run means of the last `timedRuns` samples.
+     * 
+     * Gives cycles, instructions, ipc and llc_misses for the available counters, and
+     * idle_max_us / idle_mean_us (slowest thread, average thread) once barrier waits
+     * have been recorded.
+     */
+    std::vector<BenchmarkMetric> metrics(int timedRuns) const {
+        std::vector<BenchmarkMetric> metrics;
+        const size_t kRuns = std::min(samples_.size(), static_cast<size_t>(std::max(timedRuns, 0)));
+        if (kRuns == 0)
+            return metrics;
+
+        Sample mean;
+        for (size_t r = samples_.size() - kRuns; r < samples_.size(); ++r) {
+            for (int e = 0; e < 3; ++e)
+                mean.counters.values[e] += samples_[r].counters.values[e] / kRuns;
+            mean.idleMax += samples_[r].idleMax / kRuns;
+            mean.idleTotal += samples_[r].idleTotal / kRuns;
+        }
+
+        if (counters_ != nullptr) {
+            for (const CounterEvent kEvent : kAllCounterEvents) {
+                if (counters_->available(kEvent))
+                    metrics.push_back({counterEventName(kEvent), mean.counters[kEvent]});
+                if (kEvent == CounterEvent::Instructions && counters_->available(CounterEvent::Cycles) &&
+                    counters_->available(CounterEvent::Instructions) && mean.counters[CounterEvent::Cycles] > 0)
+                    metrics.push_back({"ipc", mean.counters[CounterEvent::Instructions] / mean.counters[CounterEvent::Cycles]});
+            }
+        }
+        if (idle_ != nullptr && idle_->recorded()) {
+            metrics.push_back({"idle_max_us", mean.idleMax * 1e6});
+            metrics.push_back({"idle_mean_us", mean.idleTotal / numThreads_ * 1e6});
+        }
+        return metrics;
+    }
+
+private:
+    struct Sample {
+        CounterReading counters;
+        double idleMax = 0.0;
+        double idleTotal = 0.0;
+    };
+
+    const PerfCounters* counters_;
+    BarrierIdleProfile* idle_;
+    int numThreads_;
+    CounterReading start_;
+    std::vector<double> idleStart_;
+    std::vector<Sample> samples_;
+};
+
+#endif // COMMON_PERFCOUNTERS_H
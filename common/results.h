@@ -0,0 +1,524 @@
+/**
+ * @file results.h
+ * @brief Machine-readable benchmark results (CSV, JSON) and regression checks against a baseline.
+ * 
+ * Each program collects its harness results into a ResultsSink, tagged with the host,
+ * its core count and the rank and thread counts of the run. The sink writes CSV or JSON
+ * for CI, and reads either format back as a baseline: a case whose median slowed down
+ * by more than the threshold counts as a regression and fails the run.
+ */
+#ifndef COMMON_RESULTS_H
+#define COMMON_RESULTS_H
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "benchmark.h"
+
+#ifdef __unix__
+#include <unistd.h>
+#endif
+
+/**
+ * @brief One measured case with the machine and parallel configuration it ran on.
+ */
+struct ResultRecord {
+    std::string program;
+    std::string host;
+    int cores = 0;              // Hardware threads of the host
+    int ranks = 1;              // MPI processes (1 for OpenMP programs)
+    int threads = 1;            // OpenMP threads per process
+    BenchmarkResult result;
+};
+
+/**
+ * @brief Where results go and what they are compared against, from the command line.
+ */
+struct ResultsOptions {
+    std::string outputPath;     // --results=FILE (.json -> JSON, else CSV); empty -> not written
+    std::string baselinePath;   // --baseline=FILE; empty -> no comparison
+    double threshold = 0.10;    // --threshold=F: slowdown of the median that counts as a regression
+};
+
+/**
+ * @brief Parses one of the results options, if `arg` is one.
+ * 
+ * @param arg Command-line argument.
+ * @param options Options to update.
+ * @param error Receives a message if the value is invalid.
+ * @return True if the argument was a results option (valid or not).
+ */
+inline bool parseResultsOption(const std::string& arg, ResultsOptions& options, std::string& error) {
+    if (arg.rfind("--results=", 0) == 0) {
+        options.outputPath = arg.substr(10);
+        if (options.outputPath.empty())
+            error = "missing file name in '" + arg + "'";
+    } else if (arg.rfind("--baseline=", 0) == 0) {
+        options.baselinePath = arg.substr(11);
+        if (options.baselinePath.empty())
+            error = "missing file name in '" + arg + "'";
+    } else if (arg.rfind("--threshold=", 0) == 0) {
+        options.threshold = std::atof(arg.c_str() + 12);
+        if (options.threshold <= 0.0)
+            error = "threshold must be positive (e.g. 0.1 for 10%)";
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Usage text of the results options.
+ */
+inline std::string resultsUsage() {
+    return "[--results=FILE.csv|FILE.json] [--baseline=FILE] [--threshold=F]";
+}
+
+/**
+ * @brief Host name of the calling process, or "unknown".
+ */
+inline std::string hostName() {
+#ifdef __unix__
+    char name[256] = {};
+    if (gethostname(name, sizeof(name) - 1) == 0 && name[0] != '\0')
+        return name;
+#endif
+    return "unknown";
+}
+
+/**
+ * @brief True if `path` names a JSON file; anything else is treated as CSV.
+ */
+inline bool isJsonPath(const std::string& path) {
+    return path.size() >= 5 && path.compare(path.size() - 5, 5, ".json") == 0;
+}
+
+/**
+ * @brief Field names shared by the CSV header and the JSON keys, in column order.
+ */
+const std::vector<std::string> kResultFields = {"program", "host", "cores", "ranks", "threads", "group", "kernel",
+                                                "size", "workers", "runs", "min_s", "median_s", "mean_s", "p95_s",
+                                                "stddev_s", "ci_half_width_s", "converged", "failed", "speedup",
+                                                "efficiency"};
+
+/**
+ * @brief Collects the results of one program run and writes, reads and compares them.
+ */
+class ResultsSink {
+public:
+    /**
+     * @param program Program name stored with every record.
+     */
+    explicit ResultsSink(const std::string& program)
+        : program_(program), host_(hostName()), cores_(static_cast<int>(std::thread::hardware_concurrency())) {}
+
+    /**
+     * @brief Adds one result.
+     * 
+     * @param result Harness result.
+     * @param ranks MPI processes of the run.
+     * @param threads OpenMP threads per process.
+     */
+    void add(const BenchmarkResult& result, int ranks, int threads) {
+        ResultRecord record;
+        record.program = program_;
+        record.host = host_;
+        record.cores = cores_;
+        record.ranks = ranks;
+        record.threads = threads;
+        record.result = result;
+        records_.push_back(record);
+    }
+
+    /**
+     * @brief Adds every case of an OpenMP suite, whose workers are threads.
+     */
+    void addSuite(const BenchmarkSuite& suite) {
+        for (const BenchmarkResult& kResult : suite.results())
+            add(kResult, 1, kResult.workers);
+    }
+
+    /**
+     * @brief Adds a record as read back from a results file, keeping its program, host and layout.
+     */
+    void addRecord(const ResultRecord& record) { records_.push_back(record); }
+
+    const std::vector<ResultRecord>& records() const { return records_; }
+
+    /**
+     * @brief Writes every record to `path`, as JSON if it ends in .json, else as CSV.
+     * 
+     * Metrics follow the fixed fields, one column (or key) per metric name; a record
+     * without a metric leaves its CSV cell empty and omits the JSON key.
+     * 
+     * @return False if the file could not be written.
+     */
+    bool write(const std::string& path) const {
+        std::ofstream out(path);
+        if (!out)
+            return false;
+        out << std::setprecision(9);
+
+        std::vector<std::string> metricNames;
+        for (const ResultRecord& kRecord : records_) {
+            for (const BenchmarkMetric& kMetric : kRecord.result.metrics) {
+                if (std::find(metricNames.begin(), metricNames.end(), kMetric.name) == metricNames.end())
+                    metricNames.push_back(kMetric.name);
+            }
+        }
+
+        const bool kJson = isJsonPath(path);
+        if (kJson) {
+            out << "{\"results\":[";
+        } else {
+            for (size_t f = 0; f < kResultFields.size(); ++f)
+                out << (f == 0 ? "" : ",") << kResultFields[f];
+            for (const std::string& kName : metricNames)
+                out << "," << quoteCsv(kName);
+            out << "\n";
+        }
+
+        for (size_t r = 0; r < records_.size(); ++r) {
+            const std::vector<std::string> kValues = values(records_[r]);
+            const std::vector<BenchmarkMetric>& kMetrics = records_[r].result.metrics;
+            if (kJson) {
+                out << (r == 0 ? "\n" : ",\n") << "{";
+                for (size_t f = 0; f < kResultFields.size(); ++f) {
+                    out << (f == 0 ? "" : ",") << "\"" << kResultFields[f] << "\":";
+                    if (isTextField(f))
+                        out << "\"" << escapeJson(kValues[f]) << "\"";
+                    else
+                        out << kValues[f];
+                }
+                for (const BenchmarkMetric& kMetric : kMetrics)
+                    out << ",\"" << escapeJson(kMetric.name) << "\":" << kMetric.value;
+                out << "}";
+            } else {
+                for (size_t f = 0; f < kResultFields.size(); ++f)
+                    out << (f == 0 ? "" : ",") << (isTextField(f) ? quoteCsv(kValues[f]) : kValues[f]);
+                for (const std::string& kName : metricNames) {
+                    out << ",";
+                    if (const BenchmarkMetric* kMetric = findMetric(records_[r].result, kName))
+                        out << kMetric->value;
+                }
+                out << "\n";
+            }
+        }
+        if (kJson)
+            out << "\n]}\n";
+        return static_cast<bool>(out);
+    }
+
+    /**
+     * @brief Reads records written by write(), in either format.
+     * 
+     * @param path CSV or JSON file.
+     * @param records Receives the records.
+     * @return False if the file cannot be read or has no recognisable records.
+     */
+    static bool read(const std::string& path, std::vector<ResultRecord>& records) {
+        records.clear();
+        std::ifstream in(path);
+        if (!in)
+            return false;
+        std::stringstream buffer;
+        buffer << in.rdbuf();
+        const std::string kText = buffer.str();
+
+        std::vector<std::map<std::string, std::string>> rows = isJsonPath(path) ? parseJson(kText) : parseCsv(kText);
+        for (std::map<std::string, std::string>& row : rows) {
+            if (row.count("kernel") == 0 || row.count("median_s") == 0)
+                continue;
+            ResultRecord record;
+            record.program = row["program"];
+            record.host = row["host"];
+            record.cores = std::atoi(row["cores"].c_str());
+            record.ranks = std::atoi(row["ranks"].c_str());
+            record.threads = std::atoi(row["threads"].c_str());
+            BenchmarkResult& result = record.result;
+            result.group = row["group"];
+            result.name = row["kernel"];
+            result.size = std::atoll(row["size"].c_str());
+            result.workers = std::atoi(row["workers"].c_str());
+            result.stats.runs = std::atoi(row["runs"].c_str());
+            result.stats.min = std::atof(row["min_s"].c_str());
+            result.stats.median = std::atof(row["median_s"].c_str());
+            result.stats.mean = std::atof(row["mean_s"].c_str());
+            result.stats.p95 = std::atof(row["p95_s"].c_str());
+            result.stats.stddev = std::atof(row["stddev_s"].c_str());
+            result.stats.ciHalfWidth = std::atof(row["ci_half_width_s"].c_str());
+            result.stats.converged = row["converged"] == "true" || row["converged"] == "1";
+            result.stats.failed = row["failed"] == "true" || row["failed"] == "1";
+            result.speedup = std::atof(row["speedup"].c_str());
+            result.efficiency = std::atof(row["efficiency"].c_str());
+            for (const std::pair<const std::string, std::string>& kField : row) {
+                if (!kField.second.empty() &&
+                    std::find(kResultFields.begin(), kResultFields.end(), kField.first) == kResultFields.end())
+                    result.metrics.push_back({kField.first, std::atof(kField.second.c_str())});
+            }
+            records.push_back(record);
+        }
+        return !records.empty();
+    }
+
+    /**
+     * @brief Compares these records with a baseline and prints every matched case.
+     * 
+     * Cases match on program, group, kernel, size, workers, ranks and threads; cases
+     * missing from either side are listed as new or missing and never count as
+     * regressions. A case regresses when its median is slower by more than `threshold`
+     * and by more than the two confidence half-widths together, so noise alone does
+     * not fail a run. A failed case always counts as a regression.
+     * 
+     * @param baseline Records of the reference run.
+     * @param threshold Relative slowdown of the median above which a case regresses.
+     * @param out Stream for the comparison table.
+     * @return Number of regressions.
+     */
+    int compare(const std::vector<ResultRecord>& baseline, double threshold, std::ostream& out = std::cout) const {
+        std::map<Key, const ResultRecord*> reference;
+        for (const ResultRecord& kRecord : baseline)
+            reference[key(kRecord)] = &kRecord;
+
+        const std::vector<std::string> kHeaders = {"Program", "Group", "Case", "Size", "Workers", "Baseline (s)",
+                                                   "Current (s)", "Change", "Status"};
+        const std::vector<int> kWidths = {22, 12, 20, 10, 9, 14, 14, 10, 12};
+        int lineLength = 0;
+        for (const int kWidth : kWidths)
+            lineLength += kWidth;
+        for (size_t i = 0; i < kHeaders.size(); ++i)
+            out << std::left << std::setw(kWidths[i]) << kHeaders[i];
+        out << "\n" << std::string(lineLength, '-') << "\n";
+
+        int regressions = 0, matched = 0;
+        for (const ResultRecord& kRecord : records_) {
+            const BenchmarkResult& kResult = kRecord.result;
+            const auto kFound = reference.find(key(kRecord));
+            std::string baselineTime = "-", change = "-", status = "new";
+            if (kFound != reference.end()) {
+                ++matched;
+                const BenchmarkStats& kBaseline = kFound->second->result.stats;
+                const double kBefore = kBaseline.median;
+                const double kRelative = (kBefore > 0.0) ? kResult.stats.median / kBefore - 1.0 : 0.0;
+                const double kNoise = kBaseline.ciHalfWidth + kResult.stats.ciHalfWidth;
+                std::ostringstream percent;
+                percent << std::fixed << std::setprecision(1) << std::showpos << kRelative * 100 << "%";
+                baselineTime = std::to_string(kBefore);
+                change = percent.str();
+                if (kResult.stats.failed) {
+                    status = "FAILED";
+                } else if (kRelative > threshold && kResult.stats.median - kBefore > kNoise) {
+                    status = "REGRESSION";
+                } else {
+                    status = (kRelative < -threshold) ? "faster" : "ok";
+                }
+                reference.erase(kFound);
+            } else if (kResult.stats.failed) {
+                status = "FAILED";
+            }
+            regressions += (status == "REGRESSION" || status == "FAILED") ? 1 : 0;
+
+            const std::vector<std::string> kCells = {kRecord.program, kResult.group, kResult.name, std::to_string(kResult.size),
+                                                     std::to_string(kResult.workers), baselineTime,
+                                                     std::to_string(kResult.stats.median), change, status};
+            for (size_t i = 0; i < kCells.size(); ++i)
+                out << std::left << std::setw(kWidths[i]) << kCells[i];
+            out << "\n";
+        }
+
+        out << matched << " case(s) matched, " << reference.size() << " baseline case(s) missing from this run, threshold +"
+            << threshold * 100 << "%\n";
+        return regressions;
+    }
+
+private:
+    using Key = std::tuple<std::string, std::string, std::string, long long, int, int, int>;
+
+    static Key key(const ResultRecord& record) {
+        return Key(record.program, record.result.group, record.result.name, record.result.size, record.result.workers,
+                   record.ranks, record.threads);
+    }
+
+    static bool isTextField(size_t field) {
+        return field == 0 || field == 1 || field == 5 || field == 6;
+    }
+
+    static std::vector<std::string> values(const ResultRecord& record) {
+        const BenchmarkResult& kResult = record.result;
+        const BenchmarkStats& kStats = kResult.stats;
+        auto number = [](double value) {
+            std::ostringstream text;
+            text << std::setprecision(9) << value;
+            return text.str();
+        };
+        return {record.program, record.host, std::to_string(record.cores), std::to_string(record.ranks),
+                std::to_string(record.threads), kResult.group, kResult.name, std::to_string(kResult.size),
+                std::to_string(kResult.workers), std::to_string(kStats.runs), number(kStats.min), number(kStats.median),
+                number(kStats.mean), number(kStats.p95), number(kStats.stddev), number(kStats.ciHalfWidth),
+                kStats.converged ? "true" : "false", kStats.failed ? "true" : "false", number(kResult.speedup),
+                number(kResult.efficiency)};
+    }
+
+    static std::string escapeJson(const std::string& text) {
+        std::string escaped;
+        for (const char kChar : text) {
+            if (kChar == '"' || kChar == '\\')
+                escaped += '\\';
+            escaped += kChar;
+        }
+        return escaped;
+    }
+
+    static std::string quoteCsv(const std::string& text) {
+        if (text.find_first_of(",\"\n") == std::string::npos)
+            return text;
+        std::string quoted = "\"";
+        for (const char kChar : text)
+            quoted += (kChar == '"') ? std::string("\"\"") : std::string(1, kChar);
+        return quoted + "\"";
+    }
+
+    // Splits CSV text into rows keyed by the header line; handles quoted fields
+    static std::vector<std::map<std::string, std::string>> parseCsv(const std::string& text) {
+        std::vector<std::vector<std::string>> lines(1);
+        std::string field;
+        bool quoted = false, pending = false;
+        for (size_t i = 0; i < text.size(); ++i) {
+            const char kChar = text[i];
+            if (quoted) {
+                if (kChar == '"' && i + 1 < text.size() && text[i + 1] == '"') {
+                    field += '"';
+                    ++i;
+                } else if (kChar == '"') {
+                    quoted = false;
+                } else {
+                    field += kChar;
+                }
+            } else if (kChar == '"') {
+                quoted = pending = true;
+            } else if (kChar == ',') {
+                lines.back().push_back(field);
+                field.clear();
+            } else if (kChar == '\n') {
+                lines.back().push_back(field);
+                field.clear();
+                lines.emplace_back();
+                pending = false;
+            } else if (kChar != '\r') {
+                field += kChar;
+                pending = true;
+            }
+        }
+        if (pending || !field.empty())
+            lines.back().push_back(field);
+
+        std::vector<std::map<std::string, std::string>> rows;
+        for (size_t l = 1; l < lines.size(); ++l) {
+            if (lines[l].size() != lines[0].size())
+                continue;
+            std::map<std::string, std::string> row;
+            for (size_t f = 0; f < lines[0].size(); ++f)
+                row[lines[0][f]] = lines[l][f];
+            rows.push_back(row);
+        }
+        return rows;
+    }
+
+    // Reads the flat objects write() emits: string, number and boolean values, no nesting
+    static std::vector<std::map<std::string, std::string>> parseJson(const std::string& text) {
+        std::vector<std::map<std::string, std::string>> rows;
+        const size_t kArray = text.find('[');
+        size_t i = (kArray == std::string::npos) ? text.size() : kArray + 1;
+        auto readString = [&](std::string& value) {
+            value.clear();
+            for (++i; i < text.size() && text[i] != '"'; ++i) {
+                if (text[i] == '\\' && i + 1 < text.size())
+                    ++i;
+                value += text[i];
+            }
+            ++i;
+        };
+
+        while (i < text.size()) {
+            const size_t kOpen = text.find('{', i);
+            if (kOpen == std::string::npos)
+                break;
+            i = kOpen + 1;
+            std::map<std::string, std::string> row;
+            while (i < text.size() && text[i] != '}') {
+                if (text[i] != '"') {
+                    ++i;
+                    continue;
+                }
+                std::string name, value;
+                readString(name);
+                while (i < text.size() && (text[i] == ':' || text[i] == ' '))
+                    ++i;
+                if (i < text.size() && text[i] == '"') {
+                    readString(value);
+                } else {
+                    while (i < text.size() && text[i] != ',' && text[i] != '}')
+                        value += text[i++];
+                }
+                row[name] = value;
+            }
+            rows.push_back(row);
+        }
+        return rows;
+    }
+
+    std::string program_;
+    std::string host_;
+    int cores_;
+    std::vector<ResultRecord> records_;
+};
+
+/**
+ * @brief Writes the results and checks them against the baseline as `options` ask.
+ * 
+ * Prints the comparison table and a verdict; errors go to std::cerr.
+ * 
+ * @param sink Results of this run.
+ * @param options Output file, baseline and threshold.
+ * @return False if a file could not be written or read, or a case regressed.
+ */
+inline bool reportResults(const ResultsSink& sink, const ResultsOptions& options) {
+    bool isPassing = true;
+    if (!options.outputPath.empty()) {
+        if (sink.write(options.outputPath)) {
+            std::cout << "\n+ + + Wrote " << sink.records().size() << " result(s) to " << options.outputPath << " + + +\n";
+        } else {
+            std::cerr << "\n* * * Error: cannot write results file '" << options.outputPath << "' * * *\n";
+            isPassing = false;
+        }
+    }
+
+    if (!options.baselinePath.empty()) {
+        std::vector<ResultRecord> baseline;
+        if (!ResultsSink::read(options.baselinePath, baseline)) {
+            std::cerr << "\n* * * Error: cannot read baseline results from '" << options.baselinePath << "' * * *\n";
+            return false;
+        }
+        std::cout << "\nComparison with " << options.baselinePath << "\n";
+        const int kRegressions = sink.compare(baseline, options.threshold);
+        if (kRegressions > 0) {
+            std::cerr << "* * * Error: " << kRegressions << " case(s) regressed by more than " << options.threshold * 100
+                << "% * * *\n";
+            isPassing = false;
+        } else {
+            std::cout << "+ + + No regressions + + +\n";
+        }
+    }
+    return isPassing;
+}
+
+#endif // COMMON_RESULTS_H
@@ -0,0 +1,243 @@
+/**
+ * @file topology.h
+ * @brief Node topology on top of hybrid.h: node and leader communicators, NUMA report, node-shared arrays.
+ * 
+ * Ranks on one node can read each other's memory through an MPI shared-memory window,
+ * so data every rank of a node needs only has to cross the network once per node,
+ * travelling between node leaders.
+ */
+#ifndef COMMON_TOPOLOGY_H
+#define COMMON_TOPOLOGY_H
+
+#include <cstddef>
+#include <fstream>
+#include <iostream>
+#include <mpi.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "hybrid.h"
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+/**
+ * @brief Where the calling rank sits among the nodes of the job.
+ */
+struct NodeTopology {
+    MPI_Comm nodeComm = MPI_COMM_NULL;      // Processes sharing this node (borrowed from HybridContext)
+    MPI_Comm leaderComm = MPI_COMM_NULL;    // One process per node; MPI_COMM_NULL on non-leaders
+    int nodeIndex = 0;                      // Rank of this node's leader in leaderComm
+    int numNodes = 1;
+    int numaDomains = 1;                    // NUMA domains of this node
+    std::vector<int> rankNumaDomains;       // NUMA domains the calling rank's CPUs belong to
+};
+
+/**
+ * @brief Parses a kernel CPU list such as "0-3,8,10-11".
+ * 
+ * @param list CPU list in sysfs format.
+ * @return Every CPU in the list.
+ */
+inline std::vector<int> parseCpuList(const std::string& list) {
+    std::vector<int> cpus;
+    std::stringstream stream(list);
+    std::string range;
+    while (std::getline(stream, range, ',')) {
+        if (range.empty() || range == "\n")
+            continue;
+        const size_t kDash = range.find('-');
+        const int kFirst = std::stoi(range.substr(0, kDash));
+        const int kLast = (kDash == std::string::npos) ? kFirst : std::stoi(range.substr(kDash + 1));
+        for (int cpu = kFirst; cpu <= kLast; ++cpu)
+            cpus.push_back(cpu);
+    }
+    return cpus;
+}
+
+/**
+ * @brief Reads the NUMA domains of this node and the ones the calling process may run on.
+ * 
+ * Uses /sys/devices/system/node; elsewhere the node counts as a single domain.
+ * 
+ * @param rankDomains Receives the domains holding at least one CPU of the affinity mask.
+ * @return Number of NUMA domains on the node (at least 1).
+ */
+inline int readNumaDomains(std::vector<int>& rankDomains) {
+    rankDomains.clear();
+    int numDomains = 0;
+#ifdef __linux__
+    std::ifstream online("/sys/devices/system/node/online");
+    std::string line;
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    const bool kHasAffinity = (sched_getaffinity(0, sizeof(cpuSet), &cpuSet) == 0);
+    if (online && std::getline(online, line)) {
+        for (const int kDomain : parseCpuList(line)) {
+            ++numDomains;
+            std::ifstream cpuList("/sys/devices/system/node/node" + std::to_string(kDomain) + "/cpulist");
+            std::string cpus;
+            if (!cpuList || !std::getline(cpuList, cpus))
+                continue;
+            for (const int kCpu : parseCpuList(cpus)) {
+                if (!kHasAffinity || CPU_ISSET(kCpu, &cpuSet)) {
+                    rankDomains.push_back(kDomain);
+                    break;
+                }
+            }
+        }
+    }
+#endif
+    if (numDomains == 0) {
+        rankDomains.assign(1, 0);
+        return 1;
+    }
+    return numDomains;
+}
+
+/**
+ * @brief Builds the leader communicator and NUMA view of the calling rank.
+ * 
+ * Collective over MPI_COMM_WORLD. The node communicator is the one initHybrid()
+ * created; local rank 0 of every node acts as its leader.
+ * 
+ * @param context Placement returned by initHybrid().
+ * @return Topology to be released with freeNodeTopology() before finalizeHybrid().
+ */
+inline NodeTopology makeNodeTopology(const HybridContext& context) {
+    NodeTopology topology;
+    topology.nodeComm = context.nodeComm;
+    MPI_Comm_split(MPI_COMM_WORLD, context.localRank == 0 ? 0 : MPI_UNDEFINED, context.worldRank, &topology.leaderComm);
+
+    int nodeInfo[2] = {0, 1};
+    if (topology.leaderComm != MPI_COMM_NULL) {
+        MPI_Comm_rank(topology.leaderComm, &nodeInfo[0]);
+        MPI_Comm_size(topology.leaderComm, &nodeInfo[1]);
+    }
+    MPI_Bcast(nodeInfo, 2, MPI_INT, 0, topology.nodeComm);
+    topology.nodeIndex = nodeInfo[0];
+    topology.numNodes = nodeInfo[1];
+
+    topology.numaDomains = readNumaDomains(topology.rankNumaDomains);
+    return topology;
+}
+
+/**
+ * @brief Releases the leader communicator; the node communicator stays with the HybridContext.
+ */
+inline void freeNodeTopology(NodeTopology& topology) {
+    if (topology.leaderComm != MPI_COMM_NULL)
+        MPI_Comm_free(&topology.leaderComm);
+    topology.nodeComm = MPI_COMM_NULL;
+}
+
+/**
+ * @brief Prints one line per node and per rank with cores and NUMA domains on the master.
+ * 
+ * Collective over MPI_COMM_WORLD. Warns when a rank's CPUs span several NUMA domains,
+ * since its threads then reach part of its memory across the interconnect.
+ * 
+ * @param context Placement of the calling rank.
+ * @param topology Topology of the calling rank.
+ */
+inline void printTopology(const HybridContext& context, const NodeTopology& topology) {
+    constexpr int kMasterRank = 0;
+    constexpr int kFields = 6;
+
+    std::string domains;
+    for (const int kDomain : topology.rankNumaDomains)
+        domains += (domains.empty() ? "" : ",") + std::to_string(kDomain);
+
+    const int kLocal[kFields] = {topology.nodeIndex, context.localRank, context.localSize, context.nodeCores,
+                                 topology.numaDomains, static_cast<int>(topology.rankNumaDomains.size())};
+    std::vector<int> all(static_cast<size_t>(kFields) * context.worldSize);
+    MPI_Gather(kLocal, kFields, MPI_INT, all.data(), kFields, MPI_INT, kMasterRank, MPI_COMM_WORLD);
+
+    // Domain lists are short; fixed-size slots keep the gather simple
+    constexpr int kSlot = 64;
+    std::string localDomains = domains;
+    localDomains.resize(kSlot, '\0');
+    std::vector<char> allDomains(static_cast<size_t>(kSlot) * context.worldSize);
+    MPI_Gather(localDomains.data(), kSlot, MPI_CHAR, allDomains.data(), kSlot, MPI_CHAR, kMasterRank, MPI_COMM_WORLD);
+
+    if (context.worldRank != kMasterRank)
+        return;
+
+    std::cout << "\nTopology: " << topology.numNodes << " node(s)\n";
+    bool spansDomains = false;
+    for (int r = 0; r < context.worldSize; ++r) {
+        const int* fields = all.data() + static_cast<size_t>(r) * kFields;
+        if (fields[1] == 0) {
+            std::cout << "Node " << fields[0] << ": " << fields[2] << " process(es), " << fields[3] << " cores, "
+                << fields[4] << " NUMA domain(s)\n";
+        }
+        std::cout << "  [Process " << r << "] node " << fields[0] << ", local rank " << fields[1]
+            << ", NUMA domain(s) " << allDomains.data() + static_cast<size_t>(r) * kSlot << "\n";
+        spansDomains = spansDomains || fields[5] > 1;
+    }
+
+    if (spansDomains)
+        std::cout << "- - - Warning: A process spans several NUMA domains - bind one process per domain (--bind-to numa) - - -\n";
+}
+
+/**
+ * @brief Array allocated once per node in an MPI shared-memory window.
+ * 
+ * The node leader owns the storage and every rank of the node addresses it directly.
+ * The window stays in a passive-target epoch for its whole life; sync() orders the
+ * writes of one phase before the reads of the next.
+ * 
+ * @tparam T Trivially copyable element type.
+ */
+template <typename T>
+class NodeSharedArray {
+public:
+    /**
+     * @brief Allocates `count` elements on the node leader. Collective over `nodeComm`.
+     */
+    NodeSharedArray(size_t count, MPI_Comm nodeComm) : count_(count), nodeComm_(nodeComm) {
+        int localRank;
+        MPI_Comm_rank(nodeComm, &localRank);
+        const MPI_Aint kBytes = (localRank == 0) ? static_cast<MPI_Aint>(count * sizeof(T)) : 0;
+
+        void* base = nullptr;
+        MPI_Win_allocate_shared(kBytes, sizeof(T), MPI_INFO_NULL, nodeComm, &base, &window_);
+
+        MPI_Aint leaderBytes;
+        int displacementUnit;
+        MPI_Win_shared_query(window_, 0, &leaderBytes, &displacementUnit, &base);
+        data_ = static_cast<T*>(base);
+        MPI_Win_lock_all(MPI_MODE_NOCHECK, window_);
+    }
+
+    NodeSharedArray(const NodeSharedArray&) = delete;
+    NodeSharedArray& operator=(const NodeSharedArray&) = delete;
+
+    ~NodeSharedArray() {
+        MPI_Win_unlock_all(window_);
+        MPI_Win_free(&window_);
+    }
+
+    /**
+     * @brief Makes every rank's earlier writes visible to every rank's later reads. Collective over the node.
+     */
+    void sync() {
+        MPI_Win_sync(window_);
+        MPI_Barrier(nodeComm_);
+        MPI_Win_sync(window_);
+    }
+
+    T* data() { return data_; }
+    const T* data() const { return data_; }
+    size_t size() const { return count_; }
+
+private:
+    size_t count_;
+    MPI_Comm nodeComm_;
+    MPI_Win window_ = MPI_WIN_NULL;
+    T* data_ = nullptr;
+};
+
+#endif // COMMON_TOPOLOGY_H
\ No newline at end of file
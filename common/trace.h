@@ -0,0 +1,202 @@
+/**
+ * @file trace.h
+ * @brief Per-thread iteration trace: lock-free recording inside parallel regions, Chrome trace export.
+ * 
+ * Each thread appends to its own preallocated ring, so recording takes no lock and
+ * shares no cache line with other threads. The rings are merged after the region,
+ * then rendered as a table or written as Chrome trace JSON (chrome://tracing, Perfetto).
+ */
+#ifndef COMMON_TRACE_H
+#define COMMON_TRACE_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief One traced loop iteration.
+ */
+struct TraceEvent {
+    int tid = 0;
+    int64_t iteration = 0;
+    int64_t startNs = 0;        // steady_clock time the iteration began
+    int64_t endNs = 0;          // steady_clock time the iteration finished
+};
+
+/**
+ * @brief A fixed-capacity ring of trace events per thread.
+ * 
+ * record() is called by thread `tid` only, so no synchronisation is needed; merge() and
+ * clear() must run outside the parallel region. A full ring overwrites its oldest events.
+ */
+class TraceBuffer {
+public:
+    /**
+     * @brief Preallocates `capacityPerThread` events for each of `numThreads` threads.
+     */
+    TraceBuffer(int numThreads, size_t capacityPerThread)
+        : numThreads_(std::max(1, numThreads)), capacity_(std::max<size_t>(1, capacityPerThread)),
+          rings_(new Ring[std::max(1, numThreads)]) {
+        for (int t = 0; t < numThreads_; ++t)
+            rings_[t].events.resize(capacity_);
+    }
+
+    /**
+     * @brief Current steady_clock time in nanoseconds.
+     */
+    static int64_t now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    /**
+     * @brief Records one iteration; events of threads beyond numThreads() are ignored.
+     */
+    void record(int tid, int64_t iteration, int64_t startNs, int64_t endNs) {
+        if (tid < 0 || tid >= numThreads_)
+            return;
+        Ring& ring = rings_[tid];
+        ring.events[ring.written % capacity_] = TraceEvent{tid, iteration, startNs, endNs};
+        ++ring.written;
+    }
+
+    /**
+     * @brief Forgets every recorded event.
+     */
+    void clear() {
+        for (int t = 0; t < numThreads_; ++t)
+            rings_[t].written = 0;
+    }
+
+    /**
+     * @brief Returns the retained events of all threads, ordered by start time.
+     */
+    std::vector<TraceEvent> merge() const {
+        std::vector<TraceEvent> merged;
+        for (int t = 0; t < numThreads_; ++t) {
+            const Ring& kRing = rings_[t];
+            const uint64_t kFirst = (kRing.written > capacity_) ? kRing.written - capacity_ : 0;
+            for (uint64_t k = kFirst; k < kRing.written; ++k)
+                merged.push_back(kRing.events[k % capacity_]);
+        }
+        std::stable_sort(merged.begin(), merged.end(),
+                         [](const TraceEvent& a, const TraceEvent& b) { return a.startNs < b.startNs; });
+        return merged;
+    }
+
+    /**
+     * @brief Number of events overwritten because a ring was full.
+     */
+    uint64_t dropped() const {
+        uint64_t total = 0;
+        for (int t = 0; t < numThreads_; ++t)
+            total += (rings_[t].written > capacity_) ? rings_[t].written - capacity_ : 0;
+        return total;
+    }
+
+    int numThreads() const { return numThreads_; }
+
+private:
+    struct alignas(64) Ring {
+        std::vector<TraceEvent> events;
+        uint64_t written = 0;
+    };
+
+    int numThreads_;
+    size_t capacity_;
+    std::unique_ptr<Ring[]> rings_;
+};
+
+/**
+ * @brief Writes timelines as Chrome trace JSON, one trace "process" per timeline.
+ * 
+ * Consecutive iterations a thread ran back to back are merged into one span, so a
+ * full-size loop stays small enough for the viewer and each span reads as a chunk.
+ */
+class ChromeTraceWriter {
+public:
+    /**
+     * @brief Opens `path` for writing; check isOpen().
+     */
+    explicit ChromeTraceWriter(const std::string& path) : out_(path) {
+        out_ << std::fixed << std::setprecision(3);     // Microsecond timestamps to the nanosecond
+        if (out_)
+            out_ << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    }
+
+    ChromeTraceWriter(const ChromeTraceWriter&) = delete;
+    ChromeTraceWriter& operator=(const ChromeTraceWriter&) = delete;
+
+    ~ChromeTraceWriter() {
+        if (out_)
+            out_ << "\n]}\n";
+    }
+
+    bool isOpen() const { return static_cast<bool>(out_); }
+
+    /**
+     * @brief Adds one timeline, e.g. one schedule, with a lane per thread.
+     * 
+     * @param name Timeline name shown by the viewer.
+     * @param events Merged events of the run.
+     * @param originNs Time that becomes 0 on the timeline.
+     * @param maxGapNs Largest pause between consecutive iterations still drawn as one span.
+     */
+    void addTimeline(const std::string& name, const std::vector<TraceEvent>& events, int64_t originNs,
+                     int64_t maxGapNs = 1000) {
+        const int kPid = nextPid_++;
+        separator();
+        out_ << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << kPid << ",\"args\":{\"name\":\"" << name << "\"}}";
+
+        // Spans grow per thread; events arrive ordered by start time
+        std::vector<TraceEvent> open;
+        std::vector<int64_t> openFirst;
+        for (const TraceEvent& kEvent : events) {
+            if (kEvent.tid >= static_cast<int>(open.size())) {
+                open.resize(kEvent.tid + 1, TraceEvent{-1, 0, 0, 0});
+                openFirst.resize(kEvent.tid + 1, 0);
+            }
+            TraceEvent& span = open[kEvent.tid];
+            if (span.tid >= 0 && kEvent.iteration == span.iteration + 1 && kEvent.startNs - span.endNs <= maxGapNs) {
+                span.iteration = kEvent.iteration;
+                span.endNs = kEvent.endNs;
+                continue;
+            }
+            if (span.tid >= 0)
+                writeSpan(kPid, name, span, openFirst[kEvent.tid], originNs);
+            span = kEvent;
+            openFirst[kEvent.tid] = kEvent.iteration;
+        }
+        for (size_t t = 0; t < open.size(); ++t) {
+            if (open[t].tid >= 0)
+                writeSpan(kPid, name, open[t], openFirst[t], originNs);
+        }
+    }
+
+private:
+    void separator() {
+        out_ << (first_ ? "\n" : ",\n");
+        first_ = false;
+    }
+
+    void writeSpan(int pid, const std::string& category, const TraceEvent& span, int64_t firstIteration, int64_t originNs) {
+        separator();
+        out_ << "{\"name\":\"" << firstIteration;
+        if (span.iteration != firstIteration)
+            out_ << "-" << span.iteration;
+        out_ << "\",\"cat\":\"" << category << "\",\"ph\":\"X\",\"pid\":" << pid << ",\"tid\":" << span.tid
+             << ",\"ts\":" << (span.startNs - originNs) / 1000.0 << ",\"dur\":" << (span.endNs - span.startNs) / 1000.0
+             << ",\"args\":{\"iterations\":" << span.iteration - firstIteration + 1 << "}}";
+    }
+
+    std::ofstream out_;
+    bool first_ = true;
+    int nextPid_ = 0;
+};
+
+#endif // COMMON_TRACE_H
\ No newline at end of file
@@ -0,0 +1,190 @@
+/**
+ * @file workload.h
+ * @brief CPU-bound per-iteration cost profiles for load-balancing benchmarks.
+ * 
+ * Each profile assigns every loop iteration a number of spin units: steps of a serial
+ * multiply-add chain that stays in registers, so the cost is pure compute and scales
+ * with the clock instead of with timer or wakeup latency. Profiles are normalised to
+ * the same mean cost, so they differ only in how the work is distributed.
+ */
+#ifndef COMMON_WORKLOAD_H
+#define COMMON_WORKLOAD_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief How the cost of an iteration depends on its index.
+ */
+enum class WorkloadProfile {
+    Balanced,       // Every iteration costs the mean
+    Ramp,           // Cost rises linearly from 1x to 10x across the range
+    Zipf,           // Power-law (s = 1) costs, heavy iterations scattered through the range
+    Bimodal,        // 10% of iterations, scattered, cost 20x the others
+    Triangular      // Iteration i costs n - i, like row i of an upper-triangular matrix multiply
+};
+
+const std::vector<WorkloadProfile> kAllWorkloadProfiles = {WorkloadProfile::Balanced, WorkloadProfile::Ramp,
+                                                           WorkloadProfile::Zipf, WorkloadProfile::Bimodal,
+                                                           WorkloadProfile::Triangular};
+
+/**
+ * @brief Returns the lower-case name of a profile, as used on the command line.
+ */
+inline std::string workloadName(WorkloadProfile profile) {
+    switch (profile) {
+        case WorkloadProfile::Balanced: return "balanced";
+        case WorkloadProfile::Ramp: return "ramp";
+        case WorkloadProfile::Zipf: return "zipf";
+        case WorkloadProfile::Bimodal: return "bimodal";
+        case WorkloadProfile::Triangular: return "triangular";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Looks up a profile by name.
+ * 
+ * @param name Profile name as returned by workloadName().
+ * @param profile Receives the profile.
+ * @return False if no profile has that name.
+ */
+inline bool parseWorkloadProfile(const std::string& name, WorkloadProfile& profile) {
+    for (const WorkloadProfile kProfile : kAllWorkloadProfiles) {
+        if (workloadName(kProfile) == name) {
+            profile = kProfile;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Burns `units` steps of a dependent multiply-add chain.
+ * 
+ * Each step waits on the previous one, so the time is units x (multiply + add latency)
+ * regardless of the memory system, and the empty asm keeps the compiler from
+ * collapsing the loop.
+ * 
+ * @param units Number of steps.
+ * @return The chain's final value.
+ */
+inline uint64_t spinWork(uint32_t units) {
+    uint64_t x = units;
+    for (uint32_t k = 0; k < units; ++k) {
+        x = x * 6364136223846793005ull + 1442695040888963407ull;
+#if defined(__GNUC__)
+        __asm__ volatile("" : "+r"(x));
+#else
+        volatile uint64_t barrier = x;
+        x = barrier;
+#endif
+    }
+    return x;
+}
+
+/**
+ * @brief Measures how many spin units run per nanosecond on the calling thread.
+ * 
+ * Takes the fastest of a few runs of about 10 ms each, so one preemption does not skew it.
+ * 
+ * @return Spin units per nanosecond.
+ */
+inline double calibrateSpinRate() {
+    using Clock = std::chrono::steady_clock;
+    constexpr uint32_t kUnits = 1u << 22;
+    constexpr int kRuns = 5;
+
+    double bestNs = 0;
+    uint64_t sink = 0;
+    for (int run = 0; run < kRuns; ++run) {
+        const Clock::time_point kStart = Clock::now();
+        sink += spinWork(kUnits);
+        const double kNs = std::chrono::duration<double, std::nano>(Clock::now() - kStart).count();
+        if (run == 0 || kNs < bestNs)
+            bestNs = kNs;
+    }
+    // The sink keeps the calls alive; a chain value of exactly 0 never occurs in practice
+    return (sink == 0) ? 1.0 : kUnits / std::max(bestNs, 1.0);
+}
+
+/**
+ * @brief Spreads iteration indices over the range for the scattered profiles.
+ * 
+ * A multiplicative hash: consecutive iterations map far apart, so heavy iterations do not
+ * cluster in one static block.
+ */
+inline uint64_t scatterIndex(uint64_t i, uint64_t size) {
+    return (i * 2654435761ull + 12345) % size;
+}
+
+/**
+ * @brief Builds the spin units of every iteration of a profile.
+ * 
+ * Relative weights are scaled so the mean iteration costs `meanCostNs`. Rounding is
+ * carried from one iteration to the next, so the total matches even for cheap iterations.
+ * 
+ * @param profile Cost distribution.
+ * @param size Number of iterations.
+ * @param meanCostNs Mean cost of one iteration in nanoseconds.
+ * @param spinsPerNs Spin rate from calibrateSpinRate().
+ * @return Spin units per iteration.
+ */
+inline std::vector<uint32_t> buildCostTable(WorkloadProfile profile, int size, double meanCostNs, double spinsPerNs) {
+    std::vector<double> weights(std::max(size, 0), 1.0);
+    for (int i = 0; i < size; ++i) {
+        double& weight = weights[i];
+        switch (profile) {
+            case WorkloadProfile::Balanced:
+                break;
+            case WorkloadProfile::Ramp:
+                weight = (size > 1) ? 1.0 + 9.0 * i / (size - 1) : 1.0;
+                break;
+            case WorkloadProfile::Zipf:
+                weight = 1.0 / static_cast<double>(scatterIndex(i, size) + 1);
+                break;
+            case WorkloadProfile::Bimodal:
+                weight = (scatterIndex(i, size) % 10 == 0) ? 20.0 : 1.0;
+                break;
+            case WorkloadProfile::Triangular:
+                weight = static_cast<double>(size - i);
+                break;
+        }
+    }
+
+    double totalWeight = 0;
+    for (const double kWeight : weights)
+        totalWeight += kWeight;
+    const double kUnitsPerWeight = (totalWeight > 0) ? meanCostNs * spinsPerNs * size / totalWeight : 0.0;
+
+    std::vector<uint32_t> units(weights.size());
+    double carry = 0;
+    for (size_t i = 0; i < weights.size(); ++i) {
+        const double kExact = weights[i] * kUnitsPerWeight + carry;
+        const double kRounded = std::min(std::floor(kExact + 0.5), 4294967295.0);
+        units[i] = static_cast<uint32_t>(std::max(kRounded, 0.0));
+        carry = kExact - units[i];
+    }
+    return units;
+}
+
+/**
+ * @brief Ratio of the costliest iteration to the mean; 1 for a balanced loop.
+ */
+inline double costImbalance(const std::vector<uint32_t>& units) {
+    if (units.empty())
+        return 1.0;
+    double total = 0;
+    uint32_t largest = 0;
+    for (const uint32_t kUnits : units) {
+        total += kUnits;
+        largest = std::max(largest, kUnits);
+    }
+    return (total > 0) ? largest * static_cast<double>(units.size()) / total : 1.0;
+}
+
+#endif // COMMON_WORKLOAD_H
\ No newline at end of file
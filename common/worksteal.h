@@ -0,0 +1,263 @@
+/**
+ * @file worksteal.h
+ * @brief Work-stealing parallel loop: per-thread Chase-Lev deques of iteration ranges.
+ * 
+ * Every thread starts with its static share of the iteration space and splits it in
+ * halves on demand. The owner works on the newest (smallest) piece of its deque, and
+ * an idle thread steals the oldest piece, which holds half of what the victim had left.
+ * Threads touch shared state only when they run dry, instead of once per chunk as
+ * with schedule(dynamic).
+ */
+#ifndef COMMON_WORKSTEAL_H
+#define COMMON_WORKSTEAL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <omp.h>
+#include <thread>
+
+/**
+ * @brief Half-open range of loop iterations [begin, end).
+ */
+struct IterationRange {
+    int64_t begin = 0;
+    int64_t end = 0;
+
+    int64_t size() const { return end - begin; }
+};
+
+/**
+ * @brief Fixed-capacity Chase-Lev deque of iteration ranges.
+ * 
+ * The owning thread pushes and takes at the bottom; any other thread steals from the
+ * top. Binary splitting keeps at most log2(iterations) ranges queued, so a small fixed
+ * ring never wraps onto a live slot. Memory orders follow Le et al., "Correct and
+ * Efficient Work-Stealing for Weak Memory Models" (PPoPP 2013).
+ */
+class alignas(64) ChaseLevDeque {
+public:
+    static constexpr int64_t kCapacity = 64;
+
+    /**
+     * @brief Empties the deque. Not thread-safe; call between parallel regions.
+     */
+    void reset() {
+        top_.store(0, std::memory_order_relaxed);
+        bottom_.store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Queues a range at the bottom. Owner only.
+     * 
+     * @return False if the deque is full; the caller keeps the range.
+     */
+    bool push(const IterationRange& range) {
+        const int64_t kBottom = bottom_.load(std::memory_order_relaxed);
+        const int64_t kTop = top_.load(std::memory_order_acquire);
+        if (kBottom - kTop >= kCapacity)
+            return false;
+        store(kBottom, range);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(kBottom + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * @brief Removes the newest range. Owner only.
+     * 
+     * @param range Receives the range.
+     * @return False if the deque was empty or a thief took the last range.
+     */
+    bool take(IterationRange& range) {
+        const int64_t kBottom = bottom_.load(std::memory_order_relaxed) - 1;
+        bottom_.store(kBottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = top_.load(std::memory_order_relaxed);
+
+        if (top > kBottom) {
+            bottom_.store(kBottom + 1, std::memory_order_relaxed);
+            return false;
+        }
+        range = load(kBottom);
+        if (top == kBottom) {
+            // Last range: race the thieves for it
+            const bool kWon = top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                                           std::memory_order_relaxed);
+            bottom_.store(kBottom + 1, std::memory_order_relaxed);
+            return kWon;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Removes the oldest range. Any thread.
+     * 
+     * @param range Receives the range.
+     * @return False if the deque was empty or another thread got there first.
+     */
+    bool steal(IterationRange& range) {
+        int64_t top = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t kBottom = bottom_.load(std::memory_order_acquire);
+        if (top >= kBottom)
+            return false;
+        const IterationRange kCandidate = load(top);
+        if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return false;
+        range = kCandidate;
+        return true;
+    }
+
+private:
+    void store(int64_t index, const IterationRange& range) {
+        Slot& slot = slots_[index & (kCapacity - 1)];
+        slot.begin.store(range.begin, std::memory_order_relaxed);
+        slot.end.store(range.end, std::memory_order_relaxed);
+    }
+
+    IterationRange load(int64_t index) const {
+        const Slot& slot = slots_[index & (kCapacity - 1)];
+        return {slot.begin.load(std::memory_order_relaxed), slot.end.load(std::memory_order_relaxed)};
+    }
+
+    // Thieves may read a slot while the owner rewrites it; relaxed atomics keep that defined
+    struct Slot {
+        std::atomic<int64_t> begin{0};
+        std::atomic<int64_t> end{0};
+    };
+
+    alignas(64) std::atomic<int64_t> top_{0};
+    alignas(64) std::atomic<int64_t> bottom_{0};
+    Slot slots_[kCapacity];
+};
+
+/**
+ * @brief Runs parallel loops by work stealing over a reusable set of deques.
+ * 
+ * Create the scheduler outside any timed region: construction allocates the deques,
+ * and parallelFor() only resets them.
+ */
+class WorkStealingScheduler {
+public:
+    /**
+     * @brief Allocates one deque per thread.
+     * 
+     * @param numThreads Team size of every parallelFor() call.
+     */
+    explicit WorkStealingScheduler(int numThreads)
+        : numThreads_(std::max(1, numThreads)), deques_(new ChaseLevDeque[std::max(1, numThreads)]),
+          idleSeconds_(new double[std::max(1, numThreads)]()) {}
+
+    /**
+     * @brief Calls `body(i)` once for every i in [begin, end).
+     * 
+     * Ranges are split in halves until they are no larger than `grain`; each leaf
+     * range runs as a plain serial loop.
+     * 
+     * @param begin First iteration.
+     * @param end One past the last iteration.
+     * @param grain Largest range executed without splitting (0 -> iterations / (threads * 16)).
+     * @param body Loop body taking the iteration index.
+     */
+    template <typename Body>
+    void parallelFor(int64_t begin, int64_t end, int64_t grain, const Body& body) {
+        const int64_t kIterations = end - begin;
+        if (kIterations <= 0)
+            return;
+        if (grain <= 0)
+            grain = std::max<int64_t>(1, kIterations / (static_cast<int64_t>(numThreads_) * 16));
+
+        for (int t = 0; t < numThreads_; ++t) {
+            deques_[t].reset();
+            idleSeconds_[t] = 0.0;
+        }
+        std::atomic<int64_t> remaining(kIterations);
+        std::atomic<int64_t> steals(0);
+
+        #pragma omp parallel num_threads(numThreads_)
+        {
+            const int kThreads = omp_get_num_threads();     // May be fewer than requested
+            const int kTid = omp_get_thread_num();
+            ChaseLevDeque& own = deques_[kTid];
+            uint32_t seed = 2654435761u * static_cast<uint32_t>(kTid + 1);
+            int64_t localSteals = 0;
+            double idleSeconds = 0.0;
+            double idleSince = -1.0;    // Start of the current search for work (< 0 -> busy)
+
+            // Static share first, so a balanced loop never needs to steal
+            IterationRange range{begin + kIterations * kTid / kThreads, begin + kIterations * (kTid + 1) / kThreads};
+            bool hasRange = range.size() > 0;
+
+            while (true) {
+                if (hasRange) {
+                    if (idleSince >= 0) {
+                        idleSeconds += omp_get_wtime() - idleSince;
+                        idleSince = -1.0;
+                    }
+                    // Keep the lower half, expose the upper half to thieves
+                    while (range.size() > grain) {
+                        const int64_t kMiddle = range.begin + range.size() / 2;
+                        if (!own.push({kMiddle, range.end}))
+                            break;
+                        range.end = kMiddle;
+                    }
+                    for (int64_t i = range.begin; i < range.end; ++i)
+                        body(i);
+                    remaining.fetch_sub(range.size(), std::memory_order_acq_rel);
+                    hasRange = own.take(range);
+                    continue;
+                }
+
+                if (idleSince < 0)
+                    idleSince = omp_get_wtime();
+                if (remaining.load(std::memory_order_acquire) == 0)
+                    break;
+
+                // Out of work: try every other thread once, starting at a random victim
+                seed ^= seed << 13;
+                seed ^= seed >> 17;
+                seed ^= seed << 5;
+                const int kStart = static_cast<int>(seed % static_cast<uint32_t>(kThreads));
+                for (int k = 0; k < kThreads && !hasRange; ++k) {
+                    const int kVictim = (kStart + k) % kThreads;
+                    if (kVictim != kTid && deques_[kVictim].steal(range))
+                        hasRange = true;
+                }
+                if (hasRange)
+                    ++localSteals;
+                else
+                    std::this_thread::yield();      // Let the threads holding work run when oversubscribed
+            }
+            if (idleSince >= 0)
+                idleSeconds += omp_get_wtime() - idleSince;
+            idleSeconds_[kTid] = idleSeconds;
+            steals.fetch_add(localSteals, std::memory_order_relaxed);
+        }
+        lastSteals_ = steals.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Number of successful steals during the most recent parallelFor().
+     */
+    int64_t lastSteals() const { return lastSteals_; }
+
+    /**
+     * @brief Time thread `tid` spent looking for work during the most recent parallelFor().
+     * 
+     * Counted from running dry to the next successful steal or to the end of the loop,
+     * which is what an `omp for` thread would spend waiting at the closing barrier.
+     */
+    double lastIdleSeconds(int tid) const { return (tid >= 0 && tid < numThreads_) ? idleSeconds_[tid] : 0.0; }
+
+    int numThreads() const { return numThreads_; }
+
+private:
+    int numThreads_;
+    std::unique_ptr<ChaseLevDeque[]> deques_;
+    std::unique_ptr<double[]> idleSeconds_;     // Per thread, written once at the end of each loop
+    int64_t lastSteals_ = 0;
+};
+
+#endif // COMMON_WORKSTEAL_H
\ No newline at end of file
@@ -0,0 +1,398 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../common/benchmark.h"
+#include "../common/options.h"
+#include "../common/results.h"
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+/**
+ * @brief A benchmark program the driver can run, and how its sizes and threads are selected.
+ */
+struct DriverKernel {
+    std::string name;           // Name on the driver command line and option file section
+    std::string program;        // Executable, looked up in --bin-dir
+    std::string description;
+    bool isMpi;                 // Launched through --mpirun with -np <ranks>
+    std::string sizesOption;    // Option taking the sizes ("" -> sizes not selectable)
+    bool takesSizeList;         // False -> one run per size
+    bool usesOpenMp;            // False -> thread counts ignored, the program always records one thread
+    bool takesThreadList;       // False -> one run per thread count, through OMP_NUM_THREADS
+    bool takesCounters;         // Accepts --counters
+};
+
+const std::vector<DriverKernel> kDriverKernels = {
+    {"schedule", "openmp_partb_schedule", "OpenMP loop schedules, configuration sweep and bandwidth", false, "--sizes=",
+     true, true, true, true},
+    {"matrix", "openmp_partc_matrix", "OpenMP matrix multiplication kernels", false, "--sizes=", true, true, true, true},
+    {"mpi-matrix", "mpi_partd_matrix", "Distributed matrix multiplication (row-block, row-shared, SUMMA)", true,
+     "--sizes=", true, true, false, false},
+    {"hybrid", "mpi_parte_hybrid", "Hybrid MPI+OpenMP triad and dot products", true, "--length=", false, true, false,
+     false},
+    {"farm", "mpi_partb_slaves1", "Task farm schedules and a fault-tolerant farm with a straggler", true, "--sizes=",
+     true, false, false, false},
+    {"gather", "mpi_partb_slaves2", "Master gather: blocking receives vs Waitsome/Testsome", true, "--sizes=", true, false,
+     false, false},
+    {"rpc", "mpi_partc_tag", "Tag-dispatched RPC round trips, idle and under data load", true, "", false, false, false,
+     false},
+    {"collectives", "mpi_partf_collectives", "MPI collectives vs point-to-point root loops", true, "", false, false, false,
+     false},
+    {"pingpong", "mpi_partg_pingpong", "Point-to-point latency and bandwidth per send mode", true, "--sizes=", true, false,
+     false, false},
+};
+
+/**
+ * @brief Returns a registered kernel by name, or null.
+ */
+const DriverKernel* findDriverKernel(const std::string& name) {
+    for (const DriverKernel& kKernel : kDriverKernels) {
+        if (kKernel.name == name)
+            return &kKernel;
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Joins integers with commas, the form every program's list options accept.
+ */
+std::string joinList(const std::vector<int>& values) {
+    std::string text;
+    for (const int kValue : values)
+        text += (text.empty() ? "" : ",") + std::to_string(kValue);
+    return text;
+}
+
+/**
+ * @brief Splits a command such as "mpirun --oversubscribe" at spaces.
+ */
+std::vector<std::string> splitCommand(const std::string& command) {
+    std::vector<std::string> words;
+    std::istringstream stream(command);
+    std::string word;
+    while (stream >> word)
+        words.push_back(word);
+    return words;
+}
+
+/**
+ * @brief One program invocation: its command line, environment and results file.
+ */
+struct DriverRun {
+    const DriverKernel* kernel;
+    std::string executable;     // The benchmark program, also when launched through mpirun
+    std::vector<std::string> command;
+    int numThreads = 0;         // OMP_NUM_THREADS for the run (0 -> inherited)
+    std::string resultsPath;
+};
+
+/**
+ * @brief Prints a run the way it could be typed into a shell.
+ */
+std::string describeRun(const DriverRun& run) {
+    std::string text = run.numThreads > 0 ? "OMP_NUM_THREADS=" + std::to_string(run.numThreads) + " " : "";
+    for (size_t w = 0; w < run.command.size(); ++w)
+        text += (w == 0 ? "" : " ") + run.command[w];
+    return text;
+}
+
+/**
+ * @brief Runs a program to completion with the driver's stdout and stderr.
+ * 
+ * @return The program's exit status; 127 if it could not be started, 128 + signal if it was killed.
+ */
+int executeRun(const DriverRun& run) {
+    std::cout.flush();
+    const pid_t kPid = fork();
+    if (kPid < 0)
+        return 127;
+    if (kPid == 0) {
+        if (run.numThreads > 0)
+            setenv("OMP_NUM_THREADS", std::to_string(run.numThreads).c_str(), 1);
+        std::vector<char*> argv;
+        for (const std::string& kWord : run.command)
+            argv.push_back(const_cast<char*>(kWord.c_str()));
+        argv.push_back(nullptr);
+        execvp(argv[0], argv.data());
+        std::cerr << "* * * Error: cannot start '" << run.command[0] << "' * * *\n";
+        _exit(127);
+    }
+
+    int status = 0;
+    if (waitpid(kPid, &status, 0) < 0)
+        return 127;
+    if (WIFSIGNALED(status))
+        return 128 + WTERMSIG(status);
+    return WIFEXITED(status) ? WEXITSTATUS(status) : 127;
+}
+
+int main(int argc, char** argv) {
+    /**
+     * OUTLINE: Run the selected benchmark programs and merge their results
+     * @section 1: Selection
+     * --kernels picks registered programs; --sizes, --threads and --ranks give the sweep, either on
+     * the command line or in a --config file whose [kernel] sections add options for one program
+     * @section 2: Runs
+     * Programs that take lists get them whole; the others run once per size or thread count, and
+     * MPI programs once per rank count, each writing its own results file
+     * @section 3: Results
+     * Every run's results are merged into one CSV or JSON file and checked against --baseline=FILE
+     */
+
+    // Console UI elements
+    constexpr int kLineLength = 80;
+    const std::string kSingleLine(kLineLength, '-');
+    const std::string kDoubleLine(kLineLength, '=');
+
+    // Command-line options
+    std::string kernelNames;
+    for (const DriverKernel& kKernel : kDriverKernels)
+        kernelNames += (kernelNames.empty() ? "" : ",") + kKernel.name;
+    const std::string kUsage = "* * * Usage: ./<program_name> [--list] [--kernels=" + kernelNames + "|all] [--sizes=LIST] "
+        "[--threads=LIST] [--ranks=LIST] [--mpirun=CMD] [--bin-dir=DIR] [--format=csv|json] [--counters] [--dry-run] "
+        + benchmarkUsage() + " " + resultsUsage() + " " + optionsUsage() + " * * *\n"
+        "* * * LIST: comma-separated values and ranges, e.g. 1,2,4 or 1:cores:x2 or 100:1000:+100 * * *\n\n";
+    std::vector<const DriverKernel*> kernels;
+    std::vector<int> sizes;         // Empty -> each program's own defaults
+    std::vector<int> threadCounts;  // Empty -> each program's own defaults
+    std::vector<int> rankCounts = {2};
+    std::string mpirun = "mpirun";
+    std::string binDir;
+    std::string format;
+    bool withCounters = false;
+    bool isDryRun = false;
+    bool isListing = false;
+    std::vector<std::string> harnessArgs;
+    ResultsOptions resultsOptions;
+
+    std::vector<std::string> args;
+    std::vector<std::string> configPaths;
+    std::string argError;
+    expandArguments(argc, argv, "driver", args, argError);
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]).rfind("--config=", 0) == 0)
+            configPaths.push_back(argv[i] + 9);
+    }
+    for (size_t i = 0; i < args.size() && argError.empty(); ++i) {
+        const std::string& arg = args[i];
+        BenchmarkOptions harness;
+        if (parseBenchmarkOption(arg, harness, argError)) {
+            harnessArgs.push_back(arg);     // Validated here, applied by every program
+            continue;
+        }
+        if (parseResultsOption(arg, resultsOptions, argError))
+            continue;
+        if (arg == "--list") {
+            isListing = true;
+        } else if (arg.rfind("--kernels=", 0) == 0) {
+            kernels.clear();
+            std::stringstream names(arg.substr(10));
+            std::string name;
+            while (std::getline(names, name, ',') && argError.empty()) {
+                if (name == "all") {
+                    for (const DriverKernel& kKernel : kDriverKernels)
+                        kernels.push_back(&kKernel);
+                } else if (const DriverKernel* kKernel = findDriverKernel(name)) {
+                    kernels.push_back(kKernel);
+                } else {
+                    argError = "unknown kernel '" + name + "'";
+                }
+            }
+        } else if (arg.rfind("--sizes=", 0) == 0) {
+            if (!parseIntList(arg.substr(8), sizes) || *std::min_element(sizes.begin(), sizes.end()) < 1)
+                argError = "sizes must be positive integers or ranges";
+        } else if (arg.rfind("--threads=", 0) == 0) {
+            if (!parseIntList(arg.substr(10), threadCounts) || *std::min_element(threadCounts.begin(), threadCounts.end()) < 1)
+                argError = "thread counts must be positive integers or ranges";
+        } else if (arg.rfind("--ranks=", 0) == 0) {
+            if (!parseIntList(arg.substr(8), rankCounts) || *std::min_element(rankCounts.begin(), rankCounts.end()) < 1)
+                argError = "rank counts must be positive integers or ranges";
+        } else if (arg.rfind("--mpirun=", 0) == 0) {
+            mpirun = arg.substr(9);
+        } else if (arg.rfind("--bin-dir=", 0) == 0) {
+            binDir = arg.substr(10);
+        } else if (arg.rfind("--format=", 0) == 0) {
+            format = arg.substr(9);
+            if (format != "csv" && format != "json")
+                argError = "format must be csv or json";
+        } else if (arg == "--counters") {
+            withCounters = true;
+        } else if (arg == "--dry-run") {
+            isDryRun = true;
+        } else {
+            argError = "unknown argument '" + arg + "'";
+        }
+    }
+
+    // --format names the merged file unless --results already did
+    if (argError.empty() && !format.empty()) {
+        if (resultsOptions.outputPath.empty())
+            resultsOptions.outputPath = "benchmark_results." + format;
+        else if (isJsonPath(resultsOptions.outputPath) != (format == "json"))
+            argError = "--format=" + format + " does not match --results=" + resultsOptions.outputPath;
+    }
+    if (argError.empty() && splitCommand(mpirun).empty())
+        argError = "empty --mpirun command";
+
+    if (!argError.empty()) {
+        std::cerr << "* * * Error: " << argError << " * * *\n" << kUsage;
+        return 1;
+    }
+
+    if (isListing) {
+        std::cout << "Kernels\n" << kSingleLine << std::endl;
+        for (const DriverKernel& kKernel : kDriverKernels) {
+            std::cout << std::left << std::setw(14) << kKernel.name << std::setw(24) << kKernel.program
+                << kKernel.description << (kKernel.isMpi ? " (MPI)" : "") << std::endl;
+        }
+        return 0;
+    }
+
+    if (kernels.empty()) {
+        for (const DriverKernel& kKernel : kDriverKernels)
+            kernels.push_back(&kKernel);
+    }
+
+    // Programs are expected next to the driver, as the build puts them
+    if (binDir.empty()) {
+        const std::string kSelf = argv[0];
+        const size_t kSlash = kSelf.rfind('/');
+        binDir = (kSlash == std::string::npos) ? "." : kSelf.substr(0, kSlash);
+    }
+
+    // Every run writes its own results file into a scratch directory
+    char scratchTemplate[] = "/tmp/benchmark_driver.XXXXXX";
+    const char* kScratch = mkdtemp(scratchTemplate);
+    if (kScratch == nullptr) {
+        std::cerr << "* * * Error: cannot create a scratch directory for the results * * *\n";
+        return 1;
+    }
+
+    /**
+     * @section Selection
+     */
+    std::cout << std::endl << kDoubleLine << "\nBENCHMARK DRIVER\n" << kDoubleLine << std::endl;
+
+    // Display configurations
+    std::cout << "Configuration\n" << kSingleLine << std::endl
+        << "Kernels:";
+    for (const DriverKernel* kKernel : kernels)
+        std::cout << " " << kKernel->name;
+    std::cout << std::endl
+        << "Sizes: " << (sizes.empty() ? "program defaults" : joinList(sizes)) << std::endl
+        << "Threads: " << (threadCounts.empty() ? "program defaults" : joinList(threadCounts)) << std::endl
+        << "MPI ranks: " << joinList(rankCounts) << " (" << mpirun << ")" << std::endl
+        << "Programs: " << binDir << std::endl
+        << "Results: " << (resultsOptions.outputPath.empty() ? "not written" : resultsOptions.outputPath) << std::endl;
+
+    // One run per program unless it needs a separate run per size, thread count or rank count
+    std::vector<DriverRun> runs;
+    for (const DriverKernel* kKernel : kernels) {
+        std::vector<std::string> extraArgs = harnessArgs;
+        for (const std::string& kPath : configPaths) {
+            if (!readOptionsFile(kPath, kKernel->name, extraArgs, argError, false)) {
+                std::cerr << "* * * Error: " << argError << " * * *\n";
+                return 1;
+            }
+        }
+        if (withCounters && kKernel->takesCounters)
+            extraArgs.push_back("--counters");
+
+        const std::vector<int> kRankCounts = kKernel->isMpi ? rankCounts : std::vector<int>{0};
+        const bool kOneThreadRun = !kKernel->usesOpenMp || kKernel->takesThreadList || threadCounts.empty();
+        const std::vector<int> kThreadRuns = kOneThreadRun ? std::vector<int>{0} : threadCounts;
+        const bool kOneSizeRun = kKernel->takesSizeList || kKernel->sizesOption.empty() || sizes.empty();
+        const std::vector<int> kSizeRuns = kOneSizeRun ? std::vector<int>{0} : sizes;
+        for (const int kRanks : kRankCounts) {
+            for (const int kThreads : kThreadRuns) {
+                for (const int kSize : kSizeRuns) {
+                    DriverRun run;
+                    run.kernel = kKernel;
+                    run.numThreads = kThreads;
+                    run.resultsPath = std::string(kScratch) + "/" + kKernel->name + "." + std::to_string(runs.size()) + ".csv";
+                    if (kKernel->isMpi) {
+                        run.command = splitCommand(mpirun);
+                        run.command.push_back("-np");
+                        run.command.push_back(std::to_string(kRanks));
+                    }
+                    run.executable = binDir + "/" + kKernel->program;
+                    run.command.push_back(run.executable);
+                    if (kKernel->takesThreadList && !threadCounts.empty())
+                        run.command.push_back("--threads=" + joinList(threadCounts));
+                    if (!kKernel->sizesOption.empty() && !sizes.empty())
+                        run.command.push_back(kKernel->sizesOption + (kSize > 0 ? std::to_string(kSize) : joinList(sizes)));
+                    run.command.insert(run.command.end(), extraArgs.begin(), extraArgs.end());
+                    run.command.push_back("--results=" + run.resultsPath);
+                    runs.push_back(run);
+                }
+            }
+        }
+    }
+
+    /**
+     * @section Runs
+     */
+    std::cout << std::endl << kDoubleLine << "\nRUNS\n" << kDoubleLine << std::endl;
+    std::vector<int> statuses;
+    for (size_t r = 0; r < runs.size(); ++r) {
+        std::cout << "\n[" << r + 1 << "/" << runs.size() << "] " << describeRun(runs[r]) << "\n" << kSingleLine << std::endl;
+        if (isDryRun)
+            continue;
+        if (access(runs[r].executable.c_str(), X_OK) != 0) {
+            std::cerr << "* * * Error: " << runs[r].kernel->program << " not found in " << binDir << " (see --bin-dir) * * *\n";
+            statuses.push_back(127);
+            continue;
+        }
+        statuses.push_back(executeRun(runs[r]));
+    }
+    if (isDryRun) {
+        rmdir(kScratch);
+        return 0;
+    }
+
+    /**
+     * @section Results
+     */
+    std::cout << std::endl << kDoubleLine << "\nRESULTS\n" << kDoubleLine << std::endl;
+    const std::vector<std::string> kHeaders = {"Run", "Kernel", "Status", "Cases"};
+    const std::vector<int> kWidths = {6, 14, 10, 8};
+    for (size_t h = 0; h < kHeaders.size(); ++h)
+        std::cout << std::left << std::setw(kWidths[h]) << kHeaders[h];
+    std::cout << "\n" << std::string(38, '-') << std::endl;
+
+    ResultsSink sink("benchmark_driver");
+    int failedRuns = 0;
+    for (size_t r = 0; r < runs.size(); ++r) {
+        std::vector<ResultRecord> records;
+        if (ResultsSink::read(runs[r].resultsPath, records)) {
+            for (const ResultRecord& kRecord : records)
+                sink.addRecord(kRecord);
+        }
+        std::remove(runs[r].resultsPath.c_str());
+        failedRuns += (statuses[r] != 0) ? 1 : 0;
+
+        const std::vector<std::string> kCells = {std::to_string(r + 1), runs[r].kernel->name,
+                                                 statuses[r] == 0 ? "ok" : "exit " + std::to_string(statuses[r]),
+                                                 std::to_string(records.size())};
+        for (size_t c = 0; c < kCells.size(); ++c)
+            std::cout << std::left << std::setw(kWidths[c]) << kCells[c];
+        std::cout << std::endl;
+    }
+    rmdir(kScratch);
+
+    if (failedRuns > 0)
+        std::cerr << "\n* * * Error: " << failedRuns << " of " << runs.size() << " run(s) failed * * *\n";
+    else
+        std::cout << "\n+ + + All " << runs.size() << " run(s) completed + + +\n";
+
+    // The merged results, and the regression check over all of them
+    const bool kIsPassing = reportResults(sink, resultsOptions);
+    return (failedRuns == 0 && kIsPassing) ? 0 : 1;
+}
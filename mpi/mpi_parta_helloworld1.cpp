@@ -25,17 +25,17 @@ int main(int argc, char** argv) {
 
     // Master process configurations
     constexpr int kMasterRank = 0;
-
-    // Enforce that this program must run with 4 processes
-    if (worldRank == kMasterRank && worldSize != 4) {
-        std::cerr << "Error: this program must be run with 4 processes.\n";
-        std::cerr << "Usage: mpirun -np 4 ./<program_name>\n\n";
-        MPI_Abort(MPI_COMM_WORLD, 1);   // Stop the program for all processes
-    }
+    constexpr int kExpectedProcesses = 4;
     
     // Master process displays program info
     if (worldRank == kMasterRank) {
         std::cout << kDoubleLine << "\nMPI Task Distribution: Hello World (a)\n" << kDoubleLine << std::endl;
+
+        // Any process count works; the demo was written for 4
+        if (worldSize != kExpectedProcesses) {
+            std::cout << "- - - Warning: written for " << kExpectedProcesses << " processes, running with " << worldSize
+                << " - - -\n";
+        }
     }
 
     // Synchronize processes before executing distributed work
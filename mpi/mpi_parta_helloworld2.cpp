@@ -1,28 +1,21 @@
 #include <iostream>
 #include <mpi.h>
+#include <omp.h>
 #include <thread>
 
+#include "../common/hybrid.h"
+#include "../common/topology.h"
+
 int main(int argc, char** argv) {
     // Console UI elements
     constexpr int kLineLength = 50;
     const std::string kSingleLine(kLineLength, '-');
     const std::string kDoubleLine(kLineLength, '=');
 
-    // Initialize the MPI environment
-    MPI_Init(&argc, &argv);
-
-    // Get the total number of processes
-    int worldSize;
-    MPI_Comm_size(MPI_COMM_WORLD, &worldSize);
-
-    // Get the rank of the current process
-    int worldRank;
-    MPI_Comm_rank(MPI_COMM_WORLD, &worldRank);
-
-    // Get the name of the processor this process is running on
-    char processorName[MPI_MAX_PROCESSOR_NAME];
-    int nameLen;
-    MPI_Get_processor_name(processorName, &nameLen);
+    // Initialize MPI for hybrid use: only the master thread of each process calls MPI
+    HybridContext context = initHybrid(&argc, &argv, MPI_THREAD_FUNNELED);
+    const int worldSize = context.worldSize;
+    const int worldRank = context.worldRank;
 
     // Master process configurations
     constexpr int kMasterRank = 0;
@@ -35,25 +28,32 @@ int main(int argc, char** argv) {
         std::cout << "Configuration\n" << kSingleLine << std::endl
                 << "Number of cores: " << numCores << std::endl
                 << "Number of MPI processes: " << worldSize << std::endl;
+    }
+
+    // Cores and OpenMP team of every process, with the per-node oversubscription check
+    printHybridLayout(context);
 
-        if (numCores > 0 && worldSize > static_cast<int>(numCores)) {
-            std::cout << "\n- - - Warning: More processes than cores - expect performance impacts due to context switching - - -\n";
-        } else {
-            std::cout << "\n+ + + Good: Each process can independently run on a separate core + + +\n";
-        }
+    // Nodes, ranks per node and the NUMA domains each rank runs on
+    NodeTopology topology = makeNodeTopology(context);
+    printTopology(context, topology);
+    if (worldRank == kMasterRank)
         std::cout << std::endl;
-    }
 
     // Synchronize processes before executing distributed work
     MPI_Barrier(MPI_COMM_WORLD);
 
-    // Print a Hello World message from each process
-    std::cout << "[Process " << worldRank
-            << " - " << processorName << "]"
-            << " Hello world\n";
+    // Print a Hello World message from each thread of each process
+    #pragma omp parallel
+    {
+        #pragma omp critical
+        std::cout << "[Process " << worldRank
+                << " - " << context.processorName << "]"
+                << " Hello world from thread " << omp_get_thread_num() << " of " << omp_get_num_threads() << "\n";
+    }
 
     // Finalize the MPI environment
-    MPI_Finalize();
+    freeNodeTopology(topology);
+    finalizeHybrid(context);
 
     return 0;
 }
\ No newline at end of file
@@ -1,6 +1,436 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <iomanip>
 #include <iostream>
 #include <mpi.h>
+#include <sstream>
+#include <string>
 #include <thread>
+#include <vector>
+
+#include "../common/benchmark.h"
+#include "../common/message.h"
+#include "../common/mpibenchmark.h"
+#include "../common/options.h"
+#include "../common/results.h"
+
+// Task farm message tags
+constexpr int kWorkTag = 1;         // Master -> worker: WorkChunk to process
+constexpr int kResultTag = 2;       // Worker -> master: values of its last chunk, also a request for more work
+constexpr int kTerminateTag = 3;    // Master -> worker: no work left
+
+// Fault-tolerant farm: a chunk is overdue after kTimeoutFactor times the mean chunk time
+constexpr double kTimeoutFactor = 4.0;
+constexpr double kMinTimeout = 0.001;       // Seconds; floor under the adaptive deadline
+constexpr double kInitialTimeout = 0.010;   // Seconds; deadline before any chunk has been timed
+
+/**
+ * @brief Range of items handed to a worker, sent as a derived datatype.
+ */
+struct WorkChunk {
+    int begin = 0;
+    int count = 0;
+};
+
+/**
+ * @brief Builds the MPI datatype describing a WorkChunk.
+ */
+MPI_Datatype makeWorkChunkType() {
+    return makeStructType<WorkChunk>({{offsetof(WorkChunk, begin), MPI_INT, 1}, {offsetof(WorkChunk, count), MPI_INT, 1}});
+}
+
+/**
+ * @brief How the master sizes the chunks it hands out.
+ */
+enum class FarmSchedule { Static, Dynamic, Guided };
+
+/**
+ * @brief Master-side view of one worker in the fault-tolerant farm.
+ */
+struct WorkerState {
+    int chunk = -1;                 // Index of the chunk being processed, -1 when idle
+    int pass = -1;                  // Pass the chunk belongs to; older ones are only drained
+    double assignedAt = 0.0;        // MPI_Wtime() when the chunk was sent
+    bool isOverdue = false;         // Missed the deadline of its current chunk
+    int missedPass = -1;            // Last pass in which it missed a deadline
+};
+
+/**
+ * @brief What happened during one fault-tolerant farm pass, or in FaultTolerantFarm::finish().
+ */
+struct FaultTolerantStats {
+    int numChunks = 0;
+    int reassigned = 0;             // Overdue chunks handed to a second worker
+    int lateResults = 0;            // Results discarded because another copy finished first
+    int suspects = 0;               // Workers that missed at least one deadline
+    double cleanupTime = 0.0;       // Seconds finish() spent collecting late results
+};
+
+/**
+ * @brief Prints a formatted table header with fixed column widths.
+ * 
+ * @param headers A vector of column header title strings.
+ * @param widths A vector of column widths corresponding to each header.
+ * @param lineLength The total length of the line separator.
+ */
+void printTableHeader(const std::vector<std::string>& headers, const std::vector<int>& widths, int lineLength) {
+    for (size_t i = 0; i < headers.size(); ++i)
+        std::cout << std::left << std::setw(widths[i]) << headers[i];
+    std::cout << "\n" << std::string(lineLength, '-') << "\n";
+}
+
+/**
+ * @brief Prints a single row in a formatted table.
+ * 
+ * @param values A vector of strings representing the values in the row.
+ * @param widths vector of column widths corresponding to each value.
+ */
+void printTableRow(const std::vector<std::string>& values, const std::vector<int>& widths) {
+    for (size_t i = 0; i < values.size(); ++i)
+        std::cout << std::left << std::setw(widths[i]) << values[i];
+    std::cout << "\n";
+}
+
+/**
+ * @brief Formats a case's 95% CI half-width as a percentage of its mean, '*' if it did not converge.
+ */
+std::string formatError(const BenchmarkStats& stats) {
+    std::ostringstream error;
+    error << std::fixed << std::setprecision(1) << stats.relativeError() * 100 << "%" << (stats.converged ? "" : "*");
+    return error.str();
+}
+
+/**
+ * @brief Formats a case's median run time, '*' if it did not converge and FAILED if it failed.
+ */
+std::string formatMedian(const BenchmarkStats& stats) {
+    if (stats.failed)
+        return "FAILED";
+    return std::to_string(stats.median) + (stats.converged ? "" : "*");
+}
+
+/**
+ * @brief Joins sizes with commas for the configuration block.
+ */
+std::string joinSizes(const std::vector<int>& sizes) {
+    std::string text;
+    for (const int kSize : sizes)
+        text += (text.empty() ? "" : ",") + std::to_string(kSize);
+    return text;
+}
+
+/**
+ * @brief Determines whether every item of a farm's result holds the expected value.
+ */
+bool hasValue(const std::vector<int>& result, int value) {
+    return std::all_of(result.begin(), result.end(), [value](int item) { return item == value; });
+}
+
+/**
+ * @brief Returns the size of the next chunk the master hands out.
+ * 
+ * Mirrors the OpenMP schedules: static gives each worker one equal block, dynamic a
+ * fixed chunk per request, and guided a share of the remaining work that shrinks
+ * towards the minimum chunk size as the farm drains.
+ * 
+ * @param schedule Chunk sizing policy.
+ * @param remaining Number of items not yet handed out.
+ * @param size Total number of items.
+ * @param numWorkers Number of worker processes.
+ * @param chunkSize Dynamic chunk size and guided minimum.
+ * @return Number of items in the next chunk (at most `remaining`).
+ */
+int nextChunkSize(FarmSchedule schedule, int remaining, int size, int numWorkers, int chunkSize) {
+    int chunk = chunkSize;
+    if (schedule == FarmSchedule::Static)
+        chunk = (size + numWorkers - 1) / numWorkers;
+    else if (schedule == FarmSchedule::Guided)
+        chunk = std::max(chunkSize, (remaining + numWorkers - 1) / numWorkers);
+    return std::min(chunk, remaining);
+}
+
+/**
+ * @brief Returns an upper bound on any chunk handed out for a problem size.
+ */
+int maxChunkSize(int size, int numWorkers, int chunkSize) {
+    return std::max(chunkSize, (size + numWorkers - 1) / numWorkers);
+}
+
+/**
+ * @brief Adds one chunk of the vectors, with the same workloads as openmp_partb_schedule.cpp.
+ * 
+ * @param vect1 First input vector.
+ * @param vect2 Second input vector.
+ * @param begin First index of the chunk.
+ * @param count Number of items in the chunk.
+ * @param isBalanced Determines whether every item costs the same or every 100th sleeps.
+ * @param results Destination for the `count` sums.
+ */
+void computeChunk(const std::vector<int>& vect1, const std::vector<int>& vect2, int begin, int count, bool isBalanced, int* results) {
+    for (int i = begin; i < begin + count; ++i) {
+        results[i - begin] = vect1[i] + vect2[i];
+
+        // Simulate imbalanced workload
+        if (!isBalanced && i % 100 == 0)
+            std::this_thread::sleep_for(std::chrono::microseconds(1));
+    }
+}
+
+/**
+ * @brief Runs the master side of one task farm pass.
+ * 
+ * Answers every message from a worker with either its next chunk or the termination
+ * tag. Messages are taken from any source in arrival order, so fast workers simply
+ * come back more often. The master remembers each worker's outstanding chunk, so a
+ * result carries only values and is received straight into its place in `result`.
+ * 
+ * @param result Output vector receiving every item's result.
+ * @param schedule Chunk sizing policy.
+ * @param numWorkers Number of worker processes.
+ * @param chunkSize Dynamic chunk size and guided minimum.
+ * @param chunkType Datatype of a WorkChunk.
+ * @return Number of chunks handed out.
+ */
+int runFarmMaster(std::vector<int>& result, FarmSchedule schedule, int numWorkers, int chunkSize, MPI_Datatype chunkType) {
+    const int kSize = static_cast<int>(result.size());
+    std::vector<WorkChunk> outstanding(numWorkers + 1);
+
+    int nextItem = 0;
+    int numChunks = 0;
+    int activeWorkers = numWorkers;
+    while (activeWorkers > 0) {
+        MPI_Message message;
+        MPI_Status status;
+        const int kReceived = probeMessage(MPI_ANY_SOURCE, kResultTag, MPI_COMM_WORLD, MPI_INT, &message, &status);
+        MPI_Mrecv(result.data() + outstanding[status.MPI_SOURCE].begin, kReceived, MPI_INT, &message, MPI_STATUS_IGNORE);
+
+        if (nextItem < kSize) {
+            WorkChunk& chunk = outstanding[status.MPI_SOURCE];
+            chunk.begin = nextItem;
+            chunk.count = nextChunkSize(schedule, kSize - nextItem, kSize, numWorkers, chunkSize);
+            MPI_Send(&chunk, 1, chunkType, status.MPI_SOURCE, kWorkTag, MPI_COMM_WORLD);
+            nextItem += chunk.count;
+            ++numChunks;
+        } else {
+            MPI_Send(nullptr, 0, chunkType, status.MPI_SOURCE, kTerminateTag, MPI_COMM_WORLD);
+            --activeWorkers;
+        }
+    }
+    return numChunks;
+}
+
+/**
+ * @brief Master side of a series of task farm passes that tolerates slow or unresponsive workers.
+ * 
+ * Speaks the same protocol as runFarmMaster(), but keeps one non-blocking receive posted
+ * per worker and polls them, so no single worker can hold the master in a receive. A
+ * chunk becomes overdue after kTimeoutFactor times the mean chunk time; once the fresh
+ * chunks run out, idle workers re-execute overdue ones and whichever copy finishes first
+ * wins. A pass ends as soon as every chunk has a result. A worker still busy with a
+ * duplicate keeps its receive posted into the next pass, where its result is recognised
+ * by the pass it was assigned in and discarded, while the other workers already take the
+ * new pass's chunks. Only finish() waits for such workers and releases everyone.
+ * 
+ * Workers serve the whole series with a single runFarmWorker() call, so the passes are
+ * not separated by anything the straggler has to join.
+ */
+class FaultTolerantFarm {
+public:
+    /**
+     * @brief Posts the receive for every worker's initial request.
+     * 
+     * @param numWorkers Number of worker processes.
+     * @param chunkSize Size of every chunk (dynamic schedule).
+     * @param chunkType Datatype of a WorkChunk.
+     */
+    FaultTolerantFarm(int numWorkers, int chunkSize, MPI_Datatype chunkType)
+        : numWorkers_(numWorkers), chunkSize_(chunkSize), chunkType_(chunkType), workers_(numWorkers + 1),
+          staging_(numWorkers + 1, std::vector<int>(chunkSize)), requests_(numWorkers), indices_(numWorkers),
+          statuses_(numWorkers) {
+        for (int worker = 1; worker <= numWorkers_; ++worker)
+            postReceive(worker);
+    }
+
+    /**
+     * @brief Runs one pass over `result`, returning once every chunk of it has a result.
+     * 
+     * @param result Output vector receiving every item's result.
+     * @return Chunk, reassignment and liveness counts of the pass; late results include
+     *         duplicates of earlier passes that arrived during this one.
+     */
+    FaultTolerantStats runPass(std::vector<int>& result) {
+        const int kSize = static_cast<int>(result.size());
+        std::vector<WorkChunk> chunks;
+        for (int begin = 0; begin < kSize; begin += chunkSize_)
+            chunks.push_back({begin, std::min(chunkSize_, kSize - begin)});
+
+        ++pass_;
+        FaultTolerantStats stats;
+        stats.numChunks = static_cast<int>(chunks.size());
+        std::vector<char> isDone(chunks.size(), 0);
+        std::vector<int> copies(chunks.size(), 0);
+
+        // Fresh chunks first, then a second copy of a chunk of this pass whose worker is overdue
+        size_t nextChunk = 0;
+        auto findWork = [&]() -> int {
+            if (nextChunk < chunks.size())
+                return static_cast<int>(nextChunk++);
+            for (int worker = 1; worker <= numWorkers_; ++worker) {
+                const WorkerState& kState = workers_[worker];
+                if (kState.chunk >= 0 && kState.pass == pass_ && kState.isOverdue && !isDone[kState.chunk] &&
+                    copies[kState.chunk] < 2) {
+                    ++stats.reassigned;
+                    return kState.chunk;
+                }
+            }
+            return -1;
+        };
+
+        int doneCount = 0;
+        while (doneCount < stats.numChunks) {
+            bool madeProgress = false;
+
+            int completed = 0;
+            MPI_Testsome(numWorkers_, requests_.data(), &completed, indices_.data(), statuses_.data());
+            for (int i = 0; completed != MPI_UNDEFINED && i < completed; ++i) {
+                const int kWorker = indices_[i] + 1;
+                WorkerState& state = workers_[kWorker];
+                if (state.chunk >= 0 && state.pass == pass_ && !isDone[state.chunk]) {
+                    const WorkChunk& kChunk = chunks[state.chunk];
+                    std::memcpy(result.data() + kChunk.begin, staging_[kWorker].data(), sizeof(int) * kChunk.count);
+                    isDone[state.chunk] = 1;
+                    ++doneCount;
+                    if (!state.isOverdue) {
+                        ++timedChunks_;
+                        meanChunkTime_ += (MPI_Wtime() - state.assignedAt - meanChunkTime_) / timedChunks_;
+                    }
+                } else if (state.chunk >= 0) {
+                    ++stats.lateResults;
+                }
+                state.chunk = -1;
+                state.isOverdue = false;
+                madeProgress = true;
+            }
+
+            // Liveness: flag workers whose chunk has run past the deadline
+            const double kNow = MPI_Wtime();
+            for (int worker = 1; worker <= numWorkers_; ++worker) {
+                WorkerState& state = workers_[worker];
+                if (state.chunk >= 0 && !state.isOverdue && kNow - state.assignedAt > timeout()) {
+                    state.isOverdue = true;
+                    if (state.missedPass != pass_) {
+                        state.missedPass = pass_;
+                        ++stats.suspects;
+                    }
+                }
+            }
+
+            for (int worker = 1; worker <= numWorkers_ && doneCount < stats.numChunks; ++worker) {
+                if (requests_[worker - 1] != MPI_REQUEST_NULL)
+                    continue;
+                const int kChunk = findWork();
+                if (kChunk < 0)
+                    break;
+                MPI_Send(&chunks[kChunk], 1, chunkType_, worker, kWorkTag, MPI_COMM_WORLD);
+                postReceive(worker);
+                workers_[worker].chunk = kChunk;
+                workers_[worker].pass = pass_;
+                workers_[worker].assignedAt = MPI_Wtime();
+                ++copies[kChunk];
+                madeProgress = true;
+            }
+
+            if (!madeProgress)
+                std::this_thread::yield();
+        }
+        return stats;
+    }
+
+    /**
+     * @brief Collects what busy workers still owe, then sends every worker the termination tag.
+     * 
+     * @return Late results collected and the time spent waiting for them.
+     */
+    FaultTolerantStats finish() {
+        FaultTolerantStats stats;
+        const double kCleanupStart = MPI_Wtime();
+        for (int worker = 1; worker <= numWorkers_; ++worker) {
+            if (requests_[worker - 1] != MPI_REQUEST_NULL) {
+                MPI_Wait(&requests_[worker - 1], MPI_STATUS_IGNORE);
+                if (workers_[worker].chunk >= 0)
+                    ++stats.lateResults;
+            }
+            MPI_Send(nullptr, 0, chunkType_, worker, kTerminateTag, MPI_COMM_WORLD);
+        }
+        stats.cleanupTime = MPI_Wtime() - kCleanupStart;
+        return stats;
+    }
+
+private:
+    /**
+     * @brief Posts the receive for the next message a worker owes the master.
+     * 
+     * A receive is posted exactly while a worker owes a message (its first request, then
+     * each result), so an idle worker has none and nothing is left unmatched by finish().
+     */
+    void postReceive(int worker) {
+        MPI_Irecv(staging_[worker].data(), chunkSize_, MPI_INT, worker, kResultTag, MPI_COMM_WORLD, &requests_[worker - 1]);
+    }
+
+    /**
+     * @brief Current deadline of a chunk, adapted to the mean chunk time seen so far.
+     */
+    double timeout() const {
+        return timedChunks_ == 0 ? kInitialTimeout : std::max(kMinTimeout, kTimeoutFactor * meanChunkTime_);
+    }
+
+    int numWorkers_;
+    int chunkSize_;
+    MPI_Datatype chunkType_;
+    int pass_ = -1;
+    std::vector<WorkerState> workers_;
+    std::vector<std::vector<int>> staging_;
+    std::vector<MPI_Request> requests_;
+    std::vector<int> indices_;
+    std::vector<MPI_Status> statuses_;
+    double meanChunkTime_ = 0.0;
+    int timedChunks_ = 0;
+};
+
+/**
+ * @brief Runs the worker side of one task farm pass.
+ * 
+ * Sends an empty request, then processes chunks until the master replies with the
+ * termination tag. Each result message doubles as the request for the next chunk.
+ * 
+ * @param vect1 First input vector.
+ * @param vect2 Second input vector.
+ * @param isBalanced Workload type passed to computeChunk().
+ * @param maxChunk Upper bound on the chunk size of this pass.
+ * @param masterRank Rank of the master process.
+ * @param chunkType Datatype of a WorkChunk.
+ * @param delay Extra time spent on every chunk, to simulate a straggler.
+ */
+void runFarmWorker(const std::vector<int>& vect1, const std::vector<int>& vect2, bool isBalanced, int maxChunk, int masterRank,
+    MPI_Datatype chunkType, std::chrono::microseconds delay = std::chrono::microseconds(0)) {
+    std::vector<int> buffer(maxChunk);
+    MPI_Send(nullptr, 0, MPI_INT, masterRank, kResultTag, MPI_COMM_WORLD);
+
+    while (true) {
+        WorkChunk chunk;
+        MPI_Status status;
+        MPI_Recv(&chunk, 1, chunkType, masterRank, MPI_ANY_TAG, MPI_COMM_WORLD, &status);
+        if (status.MPI_TAG == kTerminateTag)
+            break;
+
+        computeChunk(vect1, vect2, chunk.begin, chunk.count, isBalanced, buffer.data());
+        if (delay.count() > 0)
+            std::this_thread::sleep_for(delay);
+        sendArray(buffer.data(), chunk.count, masterRank, kResultTag, MPI_COMM_WORLD);
+    }
+}
 
 int main(int argc, char** argv) {
     // Console UI elements
@@ -19,10 +449,41 @@ int main(int argc, char** argv) {
     // Master process configurations
     constexpr int kMasterRank = 0;
 
+    // Command-line options
+    const std::string kUsage = "* * * Usage: mpirun -np <number_of_processes> ./<program_name> [--sizes=LIST] "
+        "[--straggler-sizes=LIST] " + benchmarkUsage() + " " + resultsUsage() + " " + optionsUsage() + " * * *\n\n";
+    BenchmarkOptions harness;
+    std::vector<int> sizes = {10, 100, 1000, 10000, 100000, 1000000};    // Items per farm pass
+    std::vector<int> stragglerSizes = {10000, 100000, 1000000};
+    ResultsOptions resultsOptions;
+    std::vector<std::string> args;
+    std::string argError;
+    expandArguments(argc, argv, "farm", args, argError);
+    for (size_t i = 0; i < args.size() && argError.empty(); ++i) {
+        const std::string& arg = args[i];
+        if (parseBenchmarkOption(arg, harness, argError) || parseResultsOption(arg, resultsOptions, argError))
+            continue;
+        if (arg.rfind("--sizes=", 0) == 0) {
+            if (!parseIntList(arg.substr(8), sizes) || *std::min_element(sizes.begin(), sizes.end()) < 1)
+                argError = "sizes must be positive integers or ranges";
+        } else if (arg.rfind("--straggler-sizes=", 0) == 0) {
+            if (!parseIntList(arg.substr(18), stragglerSizes) || *std::min_element(stragglerSizes.begin(), stragglerSizes.end()) < 1)
+                argError = "straggler sizes must be positive integers or ranges";
+        } else {
+            argError = "unknown argument '" + arg + "'";
+        }
+    }
+    if (!argError.empty()) {
+        if (worldRank == kMasterRank)
+            std::cerr << "* * * Error: " << argError << " * * *\n" << kUsage;
+        MPI_Finalize();
+        return 1;
+    }
+
     // Enforce that this program must run with at least 2 processes (1 master + 1 slave)
     if (worldRank == kMasterRank && worldSize < 2) {
         std::cerr << "* * * Error: this program must be run with at least processes * * *\n";
-        std::cerr << "* * * Usage: mpirun -np <number_of_processes> ./<program_name> * * *\n\n";
+        std::cerr << kUsage;
         MPI_Abort(MPI_COMM_WORLD, 1);
     }
 
@@ -50,8 +511,205 @@ int main(int argc, char** argv) {
         MPI_Send(&worldRank, 1, MPI_INT, kMasterRank, 0, MPI_COMM_WORLD);
     }
 
+    /**
+     * @section Task Farm
+     * The master hands out chunks of a vector addition on request; workers come back
+     * for more as soon as they finish, so uneven items are absorbed by whoever is free.
+     */
+    constexpr int kChunkSize = 100;     // Dynamic chunk size and guided minimum
+    constexpr int kValue1 = 10;
+    constexpr int kValue2 = 20;
+    const int kNumWorkers = worldSize - 1;
+    MPI_Datatype chunkType = makeWorkChunkType();
+
+    // Each run is one farm pass timed by the master; every rank follows its stop decision
+    const BenchmarkOptions kSharedHarness = collectiveOptions(harness, MPI_COMM_WORLD);
+
+    const std::vector<FarmSchedule> kSchedules = {FarmSchedule::Static, FarmSchedule::Dynamic, FarmSchedule::Guided};
+    const std::vector<std::string> kScheduleNames = {"static", "dynamic", "guided"};
+    const std::vector<std::string> kPerformanceHeaders = {"Size", "Schedule", "Runs", "Median (s)", "CI +/-", "Min (s)", "Chunks"};
+    const std::vector<int> kPerformanceColWidths = {10, 10, 6, 14, 9, 14, 8};
+
+    if (worldRank == kMasterRank) {
+        std::cout << std::endl << kDoubleLine << "\nTASK FARM PERFORMANCE\n" << kDoubleLine << std::endl;
+        std::cout << "Configuration\n" << kSingleLine << std::endl
+                << "Number of workers: " << kNumWorkers << std::endl
+                << "Sizes: " << joinSizes(sizes) << std::endl
+                << "Straggler sizes: " << joinSizes(stragglerSizes) << std::endl
+                << "Repetition: " << describeBenchmarkOptions(harness) << std::endl
+                << "Dynamic chunk size: " << kChunkSize << std::endl
+                << "Guided minimum chunk: " << kChunkSize << std::endl
+                << "Vector1 value: " << kValue1 << std::endl
+                << "Vector2 value: " << kValue2 << std::endl;
+    }
+
+    ResultsSink sink("mpi_partb_slaves1");
+    auto addResult = [&](const std::string& group, const std::string& name, int size, const BenchmarkStats& stats,
+                         const std::vector<BenchmarkMetric>& metrics) {
+        BenchmarkResult result;
+        result.group = group;
+        result.name = name;
+        result.size = size;
+        result.workers = kNumWorkers;
+        result.stats = stats;
+        result.metrics = metrics;
+        sink.add(result, worldSize, 1);
+    };
+
+    bool isCorrect = true;
+    for (const bool kIsBalanced : {true, false}) {
+        if (worldRank == kMasterRank) {
+            std::cout << "\n[" << (kIsBalanced ? 1 : 2) << "] Task Farm Over Increasing Sizes ("
+                << (kIsBalanced ? "Balanced" : "Imbalanced") << ", median per pass)\n" << kSingleLine << kSingleLine << std::endl;
+            printTableHeader(kPerformanceHeaders, kPerformanceColWidths, 71);
+        }
+
+        for (const int size : sizes) {
+            // Inputs are replicated, so only indices and results travel
+            const std::vector<int> kVect1(size, kValue1);
+            const std::vector<int> kVect2(size, kValue2);
+            std::vector<int> result;
+
+            for (size_t s = 0; s < kSchedules.size(); ++s) {
+                int numChunks = 0;
+                const BenchmarkStats kStats = runBenchmark(kSharedHarness, [&]() {
+                    MPI_Barrier(MPI_COMM_WORLD);
+                    double elapsed = 0.0;
+                    bool isValid = true;
+                    if (worldRank == kMasterRank) {
+                        result.assign(size, 0);
+                        const double kStartTime = MPI_Wtime();
+                        numChunks = runFarmMaster(result, kSchedules[s], kNumWorkers, kChunkSize, chunkType);
+                        elapsed = MPI_Wtime() - kStartTime;
+                        isValid = hasValue(result, kValue1 + kValue2);
+                    } else {
+                        runFarmWorker(kVect1, kVect2, kIsBalanced, maxChunkSize(size, kNumWorkers, kChunkSize), kMasterRank, chunkType);
+                    }
+                    return slowestRun(elapsed, isValid, MPI_COMM_WORLD);
+                });
+                isCorrect = isCorrect && !kStats.failed;
+
+                if (worldRank == kMasterRank) {
+                    printTableRow({std::to_string(size), kScheduleNames[s], std::to_string(kStats.runs), std::to_string(kStats.median),
+                                   kStats.failed ? "FAILED" : formatError(kStats), std::to_string(kStats.min), std::to_string(numChunks)},
+                                  kPerformanceColWidths);
+                    addResult(kIsBalanced ? "balanced" : "imbalanced", kScheduleNames[s], size, kStats,
+                              {{"chunks", static_cast<double>(numChunks)}});
+                }
+            }
+        }
+    }
+
+    /**
+     * @section Fault-Tolerant Farm
+     * The last worker turns into a straggler. Every pass of the plain dynamic farm ends
+     * only when the straggler returns its last chunk. The fault-tolerant master notices
+     * the missed deadline, re-runs the chunk elsewhere and starts the next pass while the
+     * straggler is still busy, so the straggler no longer decides the wall time. Its
+     * duplicates are drained in later passes; the end-to-end time includes the final
+     * drain, in which the master waits for the straggler once per series.
+     */
+    constexpr int kFaultChunkSize = 1000;
+    const std::chrono::microseconds kStragglerDelay(20000);
+    const int kStragglerRank = worldSize - 1;
+    const std::vector<std::string> kFaultHeaders = {"Size", "Dynamic (s)", "Fault-Tol. (s)", "End-to-end (s)", "Runs (D/F)",
+                                                    "Reassigned", "Late", "Drain (s)"};
+    const std::vector<int> kFaultColWidths = {10, 14, 16, 16, 12, 12, 8, 12};
+
+    const bool kHasStraggler = (kNumWorkers >= 2);  // Reassignment needs a second worker
+
+    // The fault-tolerant passes are timed by the master alone, workers serve them in one call
+    BenchmarkOptions masterHarness = harness;
+    masterHarness.agree = nullptr;
+
+    if (worldRank == kMasterRank && !kHasStraggler)
+        std::cout << "\n- - - Warning: Straggler test needs at least 2 workers - skipped - - -\n";
+    if (worldRank == kMasterRank && kHasStraggler) {
+        std::cout << "\n[3] Straggler: Process " << kStragglerRank << " +" << kStragglerDelay.count() / 1000 << " ms per chunk ("
+            << kFaultChunkSize << "-item chunks, balanced, median per pass)\n" << kSingleLine << kSingleLine << std::endl;
+        printTableHeader(kFaultHeaders, kFaultColWidths, 100);
+    }
+
+    int totalSuspects = 0;
+    for (const int size : kHasStraggler ? stragglerSizes : std::vector<int>()) {
+        const std::vector<int> kVect1(size, kValue1);
+        const std::vector<int> kVect2(size, kValue2);
+        const std::chrono::microseconds kDelay = (worldRank == kStragglerRank) ? kStragglerDelay : std::chrono::microseconds(0);
+        std::vector<int> result;
+
+        // Plain dynamic farm: one protocol round per pass, separated by barriers
+        const BenchmarkStats kDynamicStats = runBenchmark(kSharedHarness, [&]() {
+            MPI_Barrier(MPI_COMM_WORLD);
+            double elapsed = 0.0;
+            bool isValid = true;
+            if (worldRank == kMasterRank) {
+                result.assign(size, 0);
+                const double kStartTime = MPI_Wtime();
+                runFarmMaster(result, FarmSchedule::Dynamic, kNumWorkers, kFaultChunkSize, chunkType);
+                elapsed = MPI_Wtime() - kStartTime;
+                isValid = hasValue(result, kValue1 + kValue2);
+            } else {
+                runFarmWorker(kVect1, kVect2, true, kFaultChunkSize, kMasterRank, chunkType, kDelay);
+            }
+            return slowestRun(elapsed, isValid, MPI_COMM_WORLD);
+        });
+        isCorrect = isCorrect && !kDynamicStats.failed;
+
+        // Fault-tolerant farm: back-to-back passes that workers serve in one call, so nothing
+        // between two passes waits for the straggler
+        MPI_Barrier(MPI_COMM_WORLD);
+        if (worldRank != kMasterRank) {
+            runFarmWorker(kVect1, kVect2, true, kFaultChunkSize, kMasterRank, chunkType, kDelay);
+            continue;
+        }
+        int passes = 0, reassigned = 0, lateResults = 0;
+        const double kSessionStart = MPI_Wtime();
+        FaultTolerantFarm farm(kNumWorkers, kFaultChunkSize, chunkType);
+        const BenchmarkStats kFaultStats = runBenchmark(masterHarness, [&]() {
+            result.assign(size, 0);
+            const double kStartTime = MPI_Wtime();
+            const FaultTolerantStats kStats = farm.runPass(result);
+            const double kElapsed = MPI_Wtime() - kStartTime;
+            ++passes;
+            reassigned += kStats.reassigned;
+            lateResults += kStats.lateResults;
+            totalSuspects = std::max(totalSuspects, kStats.suspects);
+            return hasValue(result, kValue1 + kValue2) ? kElapsed : -1.0;
+        });
+        const FaultTolerantStats kDrain = farm.finish();
+        const double kEndToEnd = (MPI_Wtime() - kSessionStart) / passes;
+        lateResults += kDrain.lateResults;
+        isCorrect = isCorrect && !kFaultStats.failed;
+
+        printTableRow({std::to_string(size), formatMedian(kDynamicStats), formatMedian(kFaultStats), std::to_string(kEndToEnd),
+                       std::to_string(kDynamicStats.runs) + "/" + std::to_string(kFaultStats.runs), std::to_string(reassigned),
+                       std::to_string(lateResults), std::to_string(kDrain.cleanupTime)},
+                      kFaultColWidths);
+        addResult("straggler", "dynamic", size, kDynamicStats, {});
+        addResult("straggler", "fault-tolerant", size, kFaultStats,
+                  {{"end_to_end_s", kEndToEnd}, {"reassigned", static_cast<double>(reassigned)},
+                   {"late_results", static_cast<double>(lateResults)}, {"drain_s", kDrain.cleanupTime}});
+    }
+
+    if (worldRank == kMasterRank) {
+        if (kHasStraggler)
+            std::cout << "\nWorkers that missed a deadline (most in one pass): " << totalSuspects
+                      << "\nEnd-to-end: session wall time including the final drain over every pass, warmups included" << std::endl;
+        std::cout << "* = did not reach the target precision, FAILED = wrong or missing results" << std::endl;
+        if (isCorrect)
+            std::cout << "\n+ + + All task farm results verified + + +\n";
+        else
+            std::cerr << "\n* * * Error: the task farm returned wrong or missing results * * *\n";
+    }
+
+    // A failed write or a regression fails every rank
+    bool isPassing = (worldRank == kMasterRank) ? reportResults(sink, resultsOptions) : true;
+    MPI_Bcast(&isPassing, 1, MPI_CXX_BOOL, kMasterRank, MPI_COMM_WORLD);
+
+    MPI_Type_free(&chunkType);
+
     // Finalize the MPI environment
     MPI_Finalize();
 
-    return 0;
+    return (isCorrect && isPassing) ? 0 : 1;
 }
\ No newline at end of file
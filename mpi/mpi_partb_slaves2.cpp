@@ -1,6 +1,194 @@
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
 #include <iostream>
 #include <mpi.h>
+#include <sstream>
+#include <string>
 #include <thread>
+#include <vector>
+
+#include "../common/benchmark.h"
+#include "../common/message.h"
+#include "../common/mpibenchmark.h"
+#include "../common/options.h"
+#include "../common/results.h"
+
+// Gather benchmark message tag
+constexpr int kGatherTag = 1;
+
+/**
+ * @brief How the master collects one message from every slave.
+ */
+enum class GatherMode { Blocking, Waitsome, Testsome };
+
+/**
+ * @brief Simulated costs of one gather round.
+ */
+struct GatherWorkload {
+    int payloadLength = 0;          // Characters per slave message (--sizes)
+    int rounds = 0;                 // Gather rounds per timed run
+    double slaveWork = 0.0;         // Seconds a slave computes before replying
+    double slaveJitter = 0.0;       // Extra seconds per (rank % 4), so replies arrive spread out
+    double masterWork = 0.0;        // Seconds of the master's own compute per round
+    int masterWorkUnits = 0;        // Slices the master's compute is split into when polling
+    double processWork = 0.0;       // Seconds the master spends handling one message
+};
+
+/**
+ * @brief Prints a formatted table header with fixed column widths.
+ * 
+ * @param headers A vector of column header title strings.
+ * @param widths A vector of column widths corresponding to each header.
+ * @param lineLength The total length of the line separator.
+ */
+void printTableHeader(const std::vector<std::string>& headers, const std::vector<int>& widths, int lineLength) {
+    for (size_t i = 0; i < headers.size(); ++i)
+        std::cout << std::left << std::setw(widths[i]) << headers[i];
+    std::cout << "\n" << std::string(lineLength, '-') << "\n";
+}
+
+/**
+ * @brief Prints a single row in a formatted table.
+ * 
+ * @param values A vector of strings representing the values in the row.
+ * @param widths vector of column widths corresponding to each value.
+ */
+void printTableRow(const std::vector<std::string>& values, const std::vector<int>& widths) {
+    for (size_t i = 0; i < values.size(); ++i)
+        std::cout << std::left << std::setw(widths[i]) << values[i];
+    std::cout << "\n";
+}
+
+/**
+ * @brief Formats a case's 95% CI half-width as a percentage of its mean, '*' if it did not converge.
+ */
+std::string formatError(const BenchmarkStats& stats) {
+    std::ostringstream error;
+    error << std::fixed << std::setprecision(1) << stats.relativeError() * 100 << "%" << (stats.converged ? "" : "*");
+    return error.str();
+}
+
+/**
+ * @brief Joins sizes with commas for the configuration block.
+ */
+std::string joinSizes(const std::vector<int>& sizes) {
+    std::string text;
+    for (const int kSize : sizes)
+        text += (text.empty() ? "" : ",") + std::to_string(kSize);
+    return text;
+}
+
+/**
+ * @brief Busy-waits for a number of seconds to stand in for computation.
+ */
+void spinFor(double seconds) {
+    const double kEndTime = MPI_Wtime() + seconds;
+    while (MPI_Wtime() < kEndTime) {}
+}
+
+/**
+ * @brief Handles one slave message on the master.
+ * 
+ * @param message Received payload.
+ * @param length Number of characters in the payload.
+ * @param processWork Simulated handling cost in seconds.
+ * @return Checksum of the payload.
+ */
+long long processMessage(const char* message, int length, double processWork) {
+    long long checksum = 0;
+    for (int i = 0; i < length; ++i)
+        checksum += message[i];
+    spinFor(processWork);
+    return checksum;
+}
+
+/**
+ * @brief Runs the master side of the gather rounds in one mode.
+ * 
+ * Blocking receives in an MPI_ANY_SOURCE loop, leaving the master idle until every
+ * slave has replied, then does its own compute. Waitsome pre-posts one receive per
+ * slave, computes, then handles replies in completion order. Testsome pre-posts the
+ * same receives but polls between slices of its compute, so replies are handled as
+ * they land and large messages already flow while the master is busy.
+ * 
+ * @param comm Communicator with the master as rank 0.
+ * @param mode Gather strategy.
+ * @param workload Simulated costs.
+ * @return Checksum over every received payload.
+ */
+long long gatherOnMaster(MPI_Comm comm, GatherMode mode, const GatherWorkload& workload) {
+    int commSize;
+    MPI_Comm_size(comm, &commSize);
+    const int kNumSlaves = commSize - 1;
+    const int kLength = workload.payloadLength;
+
+    // One pre-posted buffer per slave
+    std::vector<char> buffers(static_cast<size_t>(kLength) * commSize);
+    std::vector<MPI_Request> requests(kNumSlaves);
+    std::vector<int> indices(kNumSlaves);
+
+    long long checksum = 0;
+    for (int round = 0; round < workload.rounds; ++round) {
+        if (mode == GatherMode::Blocking) {
+            for (int i = 0; i < kNumSlaves; ++i) {
+                MPI_Recv(buffers.data(), kLength, MPI_CHAR, MPI_ANY_SOURCE, kGatherTag, comm, MPI_STATUS_IGNORE);
+                checksum += processMessage(buffers.data(), kLength, workload.processWork);
+            }
+            spinFor(workload.masterWork);
+            continue;
+        }
+
+        for (int slave = 1; slave <= kNumSlaves; ++slave) {
+            MPI_Irecv(buffers.data() + static_cast<size_t>(slave) * kLength, kLength, MPI_CHAR, slave, kGatherTag, comm,
+                      &requests[slave - 1]);
+        }
+
+        int remaining = kNumSlaves;
+        auto handleCompleted = [&](int count) {
+            for (int i = 0; i < count; ++i)
+                checksum += processMessage(buffers.data() + static_cast<size_t>(indices[i] + 1) * kLength, kLength, workload.processWork);
+            remaining -= count;
+        };
+
+        if (mode == GatherMode::Testsome) {
+            for (int unit = 0; unit < workload.masterWorkUnits; ++unit) {
+                spinFor(workload.masterWork / workload.masterWorkUnits);
+                int count = 0;
+                if (remaining > 0)
+                    MPI_Testsome(kNumSlaves, requests.data(), &count, indices.data(), MPI_STATUSES_IGNORE);
+                if (count != MPI_UNDEFINED)
+                    handleCompleted(count);
+            }
+        } else {
+            spinFor(workload.masterWork);
+        }
+
+        while (remaining > 0) {
+            int count = 0;
+            MPI_Waitsome(kNumSlaves, requests.data(), &count, indices.data(), MPI_STATUSES_IGNORE);
+            handleCompleted(count);
+        }
+    }
+    return checksum;
+}
+
+/**
+ * @brief Runs the slave side of the gather rounds.
+ * 
+ * @param comm Communicator with the master as rank 0.
+ * @param workload Simulated costs.
+ */
+void gatherFromSlave(MPI_Comm comm, const GatherWorkload& workload) {
+    int commRank;
+    MPI_Comm_rank(comm, &commRank);
+    const std::vector<char> kPayload(workload.payloadLength, static_cast<char>('a' + commRank % 26));
+
+    for (int round = 0; round < workload.rounds; ++round) {
+        spinFor(workload.slaveWork + workload.slaveJitter * (commRank % 4));
+        MPI_Send(kPayload.data(), workload.payloadLength, MPI_CHAR, 0, kGatherTag, comm);
+    }
+}
 
 int main(int argc, char** argv) {
     // Console UI elements
@@ -18,12 +206,43 @@ int main(int argc, char** argv) {
 
     // Master process configurations
     constexpr int kMasterRank = 0;
-    constexpr int kMaxMessageLength = 100;
+
+    // Command-line options
+    const std::string kUsage = "* * * Usage: mpirun -np <number_of_processes> ./<program_name> [--sizes=LIST] [--rounds=N] "
+        + benchmarkUsage() + " " + resultsUsage() + " " + optionsUsage() + " * * *\n\n";
+    BenchmarkOptions harness;
+    std::vector<int> sizes = {1 << 16};     // 64 KiB, past the eager limit so pre-posting matters
+    int rounds = 20;
+    ResultsOptions resultsOptions;
+    std::vector<std::string> args;
+    std::string argError;
+    expandArguments(argc, argv, "gather", args, argError);
+    for (size_t i = 0; i < args.size() && argError.empty(); ++i) {
+        const std::string& arg = args[i];
+        if (parseBenchmarkOption(arg, harness, argError) || parseResultsOption(arg, resultsOptions, argError))
+            continue;
+        if (arg.rfind("--sizes=", 0) == 0) {
+            if (!parseIntList(arg.substr(8), sizes) || *std::min_element(sizes.begin(), sizes.end()) < 1)
+                argError = "sizes must be positive integers or ranges";
+        } else if (arg.rfind("--rounds=", 0) == 0) {
+            rounds = std::atoi(arg.c_str() + 9);
+            if (rounds < 1)
+                argError = "rounds must be positive";
+        } else {
+            argError = "unknown argument '" + arg + "'";
+        }
+    }
+    if (!argError.empty()) {
+        if (worldRank == kMasterRank)
+            std::cerr << "* * * Error: " << argError << " * * *\n" << kUsage;
+        MPI_Finalize();
+        return 1;
+    }
 
     // Enforce that this program must run with at least 2 processes (1 master + 1 slave)
     if (worldRank == kMasterRank && worldSize < 2) {
         std::cerr << "* * * Error: this program must be run with at least processes * * *\n";
-        std::cerr << "* * * Usage: mpirun -np <number_of_processes> ./<program_name> * * *\n\n";
+        std::cerr << kUsage;
         MPI_Abort(MPI_COMM_WORLD, 1);
     }
 
@@ -38,14 +257,13 @@ int main(int argc, char** argv) {
 
         std::cout << "\nMaster: Hello slaves give me your messages\n" << kSingleLine << std::endl;
 
-        // Master process receives messages from slave processes
-        char recvBuffer[kMaxMessageLength];
+        // Master process receives messages from slave processes (sized by probing, any length)
         MPI_Status status;
 
         for (int i = 1; i < worldSize; ++i) {
-            MPI_Recv(recvBuffer, kMaxMessageLength, MPI_INT, MPI_ANY_SOURCE, 0, MPI_COMM_WORLD, &status);
+            const std::string kMessage = recvString(MPI_ANY_SOURCE, 0, MPI_COMM_WORLD, &status);
             int senderRank = status.MPI_SOURCE; // Get rank of source process
-            std::cout << "Message received from process " << senderRank << ": " << recvBuffer << std::endl;
+            std::cout << "Message received from process " << senderRank << ": " << kMessage << std::endl;
         }
 
         std::cout << kSingleLine << "\nMaster: All messages received from slave processes" << std::endl;
@@ -64,11 +282,121 @@ int main(int argc, char** argv) {
 
         finalMessage = messageTemplate + senderName;
 
-        MPI_Send(finalMessage.c_str(), finalMessage.size() + 1, MPI_CHAR, kMasterRank, 0, MPI_COMM_WORLD);
+        sendString(finalMessage, kMasterRank, 0, MPI_COMM_WORLD);
+    }
+
+    /**
+     * @section Gather Performance
+     * Blocking receive loop vs pre-posted non-blocking receives over growing process
+     * counts, each run on the first P ranks of MPI_COMM_WORLD.
+     */
+    GatherWorkload workload;
+    workload.rounds = rounds;
+    workload.slaveWork = 200e-6;
+    workload.slaveJitter = 50e-6;
+    workload.masterWork = 200e-6;
+    workload.masterWorkUnits = 20;
+    workload.processWork = 5e-6;
+
+    const std::vector<GatherMode> kModes = {GatherMode::Blocking, GatherMode::Waitsome, GatherMode::Testsome};
+    const std::vector<std::string> kModeNames = {"blocking", "waitsome", "testsome"};
+    const std::vector<std::string> kPerformanceHeaders = {"Processes", "Size (B)", "Mode", "Runs", "Median (s)", "CI +/-", "Min (s)",
+                                                          "Speedup"};
+    const std::vector<int> kPerformanceColWidths = {12, 10, 12, 6, 14, 9, 14, 10};
+
+    // Process counts: powers of two, then the full world
+    std::vector<int> processCounts;
+    for (int count = 2; count < worldSize; count *= 2)
+        processCounts.push_back(count);
+    if (worldSize >= 2)
+        processCounts.push_back(worldSize);
+
+    if (worldRank == kMasterRank) {
+        std::cout << std::endl << kDoubleLine << "\nGATHER PERFORMANCE\n" << kDoubleLine << std::endl;
+        std::cout << "Configuration\n" << kSingleLine << std::endl
+                << "Message sizes: " << joinSizes(sizes) << " bytes" << std::endl
+                << "Rounds per run: " << workload.rounds << std::endl
+                << "Repetition: " << describeBenchmarkOptions(harness) << std::endl
+                << "Slave compute per round: " << workload.slaveWork * 1e6 << " us (+" << workload.slaveJitter * 1e6
+                << " us per rank % 4)" << std::endl
+                << "Master compute per round: " << workload.masterWork * 1e6 << " us in " << workload.masterWorkUnits
+                << " slices" << std::endl
+                << "Master handling per message: " << workload.processWork * 1e6 << " us" << std::endl
+                << "Speedup: Blocking median / mode median" << std::endl;
+
+        std::cout << "\n[1] Master Gather Over Increasing Process Counts (median per round, slowest process)\n" << kSingleLine << std::endl;
+        printTableHeader(kPerformanceHeaders, kPerformanceColWidths, 87);
     }
 
+    ResultsSink sink("mpi_partb_slaves2");
+    bool isCorrect = true;
+    for (const int kProcesses : processCounts) {
+        MPI_Comm gatherComm;
+        MPI_Comm_split(MPI_COMM_WORLD, worldRank < kProcesses ? 0 : MPI_UNDEFINED, worldRank, &gatherComm);
+
+        if (gatherComm != MPI_COMM_NULL) {
+            // Every process of the gather follows the master's stop decision
+            const BenchmarkOptions kSharedHarness = collectiveOptions(harness, gatherComm);
+            for (const int kSize : sizes) {
+                workload.payloadLength = kSize;
+
+                // Every slave sends rounds x payloadLength copies of its letter
+                long long expectedChecksum = 0;
+                for (int slave = 1; slave < kProcesses; ++slave)
+                    expectedChecksum += static_cast<long long>('a' + slave % 26) * workload.payloadLength * workload.rounds;
+
+                double blockingMedian = 0.0;
+                for (size_t m = 0; m < kModes.size(); ++m) {
+                    const BenchmarkStats kStats = runBenchmark(kSharedHarness, [&]() {
+                        MPI_Barrier(gatherComm);
+                        const double kStartTime = MPI_Wtime();
+                        bool isValid = true;
+                        if (worldRank == kMasterRank)
+                            isValid = gatherOnMaster(gatherComm, kModes[m], workload) == expectedChecksum;
+                        else
+                            gatherFromSlave(gatherComm, workload);
+                        return slowestRun((MPI_Wtime() - kStartTime) / workload.rounds, isValid, gatherComm);
+                    });
+                    isCorrect = isCorrect && !kStats.failed;
+                    if (kModes[m] == GatherMode::Blocking)
+                        blockingMedian = kStats.median;
+
+                    if (worldRank == kMasterRank) {
+                        const bool kHasSpeedup = !kStats.failed && blockingMedian > 0.0 && kStats.median > 0.0;
+                        printTableRow({std::to_string(kProcesses), std::to_string(kSize), kModeNames[m], std::to_string(kStats.runs),
+                                       std::to_string(kStats.median), kStats.failed ? "FAILED" : formatError(kStats), std::to_string(kStats.min),
+                                       kHasSpeedup ? std::to_string(blockingMedian / kStats.median) : "-"},
+                                      kPerformanceColWidths);
+
+                        BenchmarkResult result;
+                        result.group = "gather";
+                        result.name = kModeNames[m];
+                        result.size = workload.payloadLength;
+                        result.workers = kProcesses;
+                        result.stats = kStats;
+                        result.speedup = kHasSpeedup ? blockingMedian / kStats.median : 0.0;
+                        sink.add(result, worldSize, 1);
+                    }
+                }
+            }
+            MPI_Comm_free(&gatherComm);
+        }
+        MPI_Barrier(MPI_COMM_WORLD);
+    }
+
+    if (worldRank == kMasterRank) {
+        if (isCorrect)
+            std::cout << "\n+ + + Every gathered payload matched its checksum + + +\n";
+        else
+            std::cerr << "\n* * * Error: a gather mode lost or corrupted a message * * *\n";
+    }
+
+    // A failed write or a regression fails every rank
+    bool isPassing = (worldRank == kMasterRank) ? reportResults(sink, resultsOptions) : true;
+    MPI_Bcast(&isPassing, 1, MPI_CXX_BOOL, kMasterRank, MPI_COMM_WORLD);
+
     // Finalize the MPI environment
     MPI_Finalize();
 
-    return 0;
+    return (isCorrect && isPassing) ? 0 : 1;
 }
\ No newline at end of file
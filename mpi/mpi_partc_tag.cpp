@@ -1,7 +1,192 @@
+#include <algorithm>
+#include <iomanip>
 #include <iostream>
 #include <mpi.h>
+#include <sstream>
 #include <string>
 #include <thread>
+#include <vector>
+
+#include "../common/benchmark.h"
+#include "../common/dispatcher.h"
+#include "../common/message.h"
+#include "../common/options.h"
+#include "../common/results.h"
+
+constexpr int kMasterRank = 0;
+
+// RPC tag space: control messages are small and latency-critical, data messages are large
+constexpr int kPingTag = 200;           // Control: master -> worker, echoed back
+constexpr int kPongTag = 201;           // Control: worker -> master
+constexpr int kStopTag = 202;           // Control: master -> worker, ends the scenario
+constexpr int kSumTag = 210;            // Data: master -> worker, vector to reduce
+constexpr int kSumResultTag = 211;      // Data: worker -> master, {request id, sum}
+
+// RPC benchmark configurations
+constexpr int kSumElements = 1 << 17;   // 1 MiB of doubles per data request
+constexpr int kSumsInFlight = 8;        // Data requests kept outstanding per worker under load
+
+/**
+ * @brief One run of the RPC benchmark.
+ */
+struct RpcScenario {
+    std::string name;
+    bool loaded;                // Keep kSumsInFlight data requests outstanding per worker
+    bool prioritizeControl;     // Dispatcher probes control tags before data
+};
+
+/**
+ * @brief What the master measured in one scenario.
+ */
+struct RpcStats {
+    BenchmarkStats ping;        // Seconds per control round trip
+    double sumsPerSecond = 0.0;
+    bool isCorrect = true;
+};
+
+/**
+ * @brief Prints a formatted table header with fixed column widths.
+ * 
+ * @param headers A vector of column header title strings.
+ * @param widths A vector of column widths corresponding to each header.
+ * @param lineLength The total length of the line separator.
+ */
+void printTableHeader(const std::vector<std::string>& headers, const std::vector<int>& widths, int lineLength) {
+    for (size_t i = 0; i < headers.size(); ++i)
+        std::cout << std::left << std::setw(widths[i]) << headers[i];
+    std::cout << "\n" << std::string(lineLength, '-') << "\n";
+}
+
+/**
+ * @brief Prints a single row in a formatted table.
+ * 
+ * @param values A vector of strings representing the values in the row.
+ * @param widths vector of column widths corresponding to each value.
+ */
+void printTableRow(const std::vector<std::string>& values, const std::vector<int>& widths) {
+    for (size_t i = 0; i < values.size(); ++i)
+        std::cout << std::left << std::setw(widths[i]) << values[i];
+    std::cout << "\n";
+}
+
+/**
+ * @brief Formats a case's 95% CI half-width as a percentage of its mean, '*' if it did not converge.
+ */
+std::string formatError(const BenchmarkStats& stats) {
+    std::ostringstream error;
+    error << std::fixed << std::setprecision(1) << stats.relativeError() * 100 << "%" << (stats.converged ? "" : "*");
+    return error.str();
+}
+
+/**
+ * @brief Serves RPC requests from the master until it sends kStopTag.
+ * 
+ * Pings are echoed straight back; sum requests are reduced and answered with the
+ * request id and the sum.
+ * 
+ * @param prioritizeControl Dispatcher mode, matching the master's.
+ */
+void runRpcWorker(bool prioritizeControl) {
+    MessageDispatcher dispatcher(MPI_COMM_WORLD, prioritizeControl);
+    bool stopped = false;
+
+    dispatcher.on(kPingTag, [&](const IncomingMessage& message) {
+        dispatcher.post(message.source, kPongTag, message.data, message.length);
+    }, MessageClass::Control);
+    dispatcher.on(kStopTag, [&](const IncomingMessage&) { stopped = true; }, MessageClass::Control);
+    dispatcher.on(kSumTag, [&](const IncomingMessage& message) {
+        double sum = 0.0;
+        for (int i = 0; i < message.count<double>(); ++i)
+            sum += message.get<double>(i);
+        const double kReply[2] = {message.get<double>(0), sum};
+        dispatcher.post(message.source, kSumResultTag, kReply, 2);
+    });
+
+    dispatcher.runUntil([&] { return stopped; });
+}
+
+/**
+ * @brief Times control round trips on the master, optionally while data requests stream.
+ * 
+ * Every round trip is one run of the harness; the workers only serve, so the master
+ * decides alone how many it needs. Under load every answered sum request is replaced
+ * by a new one, so each worker always has kSumsInFlight large requests queued while
+ * the pings run. Each request carries its id in element 0 and the value id % 7 + 1
+ * elsewhere, so every sum can be checked; a wrong sum fails the scenario.
+ * 
+ * @param scenario Load and dispatcher mode.
+ * @param numWorkers Workers are ranks 1..numWorkers.
+ * @param harness Warmup, repetition and precision settings of the pings.
+ * @return Ping latency statistics and data throughput.
+ */
+RpcStats runRpcMaster(const RpcScenario& scenario, int numWorkers, const BenchmarkOptions& harness) {
+    MessageDispatcher dispatcher(MPI_COMM_WORLD, scenario.prioritizeControl);
+    RpcStats stats;
+    double latency = 0.0;
+    std::vector<double> request(kSumElements);
+    double pingStart = 0.0;
+    bool pongReceived = false;
+    bool keepLoading = scenario.loaded;
+    int outstanding = 0;
+    int nextId = 0;
+    long long sumsDone = 0;
+
+    auto postSum = [&](int worker) {
+        const double kValue = static_cast<double>(nextId % 7 + 1);
+        std::fill(request.begin(), request.end(), kValue);
+        request[0] = static_cast<double>(nextId++);
+        dispatcher.post(worker, kSumTag, request.data(), kSumElements);
+        ++outstanding;
+    };
+
+    dispatcher.on(kPongTag, [&](const IncomingMessage&) {
+        latency = MPI_Wtime() - pingStart;
+        pongReceived = true;
+    }, MessageClass::Control);
+    dispatcher.on(kSumResultTag, [&](const IncomingMessage& message) {
+        const double kId = message.get<double>(0);
+        const double kExpected = kId + (kSumElements - 1) * static_cast<double>(static_cast<int>(kId) % 7 + 1);
+        if (message.get<double>(1) != kExpected)
+            stats.isCorrect = false;
+        --outstanding;
+        ++sumsDone;
+        if (keepLoading)
+            postSum(message.source);
+    });
+
+    if (scenario.loaded) {
+        for (int worker = 1; worker <= numWorkers; ++worker) {
+            for (int i = 0; i < kSumsInFlight; ++i)
+                postSum(worker);
+        }
+    }
+
+    // Only the master decides when the pings are measured precisely enough
+    BenchmarkOptions masterHarness = harness;
+    masterHarness.agree = nullptr;
+
+    const double kStart = MPI_Wtime();
+    int ping = 0;
+    stats.ping = runBenchmark(masterHarness, [&]() {
+        pongReceived = false;
+        pingStart = MPI_Wtime();
+        dispatcher.post(ping % numWorkers + 1, kPingTag, &ping, 1);
+        ++ping;
+        dispatcher.runUntil([&] { return pongReceived; });
+        return stats.isCorrect ? latency : -1.0;
+    });
+    keepLoading = false;
+    dispatcher.runUntil([&] { return outstanding == 0; });
+    const double kElapsed = MPI_Wtime() - kStart;
+
+    for (int worker = 1; worker <= numWorkers; ++worker)
+        dispatcher.post(worker, kStopTag, std::vector<char>());
+    dispatcher.drain();
+
+    stats.ping.failed = stats.ping.failed || !stats.isCorrect;
+    stats.sumsPerSecond = sumsDone / kElapsed;
+    return stats;
+}
 
 int main(int argc, char** argv) {
     // Console UI elements
@@ -18,15 +203,36 @@ int main(int argc, char** argv) {
     MPI_Comm_rank(MPI_COMM_WORLD, &worldRank);
 
     // Main program configurations
-    constexpr int kMasterRank = 0;
-    constexpr int kMaxMessageLength = 100;
     constexpr int kMasterTag = 100;
     constexpr int kSlaveWaitTag = 101;
 
+    // Command-line options
+    const std::string kUsage = "* * * Usage: mpirun -np <number_of_processes> ./<program_name> "
+        + benchmarkUsage() + " " + resultsUsage() + " " + optionsUsage() + " * * *\n\n";
+    BenchmarkOptions harness;
+    harness.minRuns = 20;           // Round trips are short; the tail percentiles need more of them
+    harness.maxRuns = 1000;
+    ResultsOptions resultsOptions;
+    std::vector<std::string> args;
+    std::string argError;
+    expandArguments(argc, argv, "rpc", args, argError);
+    for (size_t i = 0; i < args.size() && argError.empty(); ++i) {
+        const std::string& arg = args[i];
+        if (parseBenchmarkOption(arg, harness, argError) || parseResultsOption(arg, resultsOptions, argError))
+            continue;
+        argError = "unknown argument '" + arg + "'";
+    }
+    if (!argError.empty()) {
+        if (worldRank == kMasterRank)
+            std::cerr << "* * * Error: " << argError << " * * *\n" << kUsage;
+        MPI_Finalize();
+        return 1;
+    }
+
     // Enforce that this program must run with at least 2 processes (1 master + 1 slave)
     if (worldRank == kMasterRank && worldSize < 2) {
         std::cerr << "* * * Error: this program must be run with at least processes * * *\n";
-        std::cerr << "* * * Usage: mpirun -np <number_of_processes> ./<program_name> * * *\n\n";
+        std::cerr << kUsage;
         MPI_Abort(MPI_COMM_WORLD, 1);
     }
 
@@ -42,7 +248,11 @@ int main(int argc, char** argv) {
                 << "Number of cores: " << numCores << std::endl
                 << "Number of MPI processes: " << worldSize << std::endl
                 << "Master Tag: " << kMasterTag << std::endl
-                << "Slave Wait Tag: " << kSlaveWaitTag << std::endl << std::endl;
+                << "Slave Wait Tag: " << kSlaveWaitTag << std::endl
+                << "RPC control tags: " << kPingTag << "-" << kStopTag << ", data tags: " << kSumTag << "-" << kSumResultTag << std::endl
+                << "RPC data request: " << (kSumElements * sizeof(double) >> 10) << " KiB, " << kSumsInFlight
+                << " in flight per worker" << std::endl
+                << "RPC pings: " << describeBenchmarkOptions(harness) << std::endl << std::endl;
         
         // Master process sends custom messages to each slave process
         for (int destRank = 1; destRank < worldSize; ++destRank) {
@@ -56,23 +266,90 @@ int main(int argc, char** argv) {
 
             std::cout << "[Master] Sending to Process " << destRank << " with tag " << kMasterTag << ": " << finalMessage << std::endl;
 
-            MPI_Send(finalMessage.c_str(), finalMessage.size() + 1, MPI_CHAR, destRank, kMasterTag, MPI_COMM_WORLD);
+            sendString(finalMessage, destRank, kMasterTag, MPI_COMM_WORLD);
         }
     } else {
         // Slave process configurations
-        char recvBuffer[kMaxMessageLength];
+        constexpr double kWaitSeconds = 0.5;
         MPI_Status status;
 
         std::cout << "[Process " << worldRank << "] Waiting to receive message with tag " << kSlaveWaitTag << "...\n";
 
-        // Slave processes receive message with the tag
-        MPI_Recv(recvBuffer, kMaxMessageLength, MPI_CHAR, kMasterRank, kSlaveWaitTag, MPI_COMM_WORLD, &status);
+        // Poll for the expected tag; a blocking receive on it would never return
+        int found = 0;
+        const double kDeadline = MPI_Wtime() + kWaitSeconds;
+        while (!found && MPI_Wtime() < kDeadline)
+            MPI_Iprobe(kMasterRank, kSlaveWaitTag, MPI_COMM_WORLD, &found, &status);
+
+        if (!found) {
+            // Nothing matches the tag we wait on; find out which tag the master actually used
+            MPI_Probe(kMasterRank, MPI_ANY_TAG, MPI_COMM_WORLD, &status);
+            std::cout << "[Process " << worldRank << "] - - - Nothing arrived with tag " << kSlaveWaitTag
+                << ", but a message is pending with tag " << status.MPI_TAG << " - - -\n";
+        }
+
+        // Slave processes receive message with the tag it was really sent with (sized by probing, any length)
+        const std::string kMessage = recvString(kMasterRank, status.MPI_TAG, MPI_COMM_WORLD, &status);
+
+        std::cout << "[Process " << worldRank << "] Received from master (actual tag " << status.MPI_TAG << "): " << kMessage << std::endl;
+    }
+
+    // RPC dispatcher: control and data requests multiplexed over the tag space
+    const std::vector<RpcScenario> kScenarios = {
+        {"Idle", false, true},
+        {"Loaded, arrival order", true, false},
+        {"Loaded, control first", true, true},
+    };
+    const std::vector<std::string> kHeaders = {"Scenario", "Pings", "Min (us)", "Median (us)", "p95 (us)", "CI +/-", "Sums/s"};
+    const std::vector<int> kWidths = {24, 7, 14, 14, 14, 9, 10};
+    constexpr int kTableLength = 92;
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    if (worldRank == kMasterRank) {
+        std::cout << "\nRPC Dispatcher: Control Round Trips\n"
+            << std::string(kTableLength, '-') << std::endl;
+        printTableHeader(kHeaders, kWidths, kTableLength);
+    }
+
+    ResultsSink sink("mpi_partc_tag");
+    bool isCorrect = true;
+    for (const RpcScenario& scenario : kScenarios) {
+        if (worldRank == kMasterRank) {
+            const RpcStats kStats = runRpcMaster(scenario, worldSize - 1, harness);
+            isCorrect = isCorrect && !kStats.ping.failed;
+            printTableRow({scenario.name, std::to_string(kStats.ping.runs), std::to_string(kStats.ping.min * 1e6),
+                           std::to_string(kStats.ping.median * 1e6), std::to_string(kStats.ping.p95 * 1e6),
+                           kStats.ping.failed ? "FAILED" : formatError(kStats.ping),
+                           std::to_string(static_cast<long long>(kStats.sumsPerSecond))},
+                          kWidths);
 
-        std::cout << "[Process " << worldRank << "] Received from master (actual tag " << status.MPI_TAG << "): " << recvBuffer << std::endl;
+            BenchmarkResult result;
+            result.group = "rpc-ping";
+            result.name = scenario.name;
+            result.size = kSumElements;
+            result.workers = worldSize - 1;
+            result.stats = kStats.ping;
+            result.metrics = {{"sums_per_s", kStats.sumsPerSecond}};
+            sink.add(result, worldSize, 1);
+        } else {
+            runRpcWorker(scenario.prioritizeControl);
+        }
+        MPI_Barrier(MPI_COMM_WORLD);
     }
 
+    if (worldRank == kMasterRank) {
+        if (isCorrect)
+            std::cout << "\n+ + + Every data request returned the expected sum + + +\n";
+        else
+            std::cerr << "\n* * * Error: a data request returned a wrong sum * * *\n";
+    }
+
+    // A failed write or a regression fails every rank
+    bool isPassing = (worldRank == kMasterRank) ? reportResults(sink, resultsOptions) : true;
+    MPI_Bcast(&isPassing, 1, MPI_CXX_BOOL, kMasterRank, MPI_COMM_WORLD);
+
     // Finalize the MPI environment
     MPI_Finalize();
 
-    return 0;
+    return (isCorrect && isPassing) ? 0 : 1;
 }
\ No newline at end of file
@@ -0,0 +1,714 @@
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <mpi.h>
+#include <omp.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../common/benchmark.h"
+#include "../common/hybrid.h"
+#include "../common/mpibenchmark.h"
+#include "../common/matrix.h"
+#include "../common/options.h"
+#include "../common/results.h"
+#include "../common/topology.h"
+
+// Message tags used to distribute operand blocks and collect result blocks
+constexpr int kTagBlockA = 1;
+constexpr int kTagBlockB = 2;
+constexpr int kTagBlockC = 3;
+
+/**
+ * @brief Maps a matrix element type to its MPI datatype.
+ * 
+ * @tparam T Element type.
+ */
+template <typename T>
+struct MpiElement;
+
+template <>
+struct MpiElement<int32_t> {
+    static MPI_Datatype type() { return MPI_INT32_T; }
+};
+
+template <>
+struct MpiElement<int64_t> {
+    static MPI_Datatype type() { return MPI_INT64_T; }
+};
+
+template <>
+struct MpiElement<float> {
+    static MPI_Datatype type() { return MPI_FLOAT; }
+};
+
+template <>
+struct MpiElement<double> {
+    static MPI_Datatype type() { return MPI_DOUBLE; }
+};
+
+/**
+ * @brief Single-node kernel settings applied by every rank to its local blocks.
+ */
+struct LocalKernel {
+    int numThreads = 1;
+    int blockSize = 64;
+    SimdLevel simdLevel = SimdLevel::Portable;
+};
+
+/**
+ * @brief Time one rank spent computing and communicating during a multiply.
+ */
+struct PhaseTimes {
+    double compute = 0.0;
+    double comm = 0.0;
+};
+
+/**
+ * @brief Prints a formatted table header with fixed column widths.
+ * 
+ * @param headers A vector of column header title strings.
+ * @param widths A vector of column widths corresponding to each header.
+ * @param lineLength The total length of the line separator.
+ */
+void printTableHeader(const std::vector<std::string>& headers, const std::vector<int>& widths, int lineLength) {
+    for (size_t i = 0; i < headers.size(); ++i)
+        std::cout << std::left << std::setw(widths[i]) << headers[i];
+    std::cout << "\n" << std::string(lineLength, '-') << "\n";
+}
+
+/**
+ * @brief Prints a single row in a formatted table.
+ * 
+ * @param values A vector of strings representing the values in the row.
+ * @param widths vector of column widths corresponding to each value.
+ */
+void printTableRow(const std::vector<std::string>& values, const std::vector<int>& widths) {
+    for (size_t i = 0; i < values.size(); ++i)
+        std::cout << std::left << std::setw(widths[i]) << values[i];
+    std::cout << "\n";
+}
+
+/**
+ * @brief Returns the length of block `index` when `n` items are split into `parts` blocks.
+ * 
+ * The first n % parts blocks get one extra item, so lengths differ by at most one.
+ */
+int blockLength(int n, int parts, int index) {
+    return n / parts + (index < n % parts ? 1 : 0);
+}
+
+/**
+ * @brief Returns the first item of block `index` when `n` items are split into `parts` blocks.
+ */
+int blockStart(int n, int parts, int index) {
+    return index * (n / parts) + std::min(index, n % parts);
+}
+
+/**
+ * @brief Returns the block that holds item `k` when `n` items are split into `parts` blocks.
+ */
+int blockOwner(int n, int parts, int k) {
+    const int kLength = n / parts;
+    const int kBoundary = (n % parts) * (kLength + 1);   // First item of the shorter blocks
+    return (k < kBoundary) ? k / (kLength + 1) : n % parts + (k - kBoundary) / kLength;
+}
+
+/**
+ * @brief Creates a committed datatype describing a rows x cols block of a strided matrix.
+ * 
+ * Lets blocks be sent straight out of, and received straight into, padded row-major
+ * storage without packing them into a contiguous buffer first.
+ * 
+ * @param rows Number of rows in the block.
+ * @param cols Number of columns in the block.
+ * @param stride Distance in elements between consecutive rows.
+ * @return Datatype to be released with MPI_Type_free.
+ */
+template <typename T>
+MPI_Datatype makeBlockType(int rows, int cols, int stride) {
+    MPI_Datatype blockType;
+    MPI_Type_vector(rows, cols, stride, MpiElement<T>::type(), &blockType);
+    MPI_Type_commit(&blockType);
+    return blockType;
+}
+
+/**
+ * @brief 2D process grid used by SUMMA.
+ */
+struct SummaGrid {
+    MPI_Comm cart = MPI_COMM_NULL;      // Cartesian communicator over all ranks
+    MPI_Comm rowComm = MPI_COMM_NULL;   // Ranks in the same grid row, ranked by column
+    MPI_Comm colComm = MPI_COMM_NULL;   // Ranks in the same grid column, ranked by row
+    int dims[2] = {0, 0};
+    int row = 0;
+    int col = 0;
+};
+
+/**
+ * @brief Arranges the ranks of a communicator into the most square 2D grid.
+ * 
+ * Rank order is preserved so the master keeps rank 0 in the Cartesian communicator.
+ * 
+ * @param comm Communicator whose ranks form the grid.
+ * @return Grid with its row and column sub-communicators.
+ */
+SummaGrid makeSummaGrid(MPI_Comm comm) {
+    SummaGrid grid;
+    int commSize;
+    MPI_Comm_size(comm, &commSize);
+    MPI_Dims_create(commSize, 2, grid.dims);
+
+    const int kPeriods[2] = {0, 0};
+    MPI_Cart_create(comm, 2, grid.dims, kPeriods, 0, &grid.cart);
+
+    int cartRank;
+    int coords[2];
+    MPI_Comm_rank(grid.cart, &cartRank);
+    MPI_Cart_coords(grid.cart, cartRank, 2, coords);
+    grid.row = coords[0];
+    grid.col = coords[1];
+
+    const int kKeepCols[2] = {0, 1};
+    const int kKeepRows[2] = {1, 0};
+    MPI_Cart_sub(grid.cart, kKeepCols, &grid.rowComm);
+    MPI_Cart_sub(grid.cart, kKeepRows, &grid.colComm);
+    return grid;
+}
+
+/**
+ * @brief Releases the communicators of a SUMMA grid.
+ */
+void freeSummaGrid(SummaGrid& grid) {
+    MPI_Comm_free(&grid.rowComm);
+    MPI_Comm_free(&grid.colComm);
+    MPI_Comm_free(&grid.cart);
+}
+
+/**
+ * @brief Local storage of one rank for the row-block multiply.
+ * 
+ * @tparam T Element type.
+ */
+template <typename T>
+struct RowBlockBuffers {
+    Matrix<T> a;    // This rank's rows of A
+    Matrix<T> b;    // Full copy of B
+    Matrix<T> c;    // This rank's rows of C
+};
+
+/**
+ * @brief Multiplies with A and C split into row blocks and B replicated on every rank.
+ * 
+ * The master scatters contiguous row blocks of A with MPI_Scatterv and broadcasts B,
+ * each rank multiplies its rows with the OpenMP SIMD kernel, and the row blocks of C
+ * are gathered back with MPI_Gatherv. Rows keep their padded stride on every rank,
+ * so each block is a single contiguous range of the master's buffers.
+ * 
+ * @param matrix1 Full left operand (significant on the master only).
+ * @param resultMatrix Full result matrix (significant on the master only).
+ * @param buffers Local blocks; `b` must hold B on the master before the call.
+ * @param size Dimension of the square matrices (size x size).
+ * @param kernel Settings of the per-rank OpenMP kernel.
+ * @param comm Communicator of the participating ranks, with the master as rank 0.
+ * @return Compute and communication time of the calling rank.
+ */
+template <typename T>
+PhaseTimes multiplyRowBlock(const Matrix<T>& matrix1, Matrix<T>& resultMatrix, RowBlockBuffers<T>& buffers, int size,
+    const LocalKernel& kernel, MPI_Comm comm) {
+    constexpr int kMasterRank = 0;
+    PhaseTimes times;
+
+    int commSize;
+    MPI_Comm_size(comm, &commSize);
+
+    // Element counts and offsets of every rank's row block, padding included
+    const int kStride = buffers.b.stride();
+    std::vector<int> counts(commSize);
+    std::vector<int> displs(commSize);
+    for (int r = 0; r < commSize; ++r) {
+        counts[r] = blockLength(size, commSize, r) * kStride;
+        displs[r] = blockStart(size, commSize, r) * kStride;
+    }
+
+    double startTime = MPI_Wtime();
+    MPI_Scatterv(matrix1.data(), counts.data(), displs.data(), MpiElement<T>::type(),
+                 buffers.a.data(), buffers.a.rows() * kStride, MpiElement<T>::type(), kMasterRank, comm);
+    MPI_Bcast(buffers.b.data(), size * kStride, MpiElement<T>::type(), kMasterRank, comm);
+    times.comm += MPI_Wtime() - startTime;
+
+    startTime = MPI_Wtime();
+    multiplySimdViews<T>(buffers.a.view(), buffers.b.view(), buffers.c.view(), kernel.numThreads, kernel.blockSize, kernel.simdLevel);
+    times.compute += MPI_Wtime() - startTime;
+
+    startTime = MPI_Wtime();
+    MPI_Gatherv(buffers.c.data(), buffers.c.rows() * kStride, MpiElement<T>::type(),
+                resultMatrix.data(), counts.data(), displs.data(), MpiElement<T>::type(), kMasterRank, comm);
+    times.comm += MPI_Wtime() - startTime;
+
+    return times;
+}
+
+/**
+ * @brief Row-block multiply with B stored once per node in a shared-memory window.
+ * 
+ * Same decomposition as multiplyRowBlock(), but B is broadcast only between node
+ * leaders, straight into each node's shared window, and every rank multiplies out of
+ * that window. B crosses the network once per node instead of once per rank, and
+ * ranks on the same node no longer hold private copies of it.
+ * 
+ * @param matrix1 Full left operand (significant on the master only).
+ * @param matrix2 Full right operand (significant on the master only).
+ * @param resultMatrix Full result matrix (significant on the master only).
+ * @param buffers Local blocks; only `a` and `c` are used.
+ * @param sharedB Node-shared storage of B with the stride of `a`.
+ * @param size Dimension of the square matrices (size x size).
+ * @param kernel Settings of the per-rank OpenMP kernel.
+ * @param topology Node and leader communicators; the master must lead its node.
+ * @return Compute and communication time of the calling rank.
+ */
+template <typename T>
+PhaseTimes multiplyRowBlockShared(const Matrix<T>& matrix1, const Matrix<T>& matrix2, Matrix<T>& resultMatrix,
+    RowBlockBuffers<T>& buffers, NodeSharedArray<T>& sharedB, int size, const LocalKernel& kernel, const NodeTopology& topology) {
+    constexpr int kMasterRank = 0;
+    PhaseTimes times;
+
+    int worldSize, worldRank;
+    MPI_Comm_size(MPI_COMM_WORLD, &worldSize);
+    MPI_Comm_rank(MPI_COMM_WORLD, &worldRank);
+
+    const int kStride = buffers.a.stride();
+    std::vector<int> counts(worldSize);
+    std::vector<int> displs(worldSize);
+    for (int r = 0; r < worldSize; ++r) {
+        counts[r] = blockLength(size, worldSize, r) * kStride;
+        displs[r] = blockStart(size, worldSize, r) * kStride;
+    }
+
+    double startTime = MPI_Wtime();
+    MPI_Scatterv(matrix1.data(), counts.data(), displs.data(), MpiElement<T>::type(),
+                 buffers.a.data(), buffers.a.rows() * kStride, MpiElement<T>::type(), kMasterRank, MPI_COMM_WORLD);
+
+    // Nobody may still read the previous B while the leaders overwrite it
+    sharedB.sync();
+    if (topology.leaderComm != MPI_COMM_NULL) {
+        if (worldRank == kMasterRank)
+            std::copy(matrix2.data(), matrix2.data() + static_cast<size_t>(size) * kStride, sharedB.data());
+        MPI_Bcast(sharedB.data(), size * kStride, MpiElement<T>::type(), kMasterRank, topology.leaderComm);
+    }
+    sharedB.sync();
+    times.comm += MPI_Wtime() - startTime;
+
+    startTime = MPI_Wtime();
+    const MatrixView<const T> kViewB{sharedB.data(), size, size, kStride};
+    multiplySimdViews<T>(buffers.a.view(), kViewB, buffers.c.view(), kernel.numThreads, kernel.blockSize, kernel.simdLevel);
+    times.compute += MPI_Wtime() - startTime;
+
+    startTime = MPI_Wtime();
+    MPI_Gatherv(buffers.c.data(), buffers.c.rows() * kStride, MpiElement<T>::type(),
+                resultMatrix.data(), counts.data(), displs.data(), MpiElement<T>::type(), kMasterRank, MPI_COMM_WORLD);
+    times.comm += MPI_Wtime() - startTime;
+
+    return times;
+}
+
+/**
+ * @brief Local storage of one rank for the SUMMA multiply.
+ * 
+ * @tparam T Element type.
+ */
+template <typename T>
+struct SummaBuffers {
+    Matrix<T> a;        // This rank's block of A
+    Matrix<T> b;        // This rank's block of B
+    Matrix<T> c;        // This rank's block of C
+    Matrix<T> panelA;   // Column panel of A received from the owning grid column
+    Matrix<T> panelB;   // Row panel of B received from the owning grid row
+};
+
+/**
+ * @brief Multiplies with SUMMA on a 2D process grid.
+ * 
+ * A, B and C are split into the same grid of blocks (rows by grid row, columns by grid
+ * column). The shared dimension is walked in panels that never straddle a block edge:
+ * for each panel, the grid column owning it broadcasts its slice of A along each grid
+ * row, the grid row owning it broadcasts its slice of B along each grid column, and
+ * every rank accumulates the panel product into its block of C with the OpenMP SIMD
+ * kernel. Blocks travel as strided datatypes, so nothing is packed by hand.
+ * 
+ * @param matrix1 Full left operand (significant on the master only).
+ * @param matrix2 Full right operand (significant on the master only).
+ * @param resultMatrix Full result matrix (significant on the master only).
+ * @param buffers Local blocks and panel buffers of the calling rank.
+ * @param grid Process grid; its rank 0 is the master.
+ * @param size Dimension of the square matrices (size x size).
+ * @param panelWidth Maximum width of a broadcast panel.
+ * @param kernel Settings of the per-rank OpenMP kernel.
+ * @return Compute and communication time of the calling rank.
+ */
+template <typename T>
+PhaseTimes multiplySumma(const Matrix<T>& matrix1, const Matrix<T>& matrix2, Matrix<T>& resultMatrix, SummaBuffers<T>& buffers,
+    const SummaGrid& grid, int size, int panelWidth, const LocalKernel& kernel) {
+    constexpr int kMasterRank = 0;
+    PhaseTimes times;
+
+    int cartRank, cartSize;
+    MPI_Comm_rank(grid.cart, &cartRank);
+    MPI_Comm_size(grid.cart, &cartSize);
+
+    const int kGridRows = grid.dims[0];
+    const int kGridCols = grid.dims[1];
+    const int kLocalRows = buffers.c.rows();
+    const int kLocalCols = buffers.c.cols();
+
+    // Distribute the blocks of A and B
+    double startTime = MPI_Wtime();
+    std::vector<MPI_Request> requests;
+    if (cartRank == kMasterRank) {
+        for (int r = 0; r < cartSize; ++r) {
+            int coords[2];
+            MPI_Cart_coords(grid.cart, r, 2, coords);
+            const int kRow0 = blockStart(size, kGridRows, coords[0]);
+            const int kCol0 = blockStart(size, kGridCols, coords[1]);
+            MPI_Datatype blockType = makeBlockType<T>(blockLength(size, kGridRows, coords[0]),
+                                                      blockLength(size, kGridCols, coords[1]), matrix1.stride());
+
+            requests.emplace_back();
+            MPI_Isend(&matrix1(kRow0, kCol0), 1, blockType, r, kTagBlockA, grid.cart, &requests.back());
+            requests.emplace_back();
+            MPI_Isend(&matrix2(kRow0, kCol0), 1, blockType, r, kTagBlockB, grid.cart, &requests.back());
+            MPI_Type_free(&blockType);  // Released once the pending sends complete
+        }
+    }
+
+    MPI_Datatype localType = makeBlockType<T>(kLocalRows, kLocalCols, buffers.c.stride());
+    MPI_Recv(buffers.a.data(), 1, localType, kMasterRank, kTagBlockA, grid.cart, MPI_STATUS_IGNORE);
+    MPI_Recv(buffers.b.data(), 1, localType, kMasterRank, kTagBlockB, grid.cart, MPI_STATUS_IGNORE);
+    MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+    requests.clear();
+    times.comm += MPI_Wtime() - startTime;
+
+    // Walk the shared dimension one panel at a time
+    for (int k0 = 0; k0 < size; ) {
+        const int kOwnerCol = blockOwner(size, kGridCols, k0);
+        const int kOwnerRow = blockOwner(size, kGridRows, k0);
+        const int kColEnd = blockStart(size, kGridCols, kOwnerCol) + blockLength(size, kGridCols, kOwnerCol);
+        const int kRowEnd = blockStart(size, kGridRows, kOwnerRow) + blockLength(size, kGridRows, kOwnerRow);
+        const int kWidth = std::min({panelWidth, kColEnd - k0, kRowEnd - k0});
+
+        startTime = MPI_Wtime();
+
+        // Column panel of A, broadcast along the grid row
+        MatrixView<T> aPanel = buffers.panelA.view().block(0, 0, kLocalRows, kWidth);
+        if (grid.col == kOwnerCol)
+            aPanel = buffers.a.view().block(0, k0 - blockStart(size, kGridCols, kOwnerCol), kLocalRows, kWidth);
+        MPI_Datatype aPanelType = makeBlockType<T>(kLocalRows, kWidth, aPanel.stride);
+        MPI_Bcast(aPanel.data, 1, aPanelType, kOwnerCol, grid.rowComm);
+        MPI_Type_free(&aPanelType);
+
+        // Row panel of B, broadcast along the grid column
+        MatrixView<T> bPanel = buffers.panelB.view().block(0, 0, kWidth, kLocalCols);
+        if (grid.row == kOwnerRow)
+            bPanel = buffers.b.view().block(k0 - blockStart(size, kGridRows, kOwnerRow), 0, kWidth, kLocalCols);
+        MPI_Datatype bPanelType = makeBlockType<T>(kWidth, kLocalCols, bPanel.stride);
+        MPI_Bcast(bPanel.data, 1, bPanelType, kOwnerRow, grid.colComm);
+        MPI_Type_free(&bPanelType);
+
+        times.comm += MPI_Wtime() - startTime;
+
+        startTime = MPI_Wtime();
+        multiplySimdViews<T>(aPanel, bPanel, buffers.c.view(), kernel.numThreads, kernel.blockSize, kernel.simdLevel);
+        times.compute += MPI_Wtime() - startTime;
+
+        k0 += kWidth;
+    }
+
+    // Collect the blocks of C on the master
+    startTime = MPI_Wtime();
+    requests.emplace_back();
+    MPI_Isend(buffers.c.data(), 1, localType, kMasterRank, kTagBlockC, grid.cart, &requests.back());
+    if (cartRank == kMasterRank) {
+        for (int r = 0; r < cartSize; ++r) {
+            int coords[2];
+            MPI_Cart_coords(grid.cart, r, 2, coords);
+            MPI_Datatype blockType = makeBlockType<T>(blockLength(size, kGridRows, coords[0]),
+                                                      blockLength(size, kGridCols, coords[1]), resultMatrix.stride());
+            MPI_Recv(&resultMatrix(blockStart(size, kGridRows, coords[0]), blockStart(size, kGridCols, coords[1])),
+                     1, blockType, r, kTagBlockC, grid.cart, MPI_STATUS_IGNORE);
+            MPI_Type_free(&blockType);
+        }
+    }
+    MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+    MPI_Type_free(&localType);
+    times.comm += MPI_Wtime() - startTime;
+
+    return times;
+}
+
+/**
+ * @brief Benchmark parameters shared by every element type run.
+ */
+struct BenchmarkConfig {
+    std::vector<int> matrixSizes;
+    BenchmarkOptions harness;   // Warmup and adaptive repetition per layout; agree must be collective
+    int panelWidth = 0;         // Widest SUMMA panel broadcast in one step
+    int verifyRounds = 0;       // Freivalds rounds per result (0 -> verification disabled)
+    LocalKernel kernel;         // OpenMP kernel run by every rank
+};
+
+/**
+ * @brief Runs the row-block, node-shared row-block and SUMMA multiplies for one element type.
+ * 
+ * Operands are generated on the master from the same seeds as the OpenMP benchmark.
+ * Local buffers are allocated once per size and reused across runs. Each layout is
+ * repeated by the harness on the slowest rank's wall time per multiply, reported as
+ * its median next to the slowest rank's compute and communication times averaged over
+ * the timed runs; every gathered result is verified outside the timed region.
+ * 
+ * @tparam T Element type of the matrices.
+ * @param config Benchmark parameters.
+ * @param topology Node and leader communicators for the node-shared layout.
+ * @param sink Receives every measured layout on the master.
+ * @return true when every result passed verification.
+ */
+template <typename T>
+bool runDistributedBenchmark(const BenchmarkConfig& config, const NodeTopology& topology, ResultsSink& sink) {
+    constexpr int kMasterRank = 0;
+    constexpr uint64_t kSeed = 42;
+    const int kNumThreads = config.kernel.numThreads;
+
+    int worldSize, worldRank;
+    MPI_Comm_size(MPI_COMM_WORLD, &worldSize);
+    MPI_Comm_rank(MPI_COMM_WORLD, &worldRank);
+
+    SummaGrid grid = makeSummaGrid(MPI_COMM_WORLD);
+    const std::string kLayouts[] = {"Row-block", "Row-shared", "SUMMA"};
+    const std::string kGrids[] = {std::to_string(worldSize) + "x1", std::to_string(worldSize) + "x1",
+                                  std::to_string(grid.dims[0]) + "x" + std::to_string(grid.dims[1])};
+
+    const std::vector<std::string> kHeaders = {"Size", "Layout", "Grid", "Runs", "Median (s)", "CI +/-", "Compute (s)",
+                                               "Comm (s)", "Comm (%)"};
+    const std::vector<int> kWidths = {10, 12, 8, 6, 14, 9, 14, 14, 10};
+    int lineLength = 0;
+    for (int width : kWidths)
+        lineLength += width;
+
+    if (worldRank == kMasterRank) {
+        std::cout << "\n[" << ElementTraits<T>::kName << "] Distributed Matrix Multiplication - per run, "
+            << "slowest rank\n" << std::string(lineLength, '-') << "\n";
+        printTableHeader(kHeaders, kWidths, lineLength);
+    }
+
+    bool isCorrect = true;
+    for (const int kSize : config.matrixSizes) {
+        const uint64_t kSizeSeed = kSeed ^ (static_cast<uint64_t>(kSize) << 32);
+
+        // Full matrices only exist on the master
+        Matrix<T> matrix1, matrix2, resultMatrix;
+        if (worldRank == kMasterRank) {
+            matrix1 = Matrix<T>(kSize, kSize);
+            matrix2 = Matrix<T>(kSize, kSize);
+            resultMatrix = Matrix<T>(kSize, kSize);
+            initMatrix(kSizeSeed, matrix1, kSize, kSize, kNumThreads);
+            initMatrix(kSizeSeed + 1, matrix2, kSize, kSize, kNumThreads);
+        }
+
+        RowBlockBuffers<T> rowBuffers;
+        const int kLocalRows = blockLength(kSize, worldSize, worldRank);
+        rowBuffers.a = Matrix<T>(kLocalRows, kSize);
+        rowBuffers.b = (worldRank == kMasterRank) ? matrix2 : Matrix<T>(kSize, kSize);
+        rowBuffers.c = Matrix<T>(kLocalRows, kSize);
+        NodeSharedArray<T> sharedB(static_cast<size_t>(kSize) * rowBuffers.a.stride(), topology.nodeComm);
+
+        SummaBuffers<T> summaBuffers;
+        const int kBlockRows = blockLength(kSize, grid.dims[0], grid.row);
+        const int kBlockCols = blockLength(kSize, grid.dims[1], grid.col);
+        summaBuffers.a = Matrix<T>(kBlockRows, kBlockCols);
+        summaBuffers.b = Matrix<T>(kBlockRows, kBlockCols);
+        summaBuffers.c = Matrix<T>(kBlockRows, kBlockCols);
+        summaBuffers.panelA = Matrix<T>(kBlockRows, config.panelWidth);
+        summaBuffers.panelB = Matrix<T>(config.panelWidth, kBlockCols);
+
+        for (int layout = 0; layout < 3; ++layout) {
+            std::vector<PhaseTimes> slowestRuns;    // Warmup runs first, then the timed ones
+            int run = 0;
+            bool isCaseCorrect = true;
+            const BenchmarkStats kStats = runBenchmark(config.harness, [&]() {
+                rowBuffers.c.zero(kNumThreads);
+                summaBuffers.c.zero(kNumThreads);
+                if (worldRank == kMasterRank)
+                    resultMatrix.zero(kNumThreads);
+
+                MPI_Barrier(MPI_COMM_WORLD);
+                const double kStartTime = MPI_Wtime();
+                PhaseTimes times;
+                if (layout == 0)
+                    times = multiplyRowBlock<T>(matrix1, resultMatrix, rowBuffers, kSize, config.kernel, MPI_COMM_WORLD);
+                else if (layout == 1)
+                    times = multiplyRowBlockShared<T>(matrix1, matrix2, resultMatrix, rowBuffers, sharedB, kSize, config.kernel, topology);
+                else
+                    times = multiplySumma<T>(matrix1, matrix2, resultMatrix, summaBuffers, grid, kSize, config.panelWidth, config.kernel);
+                const double kElapsed = MPI_Wtime() - kStartTime;
+
+                double slowestTime = 0.0;
+                PhaseTimes maxTimes;
+                MPI_Allreduce(&kElapsed, &slowestTime, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+                MPI_Reduce(&times.compute, &maxTimes.compute, 1, MPI_DOUBLE, MPI_MAX, kMasterRank, MPI_COMM_WORLD);
+                MPI_Reduce(&times.comm, &maxTimes.comm, 1, MPI_DOUBLE, MPI_MAX, kMasterRank, MPI_COMM_WORLD);
+                slowestRuns.push_back(maxTimes);
+
+                // A wrong result fails the case on every rank, so the harness marks it failed
+                if (config.verifyRounds > 0) {
+                    if (worldRank == kMasterRank &&
+                        !verifyFreivalds(matrix1, matrix2, resultMatrix, kSize, config.verifyRounds, kSizeSeed + 2 + run, kNumThreads)) {
+                        std::cerr << "* * * Error: " << kLayouts[layout] << " result failed verification (" << ElementTraits<T>::kName
+                            << ", " << kSize << "x" << kSize << ", run " << run + 1 << ") * * *\n";
+                        isCaseCorrect = false;
+                    }
+                    MPI_Bcast(&isCaseCorrect, 1, MPI_CXX_BOOL, kMasterRank, MPI_COMM_WORLD);
+                }
+                ++run;
+                return isCaseCorrect ? slowestTime : -1.0;
+            });
+            isCorrect = isCorrect && isCaseCorrect;
+
+            if (worldRank == kMasterRank) {
+                PhaseTimes slowest;
+                for (size_t r = slowestRuns.size() - kStats.runs; r < slowestRuns.size(); ++r) {
+                    slowest.compute += slowestRuns[r].compute / kStats.runs;
+                    slowest.comm += slowestRuns[r].comm / kStats.runs;
+                }
+                const double kPhaseTotal = slowest.compute + slowest.comm;
+                std::ostringstream error;
+                error << std::fixed << std::setprecision(1) << kStats.relativeError() * 100 << "%" << (kStats.converged ? "" : "*");
+                printTableRow({std::to_string(kSize), kLayouts[layout], kGrids[layout], std::to_string(kStats.runs),
+                               std::to_string(kStats.median), kStats.failed ? "FAILED" : error.str(),
+                               std::to_string(slowest.compute), std::to_string(slowest.comm),
+                               std::to_string(kPhaseTotal > 0.0 ? 100.0 * slowest.comm / kPhaseTotal : 0.0)}, kWidths);
+
+                BenchmarkResult result;
+                result.group = ElementTraits<T>::kName;
+                result.name = kLayouts[layout];
+                result.size = kSize;
+                result.workers = worldSize;
+                result.stats = kStats;
+                sink.add(result, worldSize, kNumThreads);
+            }
+        }
+    }
+
+    freeSummaGrid(grid);
+
+    if (worldRank == kMasterRank && isCorrect && config.verifyRounds > 0)
+        std::cout << "+ + + All results verified (Freivalds, " << config.verifyRounds << " rounds per run) + + +\n";
+    return isCorrect;
+}
+
+int main(int argc, char** argv) {
+    // Console UI elements
+    constexpr int kLineLength = 50;
+    const std::string kSingleLine(kLineLength, '-');
+    const std::string kDoubleLine(kLineLength, '=');
+
+    // Initialize MPI for hybrid use: all communication happens outside the OpenMP kernels
+    HybridContext context = initHybrid(&argc, &argv, MPI_THREAD_FUNNELED);
+    const int worldSize = context.worldSize;
+    const int worldRank = context.worldRank;
+
+    // Master process configurations
+    constexpr int kMasterRank = 0;
+
+    // Program configurations
+    BenchmarkConfig config;
+    config.matrixSizes = {500, 1000};
+    config.harness.agree = masterDecision(MPI_COMM_WORLD);
+    config.panelWidth = 256;
+    config.verifyRounds = 3;
+    config.kernel.numThreads = context.numThreads;
+    config.kernel.blockSize = 64;
+    config.kernel.simdLevel = detectSimdLevel();
+
+    // Command-line options (parsed identically on every rank)
+    const std::string kUsage = "* * * Usage: mpirun -np <number_of_processes> ./<program_name> "
+        "[--type=int32|int64|float|double|all] [--sizes=LIST] [--no-verify] " + benchmarkUsage() + " " + resultsUsage() + " "
+        + optionsUsage() + " * * *\n\n";
+    std::string elementType = "int32";
+    ResultsOptions resultsOptions;
+    bool hasValidSizes = true;
+    std::vector<std::string> args;
+    std::string argError;
+    expandArguments(argc, argv, "mpi-matrix", args, argError);
+    for (size_t i = 0; i < args.size() && argError.empty(); ++i) {
+        const std::string& arg = args[i];
+        if (parseBenchmarkOption(arg, config.harness, argError) || parseResultsOption(arg, resultsOptions, argError))
+            continue;
+        if (arg.rfind("--type=", 0) == 0)
+            elementType = arg.substr(7);
+        else if (arg.rfind("--sizes=", 0) == 0)
+            hasValidSizes = parseIntList(arg.substr(8), config.matrixSizes) &&
+                *std::min_element(config.matrixSizes.begin(), config.matrixSizes.end()) >= 1;
+        else if (arg == "--no-verify")
+            config.verifyRounds = 0;
+        else
+            argError = "unknown argument '" + arg + "'";
+    }
+
+    if (argError.empty() && !hasValidSizes)
+        argError = "matrix sizes must be positive integers or ranges";
+    const bool runAll = (elementType == "all");
+    if (argError.empty() && !runAll && elementType != "int32" && elementType != "int64" && elementType != "float" && elementType != "double")
+        argError = "unsupported element type '" + elementType + "'";
+
+    if (!argError.empty()) {
+        if (worldRank == kMasterRank)
+            std::cerr << "* * * Error: " << argError << " * * *\n" << kUsage;
+        finalizeHybrid(context);
+        return 1;
+    }
+
+    if (worldRank == kMasterRank) {
+        // Display program configurations
+        std::cout << kDoubleLine << "\nMPI Distributed Matrix Multiplication\n" << kDoubleLine << std::endl;
+        std::cout << "Configuration\n" << kSingleLine << std::endl
+                << "Number of MPI processes: " << worldSize << std::endl
+                << "Element type: " << elementType << std::endl
+                << "Matrix sizes:";
+        for (int size : config.matrixSizes)
+            std::cout << " " << size;
+        std::cout << std::endl
+                << "Repetition: " << describeBenchmarkOptions(config.harness) << std::endl
+                << "SUMMA panel width: " << config.panelWidth << std::endl
+                << "Local kernel: " << simdLevelName(config.kernel.simdLevel) << ", " << config.kernel.blockSize << "x"
+                << config.kernel.blockSize << " tiles" << std::endl
+                << "Verification: " << (config.verifyRounds > 0 ? "Freivalds, " + std::to_string(config.verifyRounds) + " rounds" : "off")
+                << std::endl;
+    }
+
+    // Per-process team sizes (the master's team also generates and verifies the full matrices)
+    printHybridLayout(context);
+    NodeTopology topology = makeNodeTopology(context);
+    printTopology(context, topology);
+
+    ResultsSink sink("mpi_partd_matrix");
+    bool isCorrect = true;
+    if (isCorrect && (runAll || elementType == "int32"))
+        isCorrect = runDistributedBenchmark<int32_t>(config, topology, sink);
+    if (isCorrect && (runAll || elementType == "int64"))
+        isCorrect = runDistributedBenchmark<int64_t>(config, topology, sink);
+    if (isCorrect && (runAll || elementType == "float"))
+        isCorrect = runDistributedBenchmark<float>(config, topology, sink);
+    if (isCorrect && (runAll || elementType == "double"))
+        isCorrect = runDistributedBenchmark<double>(config, topology, sink);
+
+    // Failed cases are written too; a failed write or a regression fails every rank
+    bool isPassing = (worldRank == kMasterRank) ? reportResults(sink, resultsOptions) : true;
+    MPI_Bcast(&isPassing, 1, MPI_CXX_BOOL, kMasterRank, MPI_COMM_WORLD);
+
+    // Finalize the MPI environment
+    freeNodeTopology(topology);
+    finalizeHybrid(context);
+
+    return (isCorrect && isPassing) ? 0 : 1;
+}
\ No newline at end of file
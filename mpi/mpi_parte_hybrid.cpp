@@ -0,0 +1,366 @@
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mpi.h>
+#include <omp.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../common/benchmark.h"
+#include "../common/hybrid.h"
+#include "../common/mpibenchmark.h"
+#include "../common/options.h"
+#include "../common/results.h"
+#include "../common/topology.h"
+
+/**
+ * @brief Distributed vectors of one rank, first-touched by the team that uses them.
+ */
+struct LocalVectors {
+    int length = 0;
+    std::unique_ptr<double[]> a;
+    std::unique_ptr<double[]> b;
+    std::unique_ptr<double[]> c;
+};
+
+/**
+ * @brief Prints a formatted table header with fixed column widths.
+ * 
+ * @param headers A vector of column header title strings.
+ * @param widths A vector of column widths corresponding to each header.
+ * @param lineLength The total length of the line separator.
+ */
+void printTableHeader(const std::vector<std::string>& headers, const std::vector<int>& widths, int lineLength) {
+    for (size_t i = 0; i < headers.size(); ++i)
+        std::cout << std::left << std::setw(widths[i]) << headers[i];
+    std::cout << "\n" << std::string(lineLength, '-') << "\n";
+}
+
+/**
+ * @brief Prints a single row in a formatted table.
+ * 
+ * @param values A vector of strings representing the values in the row.
+ * @param widths vector of column widths corresponding to each value.
+ */
+void printTableRow(const std::vector<std::string>& values, const std::vector<int>& widths) {
+    for (size_t i = 0; i < values.size(); ++i)
+        std::cout << std::left << std::setw(widths[i]) << values[i];
+    std::cout << "\n";
+}
+
+/**
+ * @brief Allocates this rank's share of the vectors and initializes them in parallel.
+ * 
+ * The static schedule matches the kernels, so every page is first touched by the
+ * thread that later streams through it.
+ * 
+ * @param globalLength Length of the distributed vectors.
+ * @param worldSize Number of MPI processes.
+ * @param worldRank Rank of the calling process.
+ * @return Local vectors with b = 0.5 and c = 2.0, so b . c equals the global length.
+ */
+LocalVectors allocateVectors(long long globalLength, int worldSize, int worldRank) {
+    LocalVectors vectors;
+    vectors.length = static_cast<int>(globalLength / worldSize + (worldRank < globalLength % worldSize ? 1 : 0));
+    vectors.a.reset(new double[vectors.length]);
+    vectors.b.reset(new double[vectors.length]);
+    vectors.c.reset(new double[vectors.length]);
+
+    double* a = vectors.a.get();
+    double* b = vectors.b.get();
+    double* c = vectors.c.get();
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < vectors.length; ++i) {
+        a[i] = 0.0;
+        b[i] = 0.5;
+        c[i] = 2.0;
+    }
+    return vectors;
+}
+
+/**
+ * @brief Computes the triad a = b + scalar * c on the local elements.
+ * 
+ * Purely local, so it shows the memory bandwidth the hybrid layout reaches with no
+ * communication in the way.
+ * 
+ * @param vectors Local vectors of the calling rank.
+ * @param scalar Multiplier applied to c.
+ */
+void triad(LocalVectors& vectors, double scalar) {
+    double* a = vectors.a.get();
+    const double* b = vectors.b.get();
+    const double* c = vectors.c.get();
+
+    #pragma omp parallel for simd schedule(static)
+    for (int i = 0; i < vectors.length; ++i) {
+        a[i] = b[i] + scalar * c[i];
+    }
+}
+
+/**
+ * @brief Global dot product b . c with the MPI call funneled through the master thread.
+ * 
+ * The team reduces the local elements, then the master thread combines the partial
+ * sums of all ranks with MPI_Allreduce after the parallel region.
+ * 
+ * @param vectors Local vectors of the calling rank.
+ * @return Global dot product, identical on every rank.
+ */
+double dotFunneled(const LocalVectors& vectors) {
+    const double* b = vectors.b.get();
+    const double* c = vectors.c.get();
+
+    double localSum = 0.0;
+    #pragma omp parallel for simd schedule(static) reduction(+:localSum)
+    for (int i = 0; i < vectors.length; ++i) {
+        localSum += b[i] * c[i];
+    }
+
+    double globalSum = 0.0;
+    MPI_Allreduce(&localSum, &globalSum, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    return globalSum;
+}
+
+/**
+ * @brief Global dot product b . c with every thread calling MPI (MPI_THREAD_MULTIPLE).
+ * 
+ * The local elements are cut into the same number of chunks on every rank. Threads
+ * take chunks in order, reduce one and immediately combine it across ranks on that
+ * chunk's own communicator, so the reduction of one chunk overlaps the arithmetic of
+ * the next. Every rank enters the collectives in increasing chunk order, which keeps
+ * the scheme deadlock-free whatever the team size of each rank.
+ * 
+ * @param vectors Local vectors of the calling rank.
+ * @param chunkComms One duplicate of MPI_COMM_WORLD per chunk.
+ * @return Global dot product, identical on every rank.
+ */
+double dotMultiple(const LocalVectors& vectors, const std::vector<MPI_Comm>& chunkComms) {
+    const double* b = vectors.b.get();
+    const double* c = vectors.c.get();
+    const int kNumChunks = static_cast<int>(chunkComms.size());
+
+    double globalSum = 0.0;
+    #pragma omp parallel for schedule(dynamic, 1) reduction(+:globalSum)
+    for (int chunk = 0; chunk < kNumChunks; ++chunk) {
+        const int kBegin = static_cast<int>(static_cast<long long>(vectors.length) * chunk / kNumChunks);
+        const int kEnd = static_cast<int>(static_cast<long long>(vectors.length) * (chunk + 1) / kNumChunks);
+
+        double localSum = 0.0;
+        #pragma omp simd reduction(+:localSum)
+        for (int i = kBegin; i < kEnd; ++i) {
+            localSum += b[i] * c[i];
+        }
+
+        double chunkSum = 0.0;
+        MPI_Allreduce(&localSum, &chunkSum, 1, MPI_DOUBLE, MPI_SUM, chunkComms[chunk]);
+        globalSum += chunkSum;
+    }
+    return globalSum;
+}
+
+/**
+ * @brief Global dot product b . c reduced inside each node through shared memory.
+ * 
+ * Every rank drops its partial sum into its slot of a node-shared array, the node
+ * leader adds the slots and runs MPI_Allreduce among the leaders only, then publishes
+ * the result in the last slot. Only one value per node crosses the network.
+ * 
+ * @param vectors Local vectors of the calling rank.
+ * @param slots Node-shared array with one slot per local rank plus one for the result.
+ * @param context Placement of the calling rank.
+ * @param topology Node and leader communicators.
+ * @return Global dot product, identical on every rank.
+ */
+double dotNodeShared(const LocalVectors& vectors, NodeSharedArray<double>& slots, const HybridContext& context,
+    const NodeTopology& topology) {
+    const double* b = vectors.b.get();
+    const double* c = vectors.c.get();
+
+    double localSum = 0.0;
+    #pragma omp parallel for simd schedule(static) reduction(+:localSum)
+    for (int i = 0; i < vectors.length; ++i) {
+        localSum += b[i] * c[i];
+    }
+
+    double* slot = slots.data();
+    slot[context.localRank] = localSum;
+    slots.sync();
+
+    if (topology.leaderComm != MPI_COMM_NULL) {
+        double nodeSum = 0.0;
+        for (int r = 0; r < context.localSize; ++r)
+            nodeSum += slot[r];
+        MPI_Allreduce(&nodeSum, &slot[context.localSize], 1, MPI_DOUBLE, MPI_SUM, topology.leaderComm);
+    }
+    slots.sync();
+    return slot[context.localSize];
+}
+
+int main(int argc, char** argv) {
+    // Console UI elements
+    constexpr int kLineLength = 50;
+    const std::string kSingleLine(kLineLength, '-');
+    const std::string kDoubleLine(kLineLength, '=');
+
+    // Thread support level requested on the command line (parsed before MPI starts)
+    const std::string kUsage = "* * * Usage: mpirun -np <number_of_processes> ./<program_name> "
+        "[--thread-level=funneled|multiple] [--length=N] " + benchmarkUsage() + " " + resultsUsage() + " " + optionsUsage()
+        + " * * *\n\n";
+    int requiredLevel = MPI_THREAD_FUNNELED;
+    long long globalLength = 1LL << 24;     // 16M doubles (128 MiB) per vector across all processes
+    BenchmarkOptions harness;
+    ResultsOptions resultsOptions;
+    std::vector<std::string> args;
+    std::string argError;
+    expandArguments(argc, argv, "hybrid", args, argError);
+    for (size_t i = 0; i < args.size() && argError.empty(); ++i) {
+        const std::string& arg = args[i];
+        if (parseBenchmarkOption(arg, harness, argError) || parseResultsOption(arg, resultsOptions, argError))
+            continue;
+        if (arg == "--thread-level=funneled")
+            requiredLevel = MPI_THREAD_FUNNELED;
+        else if (arg == "--thread-level=multiple")
+            requiredLevel = MPI_THREAD_MULTIPLE;
+        else if (arg.rfind("--length=", 0) == 0)
+            globalLength = std::atoll(arg.c_str() + 9);
+        else
+            argError = "unknown argument '" + arg + "'";
+    }
+    if (argError.empty() && globalLength < 1)
+        argError = "vector length must be positive";
+
+    // Initialize MPI with the requested thread support and size the OpenMP team
+    HybridContext context = initHybrid(&argc, &argv, requiredLevel);
+    const int worldSize = context.worldSize;
+    const int worldRank = context.worldRank;
+
+    // Master process configurations
+    constexpr int kMasterRank = 0;
+
+    if (!argError.empty()) {
+        if (worldRank == kMasterRank)
+            std::cerr << "* * * Error: " << argError << " * * *\n" << kUsage;
+        finalizeHybrid(context);
+        return 1;
+    }
+
+    // Program configurations
+    const long long kGlobalLength = globalLength;
+    constexpr int kNumChunks = 16;                  // Chunks per rank for the MPI_THREAD_MULTIPLE dot product
+    constexpr double kScalar = 3.0;
+
+    if (worldRank == kMasterRank) {
+        // Display program configurations
+        std::cout << kDoubleLine << "\nHybrid MPI+OpenMP Vector Kernels\n" << kDoubleLine << std::endl;
+        std::cout << "Configuration\n" << kSingleLine << std::endl
+                << "Number of MPI processes: " << worldSize << std::endl
+                << "Vector length: " << kGlobalLength << " doubles" << std::endl
+                << "Repetition: " << describeBenchmarkOptions(harness) << std::endl;
+    }
+    printHybridLayout(context);
+    NodeTopology topology = makeNodeTopology(context);
+    printTopology(context, topology);
+
+    LocalVectors vectors = allocateVectors(kGlobalLength, worldSize, worldRank);
+
+    std::vector<MPI_Comm> chunkComms;
+    if (context.threadLevel >= MPI_THREAD_MULTIPLE) {
+        chunkComms.resize(kNumChunks);
+        for (MPI_Comm& comm : chunkComms)
+            MPI_Comm_dup(MPI_COMM_WORLD, &comm);
+    }
+
+    // Kernels compared, with the bytes each moves per element and a result check
+    struct KernelCase {
+        std::string name;
+        double bytesPerElement;
+        std::function<bool()> run;
+    };
+    std::vector<KernelCase> kernels = {
+        {"Triad", 3 * sizeof(double), [&]() {
+            triad(vectors, kScalar);
+            return vectors.length == 0 || vectors.a[vectors.length - 1] == 0.5 + kScalar * 2.0;
+        }},
+        {"Dot (funneled)", 2 * sizeof(double), [&]() {
+            return dotFunneled(vectors) == static_cast<double>(kGlobalLength);
+        }},
+    };
+    // Slot per local rank plus the node's copy of the result; released before the topology
+    auto reductionSlots = std::make_unique<NodeSharedArray<double>>(context.localSize + 1, topology.nodeComm);
+    kernels.push_back({"Dot (node-shared)", 2 * sizeof(double), [&]() {
+        return dotNodeShared(vectors, *reductionSlots, context, topology) == static_cast<double>(kGlobalLength);
+    }});
+    if (!chunkComms.empty()) {
+        kernels.push_back({"Dot (multiple)", 2 * sizeof(double), [&]() {
+            return dotMultiple(vectors, chunkComms) == static_cast<double>(kGlobalLength);
+        }});
+    }
+
+    const std::vector<std::string> kHeaders = {"Kernel", "Runs", "Median (s)", "CI +/-", "Bandwidth (GB/s)", "Check"};
+    const std::vector<int> kWidths = {20, 6, 14, 9, 20, 8};
+    int tableLength = 0;
+    for (int width : kWidths)
+        tableLength += width;
+    if (worldRank == kMasterRank) {
+        std::cout << "\nPerformance - median per run, slowest process\n" << std::string(tableLength, '-') << "\n";
+        printTableHeader(kHeaders, kWidths, tableLength);
+    }
+
+    // Every rank times the same runs; the slowest time and the joint check are shared
+    harness.agree = masterDecision(MPI_COMM_WORLD);
+    ResultsSink sink("mpi_parte_hybrid");
+    bool allCorrect = true;
+    for (const KernelCase& kernel : kernels) {
+        const BenchmarkStats kStats = runBenchmark(harness, [&]() {
+            MPI_Barrier(MPI_COMM_WORLD);
+            const double kStartTime = MPI_Wtime();
+            const int kCorrect = kernel.run() ? 1 : 0;
+            const double kElapsed = MPI_Wtime() - kStartTime;
+
+            double slowest = 0.0;
+            int allRanksCorrect = 0;
+            MPI_Allreduce(&kElapsed, &slowest, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+            MPI_Allreduce(&kCorrect, &allRanksCorrect, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+            return allRanksCorrect ? slowest : -1.0;
+        });
+        allCorrect = allCorrect && !kStats.failed;
+
+        if (worldRank == kMasterRank) {
+            std::ostringstream error;
+            error << std::fixed << std::setprecision(1) << kStats.relativeError() * 100 << "%" << (kStats.converged ? "" : "*");
+            printTableRow({kernel.name, std::to_string(kStats.runs), std::to_string(kStats.median), error.str(),
+                           std::to_string(kernel.bytesPerElement * kGlobalLength / std::max(kStats.median, 1e-9) / 1e9),
+                           kStats.failed ? "FAILED" : "ok"}, kWidths);
+
+            BenchmarkResult result;
+            result.group = "vector";
+            result.name = kernel.name;
+            result.size = kGlobalLength;
+            result.workers = worldSize;
+            result.stats = kStats;
+            sink.add(result, worldSize, context.numThreads);
+        }
+    }
+
+    if (worldRank == kMasterRank && !allCorrect)
+        std::cerr << "* * * Error: a hybrid kernel returned a wrong result * * *\n";
+
+    // A failed write or a regression fails every rank
+    bool isPassing = (worldRank == kMasterRank) ? reportResults(sink, resultsOptions) : true;
+    MPI_Bcast(&isPassing, 1, MPI_CXX_BOOL, kMasterRank, MPI_COMM_WORLD);
+
+    for (MPI_Comm& comm : chunkComms)
+        MPI_Comm_free(&comm);
+    reductionSlots.reset();
+    freeNodeTopology(topology);
+
+    // Finalize the MPI environment
+    finalizeHybrid(context);
+
+    return (allCorrect && isPassing) ? 0 : 1;
+}
\ No newline at end of file
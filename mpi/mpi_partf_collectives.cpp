@@ -0,0 +1,461 @@
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <mpi.h>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../common/benchmark.h"
+#include "../common/message.h"
+#include "../common/mpibenchmark.h"
+#include "../common/options.h"
+#include "../common/results.h"
+
+// Slot size of the fixed-length MPI_Gather variant
+constexpr int kMaxMessageLength = 100;
+constexpr int kMasterRank = 0;
+constexpr int kExchangeTag = 0;
+
+/**
+ * @brief One way of performing an exchange, timed against the others of its group.
+ */
+struct ExchangeVariant {
+    std::string name;
+    std::string group;                              // Replies, greetings or rank sum
+    std::function<bool(MPI_Comm)> exchange;         // Runs one exchange, true if this rank saw the right result
+};
+
+/**
+ * @brief Prints a formatted table header with fixed column widths.
+ * 
+ * @param headers A vector of column header title strings.
+ * @param widths A vector of column widths corresponding to each header.
+ * @param lineLength The total length of the line separator.
+ */
+void printTableHeader(const std::vector<std::string>& headers, const std::vector<int>& widths, int lineLength) {
+    for (size_t i = 0; i < headers.size(); ++i)
+        std::cout << std::left << std::setw(widths[i]) << headers[i];
+    std::cout << "\n" << std::string(lineLength, '-') << "\n";
+}
+
+/**
+ * @brief Prints a single row in a formatted table.
+ * 
+ * @param values A vector of strings representing the values in the row.
+ * @param widths vector of column widths corresponding to each value.
+ */
+void printTableRow(const std::vector<std::string>& values, const std::vector<int>& widths) {
+    for (size_t i = 0; i < values.size(); ++i)
+        std::cout << std::left << std::setw(widths[i]) << values[i];
+    std::cout << "\n";
+}
+
+/**
+ * @brief Returns the name the slaves programs give a rank.
+ */
+std::string slaveName(int rank) {
+    switch (rank) {
+        case 1: return "John";
+        case 2: return "Mary";
+        case 3: return "Susan";
+        default: return "unnamed process";
+    }
+}
+
+/**
+ * @brief Reply a slave sends to the master (mpi_partb_slaves2.cpp).
+ */
+std::string replyFor(int rank) {
+    return "Hello, I am " + slaveName(rank);
+}
+
+/**
+ * @brief Personalised message the master sends to a slave (mpi_partc_tag.cpp).
+ */
+std::string greetingFor(int rank) {
+    return "Hello, " + slaveName(rank);
+}
+
+/**
+ * @brief Checks the replies collected on the master against the expected strings.
+ * 
+ * @param replies Reply received from each rank, indexed by rank (rank 0 unused).
+ * @return true when every slave's reply is intact.
+ */
+bool checkReplies(const std::vector<std::string>& replies) {
+    for (size_t rank = 1; rank < replies.size(); ++rank) {
+        if (replies[rank] != replyFor(static_cast<int>(rank)))
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Collects the slaves' replies with the original MPI_ANY_SOURCE receive loop.
+ * 
+ * The root handles P - 1 messages one after another, so its cost grows linearly with P.
+ * 
+ * @param comm Communicator with the master as rank 0.
+ * @return true when the exchange delivered the expected replies.
+ */
+bool replyRecvLoop(MPI_Comm comm) {
+    int commSize, commRank;
+    MPI_Comm_size(comm, &commSize);
+    MPI_Comm_rank(comm, &commRank);
+
+    if (commRank != kMasterRank) {
+        sendString(replyFor(commRank), kMasterRank, kExchangeTag, comm);
+        return true;
+    }
+
+    std::vector<std::string> replies(commSize);
+    MessagePool<char> pool;
+    for (int i = 1; i < commSize; ++i) {
+        MPI_Status status;
+        const int kLength = pool.receive(MPI_ANY_SOURCE, kExchangeTag, comm, &status);
+        replies[status.MPI_SOURCE].assign(pool.data(), kLength);
+    }
+    return checkReplies(replies);
+}
+
+/**
+ * @brief Collects the replies with MPI_Gather into fixed-size, zero-padded slots.
+ * 
+ * @param comm Communicator with the master as rank 0.
+ * @return true when the exchange delivered the expected replies.
+ */
+bool replyGather(MPI_Comm comm) {
+    int commSize, commRank;
+    MPI_Comm_size(comm, &commSize);
+    MPI_Comm_rank(comm, &commRank);
+
+    char sendBuffer[kMaxMessageLength] = {};
+    if (commRank != kMasterRank)
+        std::strncpy(sendBuffer, replyFor(commRank).c_str(), kMaxMessageLength - 1);
+
+    std::vector<char> slots(commRank == kMasterRank ? static_cast<size_t>(kMaxMessageLength) * commSize : 0);
+    MPI_Gather(sendBuffer, kMaxMessageLength, MPI_CHAR, slots.data(), kMaxMessageLength, MPI_CHAR, kMasterRank, comm);
+
+    if (commRank != kMasterRank)
+        return true;
+
+    std::vector<std::string> replies(commSize);
+    for (int rank = 1; rank < commSize; ++rank)
+        replies[rank] = slots.data() + static_cast<size_t>(rank) * kMaxMessageLength;
+    return checkReplies(replies);
+}
+
+/**
+ * @brief Collects the replies with MPI_Gatherv, moving only each reply's own bytes.
+ * 
+ * The lengths are gathered first so the root can lay the replies out back to back.
+ * 
+ * @param comm Communicator with the master as rank 0.
+ * @return true when the exchange delivered the expected replies.
+ */
+bool replyGatherv(MPI_Comm comm) {
+    int commSize, commRank;
+    MPI_Comm_size(comm, &commSize);
+    MPI_Comm_rank(comm, &commRank);
+
+    const std::string kReply = (commRank == kMasterRank) ? std::string() : replyFor(commRank);
+    const int kLength = static_cast<int>(kReply.size());
+
+    std::vector<int> lengths(commRank == kMasterRank ? commSize : 0);
+    MPI_Gather(&kLength, 1, MPI_INT, lengths.data(), 1, MPI_INT, kMasterRank, comm);
+
+    std::vector<int> displs;
+    std::vector<char> packed;
+    if (commRank == kMasterRank) {
+        displs.resize(commSize);
+        int offset = 0;
+        for (int rank = 0; rank < commSize; ++rank) {
+            displs[rank] = offset;
+            offset += lengths[rank];
+        }
+        packed.resize(offset);
+    }
+    MPI_Gatherv(kReply.data(), kLength, MPI_CHAR, packed.data(), lengths.data(), displs.data(), MPI_CHAR, kMasterRank, comm);
+
+    if (commRank != kMasterRank)
+        return true;
+
+    std::vector<std::string> replies(commSize);
+    for (int rank = 1; rank < commSize; ++rank)
+        replies[rank].assign(packed.data() + displs[rank], lengths[rank]);
+    return checkReplies(replies);
+}
+
+/**
+ * @brief Sends each slave its personalised message with the original MPI_Send loop.
+ * 
+ * @param comm Communicator with the master as rank 0.
+ * @return true on the slaves when their message arrived intact.
+ */
+bool greetSendLoop(MPI_Comm comm) {
+    int commSize, commRank;
+    MPI_Comm_size(comm, &commSize);
+    MPI_Comm_rank(comm, &commRank);
+
+    if (commRank == kMasterRank) {
+        for (int destRank = 1; destRank < commSize; ++destRank)
+            sendString(greetingFor(destRank), destRank, kExchangeTag, comm);
+        return true;
+    }
+
+    return greetingFor(commRank) == recvString(kMasterRank, kExchangeTag, comm);
+}
+
+/**
+ * @brief Sends each slave its personalised message with one MPI_Scatterv.
+ * 
+ * The master packs the messages back to back; each slave first learns its length
+ * from an MPI_Scatter of the counts.
+ * 
+ * @param comm Communicator with the master as rank 0.
+ * @return true on the slaves when their message arrived intact.
+ */
+bool greetScatterv(MPI_Comm comm) {
+    int commSize, commRank;
+    MPI_Comm_size(comm, &commSize);
+    MPI_Comm_rank(comm, &commRank);
+
+    std::vector<int> lengths;
+    std::vector<int> displs;
+    std::string packed;
+    if (commRank == kMasterRank) {
+        lengths.resize(commSize);
+        displs.resize(commSize);
+        for (int rank = 0; rank < commSize; ++rank) {
+            const std::string kMessage = (rank == kMasterRank) ? std::string() : greetingFor(rank);
+            displs[rank] = static_cast<int>(packed.size());
+            lengths[rank] = static_cast<int>(kMessage.size());
+            packed += kMessage;
+        }
+    }
+
+    int length = 0;
+    MPI_Scatter(lengths.data(), 1, MPI_INT, &length, 1, MPI_INT, kMasterRank, comm);
+
+    std::string message(length, '\0');
+    MPI_Scatterv(packed.data(), lengths.data(), displs.data(), MPI_CHAR, &message[0], length, MPI_CHAR, kMasterRank, comm);
+
+    return commRank == kMasterRank || message == greetingFor(commRank);
+}
+
+/**
+ * @brief Sums the slaves' ranks on the master with the receive loop of mpi_partb_slaves1.cpp.
+ * 
+ * @param comm Communicator with the master as rank 0.
+ * @return true on the master when the sum is correct.
+ */
+bool rankRecvLoop(MPI_Comm comm) {
+    int commSize, commRank;
+    MPI_Comm_size(comm, &commSize);
+    MPI_Comm_rank(comm, &commRank);
+
+    if (commRank != kMasterRank) {
+        MPI_Send(&commRank, 1, MPI_INT, kMasterRank, kExchangeTag, comm);
+        return true;
+    }
+
+    long long sum = 0;
+    for (int i = 1; i < commSize; ++i) {
+        int receivedRank;
+        MPI_Recv(&receivedRank, 1, MPI_INT, MPI_ANY_SOURCE, kExchangeTag, comm, MPI_STATUS_IGNORE);
+        sum += receivedRank;
+    }
+    return sum == static_cast<long long>(commSize) * (commSize - 1) / 2;
+}
+
+/**
+ * @brief Sums the ranks on the master with MPI_Reduce.
+ * 
+ * @param comm Communicator with the master as rank 0.
+ * @return true on the master when the sum is correct.
+ */
+bool rankReduce(MPI_Comm comm) {
+    int commSize, commRank;
+    MPI_Comm_size(comm, &commSize);
+    MPI_Comm_rank(comm, &commRank);
+
+    const long long kRank = commRank;
+    long long sum = 0;
+    MPI_Reduce(&kRank, &sum, 1, MPI_LONG_LONG, MPI_SUM, kMasterRank, comm);
+    return commRank != kMasterRank || sum == static_cast<long long>(commSize) * (commSize - 1) / 2;
+}
+
+/**
+ * @brief Measures one exchange variant on a communicator.
+ * 
+ * Each run checks one exchange on every rank, then repeats it `batch` times back to
+ * back; its time is the slowest rank's average per exchange. A wrong result on any
+ * rank fails the case.
+ * 
+ * @param comm Communicator with the master as rank 0.
+ * @param exchange The exchange variant to time.
+ * @param harness Warmup, repetition and precision settings.
+ * @param batch Exchanges per timed run.
+ * @return Statistics of the seconds per exchange, the same on every rank.
+ */
+BenchmarkStats timeExchange(MPI_Comm comm, const std::function<bool(MPI_Comm)>& exchange, const BenchmarkOptions& harness, int batch) {
+    return runBenchmark(collectiveOptions(harness, comm), [&]() {
+        const bool kLocalCorrect = exchange(comm);
+
+        MPI_Barrier(comm);
+        const double kStartTime = MPI_Wtime();
+        for (int i = 0; i < batch; ++i)
+            exchange(comm);
+        return slowestRun((MPI_Wtime() - kStartTime) / batch, kLocalCorrect, comm);
+    });
+}
+
+/**
+ * @brief Formats a table cell: median and 95% CI half-width in microseconds, '*' if the
+ *        case did not converge and FAILED if it failed.
+ */
+std::string formatCell(const BenchmarkStats& stats) {
+    if (stats.failed)
+        return "FAILED";
+    std::ostringstream cell;
+    cell << std::fixed << std::setprecision(2) << stats.median * 1e6 << " +/-" << std::setprecision(0)
+         << stats.relativeError() * 100 << "%" << (stats.converged ? "" : "*");
+    return cell.str();
+}
+
+int main(int argc, char** argv) {
+    // Console UI elements
+    constexpr int kLineLength = 50;
+    const std::string kSingleLine(kLineLength, '-');
+    const std::string kDoubleLine(kLineLength, '=');
+
+    // Initialize the MPI environment
+    MPI_Init(&argc, &argv);
+
+    // Get total number of processes and current process rank
+    int worldSize, worldRank;
+    MPI_Comm_size(MPI_COMM_WORLD, &worldSize);
+    MPI_Comm_rank(MPI_COMM_WORLD, &worldRank);
+
+    // Command-line options
+    const std::string kUsage = "* * * Usage: mpirun -np <number_of_processes> ./<program_name> [--batch=N] "
+        + benchmarkUsage() + " " + resultsUsage() + " " + optionsUsage() + " * * *\n\n";
+    BenchmarkOptions harness;
+    int batch = 100;                // Exchanges per timed run, so one run outlasts the timer resolution
+    ResultsOptions resultsOptions;
+    std::vector<std::string> args;
+    std::string argError;
+    expandArguments(argc, argv, "collectives", args, argError);
+    for (size_t i = 0; i < args.size() && argError.empty(); ++i) {
+        const std::string& arg = args[i];
+        if (parseBenchmarkOption(arg, harness, argError) || parseResultsOption(arg, resultsOptions, argError))
+            continue;
+        if (arg.rfind("--batch=", 0) == 0) {
+            batch = std::atoi(arg.c_str() + 8);
+            if (batch < 1)
+                argError = "batch must be positive";
+        } else {
+            argError = "unknown argument '" + arg + "'";
+        }
+    }
+    if (!argError.empty()) {
+        if (worldRank == kMasterRank)
+            std::cerr << "* * * Error: " << argError << " * * *\n" << kUsage;
+        MPI_Finalize();
+        return 1;
+    }
+
+    // Enforce that this program must run with at least 2 processes (1 master + 1 slave)
+    if (worldRank == kMasterRank && worldSize < 2) {
+        std::cerr << "* * * Error: this program must be run with at least processes * * *\n";
+        std::cerr << kUsage;
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+
+    // Benchmark configurations
+    const std::vector<ExchangeVariant> kVariants = {
+        {"Recv loop", "replies", replyRecvLoop}, {"Gather", "replies", replyGather}, {"Gatherv", "replies", replyGatherv},
+        {"Send loop", "greetings", greetSendLoop}, {"Scatterv", "greetings", greetScatterv},
+        {"Rank loop", "rank-sum", rankRecvLoop}, {"Reduce", "rank-sum", rankReduce},
+    };
+    std::vector<std::string> headers = {"Processes"};
+    std::vector<int> widths = {12};
+    for (const ExchangeVariant& variant : kVariants) {
+        headers.push_back(variant.name);
+        widths.push_back(17);
+    }
+    const int kTableLength = 12 + 17 * static_cast<int>(kVariants.size());
+
+    // Process counts: powers of two, then the full world
+    std::vector<int> processCounts;
+    for (int count = 2; count < worldSize; count *= 2)
+        processCounts.push_back(count);
+    processCounts.push_back(worldSize);
+
+    if (worldRank == kMasterRank) {
+        const unsigned int numCores = std::thread::hardware_concurrency();
+
+        // Display program configurations
+        std::cout << kDoubleLine << "\nMPI Collectives vs Point-to-Point\n" << kDoubleLine << std::endl;
+        std::cout << "Configuration\n" << kSingleLine << std::endl
+                << "Number of cores: " << numCores << std::endl
+                << "Number of MPI processes: " << worldSize << std::endl
+                << "Exchanges per run: " << batch << std::endl
+                << "Repetition: " << describeBenchmarkOptions(harness) << std::endl
+                << "Replies (slaves -> master): Recv loop, Gather, Gatherv" << std::endl
+                << "Greetings (master -> slaves): Send loop, Scatterv" << std::endl
+                << "Rank sum (slaves -> master): Rank loop, Reduce" << std::endl;
+
+        std::cout << "\n[1] Median Time per Exchange in Microseconds and 95% CI (slowest process)\n" << std::string(kTableLength, '-') << std::endl;
+        printTableHeader(headers, widths, kTableLength);
+    }
+
+    ResultsSink sink("mpi_partf_collectives");
+    bool isCorrect = true;
+    for (const int kProcesses : processCounts) {
+        MPI_Comm exchangeComm;
+        MPI_Comm_split(MPI_COMM_WORLD, worldRank < kProcesses ? 0 : MPI_UNDEFINED, worldRank, &exchangeComm);
+
+        if (exchangeComm != MPI_COMM_NULL) {
+            std::vector<std::string> row = {std::to_string(kProcesses)};
+            for (const ExchangeVariant& variant : kVariants) {
+                const BenchmarkStats kStats = timeExchange(exchangeComm, variant.exchange, harness, batch);
+                isCorrect = isCorrect && !kStats.failed;
+                row.push_back(formatCell(kStats));
+
+                BenchmarkResult result;
+                result.group = variant.group;
+                result.name = variant.name;
+                result.workers = kProcesses;
+                result.stats = kStats;
+                sink.add(result, worldSize, 1);
+            }
+
+            if (worldRank == kMasterRank)
+                printTableRow(row, widths);
+            MPI_Comm_free(&exchangeComm);
+        }
+        MPI_Barrier(MPI_COMM_WORLD);
+    }
+
+    if (worldRank == kMasterRank) {
+        std::cout << "* = did not reach the target precision, FAILED = wrong message" << std::endl;
+        if (isCorrect)
+            std::cout << "\n+ + + Every variant delivered the expected messages + + +\n";
+        else
+            std::cerr << "\n* * * Error: a variant delivered a wrong message * * *\n";
+    }
+
+    // A failed write or a regression fails every rank
+    bool isPassing = (worldRank == kMasterRank) ? reportResults(sink, resultsOptions) : true;
+    MPI_Bcast(&isPassing, 1, MPI_CXX_BOOL, kMasterRank, MPI_COMM_WORLD);
+
+    // Finalize the MPI environment
+    MPI_Finalize();
+
+    return (isCorrect && isPassing) ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,577 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mpi.h>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../common/benchmark.h"
+#include "../common/mpibenchmark.h"
+#include "../common/options.h"
+#include "../common/results.h"
+
+constexpr int kMasterRank = 0;
+constexpr int kPingTag = 0;
+constexpr int kAckTag = 1;
+
+// Unmeasured round trips per size before a pair's first case: connection setup, first touch
+constexpr int kPairWarmupRounds = 4;
+
+// Receive area of a streamed window; large messages stream with fewer in flight
+constexpr size_t kMaxWindowBytes = size_t(64) << 20;
+
+/**
+ * @brief How a message is handed to MPI.
+ */
+enum class SendMode { Blocking, NonBlocking, Synchronous, Buffered };
+
+/**
+ * @brief Where the Send/Ssend latency ratio steps up, i.e. where the eager protocol ends.
+ */
+struct EagerStep {
+    size_t lastEager = 0;           // Index of the last size before the step
+    double eagerRatio = 0.0;        // Median Send/Ssend ratio up to and including lastEager
+    double rendezvousRatio = 0.0;   // Median ratio of the sizes after the step
+
+    /**
+     * @brief Height of the step in Send/Ssend ratio.
+     */
+    double rise() const { return rendezvousRatio - eagerRatio; }
+};
+
+/**
+ * @brief A pair of ranks to benchmark: the master and one partner.
+ */
+struct PairCase {
+    int partner;                // World rank paired with the master, -1 for none
+    std::string group;          // Results group of the pair's cases
+    std::string title;          // Heading of the pair's section
+};
+
+/**
+ * @brief Prints a formatted table header with fixed column widths.
+ * 
+ * @param headers A vector of column header title strings.
+ * @param widths A vector of column widths corresponding to each header.
+ * @param lineLength The total length of the line separator.
+ */
+void printTableHeader(const std::vector<std::string>& headers, const std::vector<int>& widths, int lineLength) {
+    for (size_t i = 0; i < headers.size(); ++i)
+        std::cout << std::left << std::setw(widths[i]) << headers[i];
+    std::cout << "\n" << std::string(lineLength, '-') << "\n";
+}
+
+/**
+ * @brief Prints a single row in a formatted table.
+ * 
+ * @param values A vector of strings representing the values in the row.
+ * @param widths vector of column widths corresponding to each value.
+ */
+void printTableRow(const std::vector<std::string>& values, const std::vector<int>& widths) {
+    for (size_t i = 0; i < values.size(); ++i)
+        std::cout << std::left << std::setw(widths[i]) << values[i];
+    std::cout << "\n";
+}
+
+/**
+ * @brief Returns the display name of a send mode.
+ */
+std::string sendModeName(SendMode mode) {
+    switch (mode) {
+        case SendMode::Blocking: return "MPI_Send";
+        case SendMode::NonBlocking: return "MPI_Isend";
+        case SendMode::Synchronous: return "MPI_Ssend";
+        case SendMode::Buffered: return "MPI_Bsend";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Formats a byte count with the largest binary unit (B, KiB, MiB) that divides it.
+ */
+std::string formatBytes(size_t bytes) {
+    if (bytes >= (size_t(1) << 20) && bytes % (size_t(1) << 20) == 0)
+        return std::to_string(bytes >> 20) + " MiB";
+    if (bytes >= (size_t(1) << 10) && bytes % (size_t(1) << 10) == 0)
+        return std::to_string(bytes >> 10) + " KiB";
+    return std::to_string(bytes) + " B";
+}
+
+/**
+ * @brief Formats a value with a fixed number of decimals.
+ */
+std::string formatFixed(double value, int precision) {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(precision) << value;
+    return out.str();
+}
+
+/**
+ * @brief Formats a case's 95% CI half-width as a percentage of its mean, '*' if it did not converge.
+ */
+std::string formatError(const BenchmarkStats& stats) {
+    return formatFixed(stats.relativeError() * 100, 1) + "%" + (stats.converged ? "" : "*");
+}
+
+/**
+ * @brief Median of values[begin, end).
+ */
+double medianOf(const std::vector<double>& values, size_t begin, size_t end) {
+    std::vector<double> segment(values.begin() + begin, values.begin() + end);
+    const size_t kMiddle = segment.size() / 2;
+    std::nth_element(segment.begin(), segment.begin() + kMiddle, segment.end());
+    const double kUpper = segment[kMiddle];
+    if (segment.size() % 2 == 1)
+        return kUpper;
+    return (*std::max_element(segment.begin(), segment.begin() + kMiddle) + kUpper) / 2.0;
+}
+
+/**
+ * @brief Fits a single upward step to the Send/Ssend ratios of increasing message sizes.
+ * 
+ * Tries every split into a leading and a trailing run of sizes whose median rises and
+ * keeps the one whose two segment medians leave the smallest absolute residual. An
+ * outlier such as a cold first size shifts a segment median by at most one rank, so it
+ * cannot claim the split the way it would in a least-squares fit.
+ * 
+ * @param ratios Send/Ssend median ratio per size, at least two entries.
+ * @return Best split; its rise is 0 when no split rises.
+ */
+EagerStep fitEagerStep(const std::vector<double>& ratios) {
+    auto residual = [&](size_t begin, size_t end, double median) {
+        double sum = 0.0;
+        for (size_t i = begin; i < end; ++i)
+            sum += std::abs(ratios[i] - median);
+        return sum;
+    };
+
+    // No rising split: one flat segment over all sizes
+    EagerStep best;
+    best.lastEager = ratios.size() - 1;
+    best.eagerRatio = best.rendezvousRatio = medianOf(ratios, 0, ratios.size());
+    double bestResidual = -1.0;
+    for (size_t split = 1; split < ratios.size(); ++split) {
+        EagerStep step;
+        step.lastEager = split - 1;
+        step.eagerRatio = medianOf(ratios, 0, split);
+        step.rendezvousRatio = medianOf(ratios, split, ratios.size());
+        if (step.rendezvousRatio <= step.eagerRatio)
+            continue;
+        const double kResidual = residual(0, split, step.eagerRatio) + residual(split, ratios.size(), step.rendezvousRatio);
+        if (bestResidual < 0.0 || kResidual < bestResidual) {
+            best = step;
+            bestResidual = kResidual;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Sends one message with a blocking-style send of the given mode.
+ */
+void sendBlocking(SendMode mode, const char* data, int bytes, int dest, MPI_Comm comm) {
+    switch (mode) {
+        case SendMode::Synchronous:
+            MPI_Ssend(data, bytes, MPI_CHAR, dest, kPingTag, comm);
+            break;
+        case SendMode::Buffered:
+            MPI_Bsend(data, bytes, MPI_CHAR, dest, kPingTag, comm);
+            break;
+        default:
+            MPI_Send(data, bytes, MPI_CHAR, dest, kPingTag, comm);
+            break;
+    }
+}
+
+/**
+ * @brief Runs one ping-pong round trip between the two ranks of a pair.
+ * 
+ * The initiator (pair rank 0) sends and waits for the echo; the partner receives and
+ * echoes the message back with the same mode. In non-blocking mode the initiator
+ * pre-posts the receive for the echo before it sends.
+ * 
+ * @param pairComm Communicator of exactly two ranks.
+ * @param mode Send mode used in both directions.
+ * @param sendBuffer Outgoing payload.
+ * @param recvBuffer Incoming payload.
+ * @param bytes Message size.
+ * @return Half the round-trip time in seconds on the initiator, 0 on the partner.
+ */
+double pingPongRound(MPI_Comm pairComm, SendMode mode, const char* sendBuffer, char* recvBuffer, int bytes) {
+    int pairRank;
+    MPI_Comm_rank(pairComm, &pairRank);
+    const int kPeer = 1 - pairRank;
+
+    if (pairRank == 0) {
+        const double kStart = MPI_Wtime();
+        if (mode == SendMode::NonBlocking) {
+            MPI_Request requests[2];
+            MPI_Irecv(recvBuffer, bytes, MPI_CHAR, kPeer, kPingTag, pairComm, &requests[0]);
+            MPI_Isend(sendBuffer, bytes, MPI_CHAR, kPeer, kPingTag, pairComm, &requests[1]);
+            MPI_Waitall(2, requests, MPI_STATUSES_IGNORE);
+        } else {
+            sendBlocking(mode, sendBuffer, bytes, kPeer, pairComm);
+            MPI_Recv(recvBuffer, bytes, MPI_CHAR, kPeer, kPingTag, pairComm, MPI_STATUS_IGNORE);
+        }
+        return (MPI_Wtime() - kStart) / 2.0;
+    }
+
+    if (mode == SendMode::NonBlocking) {
+        MPI_Request request;
+        MPI_Irecv(recvBuffer, bytes, MPI_CHAR, kPeer, kPingTag, pairComm, &request);
+        MPI_Wait(&request, MPI_STATUS_IGNORE);
+        MPI_Isend(recvBuffer, bytes, MPI_CHAR, kPeer, kPingTag, pairComm, &request);
+        MPI_Wait(&request, MPI_STATUS_IGNORE);
+    } else {
+        MPI_Recv(recvBuffer, bytes, MPI_CHAR, kPeer, kPingTag, pairComm, MPI_STATUS_IGNORE);
+        sendBlocking(mode, recvBuffer, bytes, kPeer, pairComm);
+    }
+    return 0.0;
+}
+
+/**
+ * @brief Number of messages in flight per streamed window of a message size.
+ */
+int streamWindowFor(int bytes, int window) {
+    return static_cast<int>(std::clamp<size_t>(kMaxWindowBytes / bytes, 1, window));
+}
+
+/**
+ * @brief Streams one window of messages in flight from the initiator to the partner.
+ * 
+ * The initiator posts up to `window` non-blocking sends (fewer for large sizes so the
+ * window stays within kMaxWindowBytes, or one message if that is larger), the partner
+ * receives each into its own slice and acknowledges the window with an empty message.
+ * 
+ * @param pairComm Communicator of exactly two ranks.
+ * @param sendBuffer Outgoing payload, shared by every send of a window.
+ * @param recvBuffer Receive area of a whole window.
+ * @param bytes Message size.
+ * @param window Messages in flight at most.
+ * @return Seconds until the acknowledgement on the initiator, 0 on the partner.
+ */
+double streamWindow(MPI_Comm pairComm, const char* sendBuffer, char* recvBuffer, int bytes, int window) {
+    int pairRank;
+    MPI_Comm_rank(pairComm, &pairRank);
+    const int kPeer = 1 - pairRank;
+    const int kWindow = streamWindowFor(bytes, window);
+    std::vector<MPI_Request> requests(kWindow);
+
+    if (pairRank == 0) {
+        const double kStart = MPI_Wtime();
+        for (int i = 0; i < kWindow; ++i)
+            MPI_Isend(sendBuffer, bytes, MPI_CHAR, kPeer, kPingTag, pairComm, &requests[i]);
+        MPI_Waitall(kWindow, requests.data(), MPI_STATUSES_IGNORE);
+        MPI_Recv(nullptr, 0, MPI_CHAR, kPeer, kAckTag, pairComm, MPI_STATUS_IGNORE);
+        return MPI_Wtime() - kStart;
+    }
+
+    for (int i = 0; i < kWindow; ++i)
+        MPI_Irecv(recvBuffer + static_cast<size_t>(i) * bytes, bytes, MPI_CHAR, kPeer, kPingTag, pairComm, &requests[i]);
+    MPI_Waitall(kWindow, requests.data(), MPI_STATUSES_IGNORE);
+    MPI_Send(nullptr, 0, MPI_CHAR, kPeer, kAckTag, pairComm);
+    return 0.0;
+}
+
+/**
+ * @brief Adds one case of a pair to the results, with its bandwidth at the median.
+ */
+void addPairResult(ResultsSink& sink, const std::string& group, const std::string& name, size_t bytes,
+                   const BenchmarkStats& stats, double gigabytesPerSecond) {
+    int worldSize;
+    MPI_Comm_size(MPI_COMM_WORLD, &worldSize);
+
+    BenchmarkResult result;
+    result.group = group;
+    result.name = name;
+    result.size = static_cast<long long>(bytes);
+    result.workers = 2;
+    result.stats = stats;
+    result.metrics = {{"gb_per_s", gigabytesPerSecond}};
+    sink.add(result, worldSize, 1);
+}
+
+/**
+ * @brief Runs every benchmark on one pair of ranks and prints the tables on the initiator.
+ * 
+ * Every size of every mode is a case of the shared harness, one round trip per run;
+ * both ranks follow the initiator's stop decision. One table per send mode with the
+ * latency statistics and the bandwidth at the median, then a summary comparing the
+ * modes' medians and the streamed bandwidth. Below the
+ * eager limit MPI_Send returns once the message is buffered while MPI_Ssend waits for
+ * the matching receive, so the Send/Ssend ratio steps up towards 1 where the library
+ * switches to the rendezvous protocol; fitEagerStep() locates that step. A few unmeasured
+ * round trips per size come first so no case pays for the pair's cold start.
+ * 
+ * @param pairComm Communicator of exactly two ranks; pair rank 0 prints.
+ * @param title Heading of the pair's section.
+ * @param sizes Message sizes in bytes, increasing.
+ * @param window Messages in flight during the streaming test.
+ * @param harness Warmup, repetition and precision settings.
+ * @param group Results group of the pair's cases, e.g. "intra-node".
+ * @param sink Receives every case on the initiator.
+ */
+void runPair(MPI_Comm pairComm, const std::string& title, const std::vector<size_t>& sizes, int window,
+             const BenchmarkOptions& harness, const std::string& group, ResultsSink& sink) {
+    int pairRank;
+    MPI_Comm_rank(pairComm, &pairRank);
+    const bool kPrints = (pairRank == 0);
+    const BenchmarkOptions kSharedHarness = collectiveOptions(harness, pairComm);
+
+    // Sized for the largest message, and the receive side for the largest streamed window
+    const size_t kMaxBytes = sizes.back();
+    size_t maxWindowBytes = kMaxBytes;
+    for (const size_t kBytes : sizes)
+        maxWindowBytes = std::max(maxWindowBytes, kBytes * streamWindowFor(static_cast<int>(kBytes), window));
+    std::vector<char> sendBuffer(kMaxBytes, 'x');
+    std::vector<char> recvBuffer(maxWindowBytes);
+
+    // MPI_Bsend copies into a user-attached buffer; one message in flight at a time
+    std::vector<char> bsendBuffer(kMaxBytes + MPI_BSEND_OVERHEAD);
+    MPI_Buffer_attach(bsendBuffer.data(), static_cast<int>(bsendBuffer.size()));
+
+    const std::vector<SendMode> kModes = {SendMode::Blocking, SendMode::NonBlocking, SendMode::Synchronous, SendMode::Buffered};
+    const std::vector<std::string> kHeaders = {"Size", "Runs", "Min (us)", "Median (us)", "p95 (us)", "CI +/-", "GB/s"};
+    const std::vector<int> kWidths = {10, 8, 12, 13, 12, 9, 10};
+    const int kTableLength = 76;
+
+    // medians[mode][size]
+    std::vector<std::vector<double>> medians(kModes.size(), std::vector<double>(sizes.size()));
+
+    if (kPrints)
+        std::cout << "\n" << title << "\n" << std::string(kTableLength, '=') << std::endl;
+
+    // The first measured case would otherwise pay for the pair's cold start
+    for (const size_t kBytes : sizes) {
+        for (int r = 0; r < kPairWarmupRounds; ++r)
+            pingPongRound(pairComm, SendMode::Blocking, sendBuffer.data(), recvBuffer.data(), static_cast<int>(kBytes));
+    }
+
+    for (size_t m = 0; m < kModes.size(); ++m) {
+        if (kPrints) {
+            std::cout << "\n[" << m + 1 << "] Ping-Pong One-Way Latency: " << sendModeName(kModes[m]) << "\n"
+                << std::string(kTableLength, '-') << std::endl;
+            printTableHeader(kHeaders, kWidths, kTableLength);
+        }
+
+        for (size_t s = 0; s < sizes.size(); ++s) {
+            const int kBytes = static_cast<int>(sizes[s]);
+            const BenchmarkStats kStats = runBenchmark(kSharedHarness, [&]() {
+                return pingPongRound(pairComm, kModes[m], sendBuffer.data(), recvBuffer.data(), kBytes);
+            });
+
+            if (!kPrints)
+                continue;
+            medians[m][s] = kStats.median;
+            addPairResult(sink, group, sendModeName(kModes[m]), sizes[s], kStats, sizes[s] / kStats.median / 1e9);
+            printTableRow({formatBytes(sizes[s]), std::to_string(kStats.runs), formatFixed(kStats.min * 1e6, 2),
+                           formatFixed(kStats.median * 1e6, 2), formatFixed(kStats.p95 * 1e6, 2), formatError(kStats),
+                           formatFixed(sizes[s] / kStats.median / 1e9, 3)},
+                          kWidths);
+        }
+    }
+
+    int detachedSize;
+    void* detached;
+    MPI_Buffer_detach(&detached, &detachedSize);
+
+    // Streamed bandwidth at the median window time
+    std::vector<double> streamed(sizes.size());
+    for (size_t s = 0; s < sizes.size(); ++s) {
+        const int kBytes = static_cast<int>(sizes[s]);
+        const BenchmarkStats kStats = runBenchmark(kSharedHarness, [&]() {
+            return streamWindow(pairComm, sendBuffer.data(), recvBuffer.data(), kBytes, window);
+        });
+        streamed[s] = static_cast<double>(kBytes) * streamWindowFor(kBytes, window) / kStats.median / 1e9;
+        if (kPrints)
+            addPairResult(sink, group, "stream", sizes[s], kStats, streamed[s]);
+    }
+
+    if (!kPrints)
+        return;
+
+    const std::vector<std::string> kSummaryHeaders = {"Size", "Send", "Isend", "Ssend", "Bsend", "Send/Ssend", "Stream GB/s"};
+    const std::vector<int> kSummaryWidths = {10, 10, 10, 10, 10, 12, 14};
+    std::cout << "\n[" << kModes.size() + 1 << "] Median Latency per Mode (us) and Streamed Bandwidth (window of "
+        << window << ")\n" << std::string(kTableLength, '-') << std::endl;
+    printTableHeader(kSummaryHeaders, kSummaryWidths, kTableLength);
+
+    std::vector<double> ratios(sizes.size());
+    for (size_t s = 0; s < sizes.size(); ++s) {
+        ratios[s] = medians[0][s] / medians[2][s];
+        printTableRow({formatBytes(sizes[s]), formatFixed(medians[0][s] * 1e6, 2), formatFixed(medians[1][s] * 1e6, 2),
+                       formatFixed(medians[2][s] * 1e6, 2), formatFixed(medians[3][s] * 1e6, 2), formatFixed(ratios[s], 2),
+                       formatFixed(streamed[s], 3)},
+                      kSummaryWidths);
+    }
+
+    // Eager limit estimate: the last size before the Send/Ssend ratio steps up towards 1,
+    // provided MPI_Send is clearly cheaper than MPI_Ssend below the step
+    constexpr double kMinEagerRise = 0.05;
+    if (sizes.size() < 2) {
+        std::cout << "\n- - - Warning: at least two message sizes are needed to estimate the eager limit - - -\n";
+        return;
+    }
+    const EagerStep kStep = fitEagerStep(ratios);
+    if (kStep.rise() >= kMinEagerRise && kStep.eagerRatio <= 1.0 - kMinEagerRise) {
+        std::cout << "\n+ + + Estimated eager limit: " << formatBytes(sizes[kStep.lastEager]) << " (Send/Ssend "
+            << formatFixed(kStep.eagerRatio, 2) << " up to it, " << formatFixed(kStep.rendezvousRatio, 2) << " above) + + +\n";
+    } else {
+        std::cout << "\n- - - Warning: no step up from a Send/Ssend ratio below 1 (best split at " << formatBytes(sizes[kStep.lastEager]) << ": "
+            << formatFixed(kStep.eagerRatio, 2) << " -> " << formatFixed(kStep.rendezvousRatio, 2)
+            << ") - no eager protocol visible - - -\n";
+    }
+}
+
+/**
+ * @brief Splits off a two-rank communicator holding the master and a partner.
+ * 
+ * Collective over MPI_COMM_WORLD.
+ * 
+ * @param partner World rank paired with the master, or -1 for none.
+ * @return The pair on its two members, MPI_COMM_NULL elsewhere.
+ */
+MPI_Comm makePairComm(int partner) {
+    int worldRank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &worldRank);
+    const bool kMember = (partner > 0) && (worldRank == kMasterRank || worldRank == partner);
+
+    MPI_Comm pairComm;
+    MPI_Comm_split(MPI_COMM_WORLD, kMember ? 0 : MPI_UNDEFINED, worldRank, &pairComm);
+    return pairComm;
+}
+
+int main(int argc, char** argv) {
+    // Console UI elements
+    constexpr int kLineLength = 50;
+    const std::string kSingleLine(kLineLength, '-');
+    const std::string kDoubleLine(kLineLength, '=');
+
+    // Initialize the MPI environment
+    MPI_Init(&argc, &argv);
+
+    // Get total number of processes and current process rank
+    int worldSize, worldRank;
+    MPI_Comm_size(MPI_COMM_WORLD, &worldSize);
+    MPI_Comm_rank(MPI_COMM_WORLD, &worldRank);
+
+    // Command-line options; a round trip is short, so every size gets more runs than the harness default
+    const std::string kUsage = "* * * Usage: mpirun -np <number_of_processes> ./<program_name> [--sizes=LIST] [--window=N] "
+        + benchmarkUsage() + " " + resultsUsage() + " " + optionsUsage() + " * * *\n\n";
+    BenchmarkOptions harness;
+    harness.warmupRuns = 3;
+    harness.minRuns = 10;
+    harness.maxRuns = 1000;
+    harness.maxSeconds = 0.25;
+    std::vector<int> sizeList = {1, 4, 16, 64, 256, 1024, 4096, 16384, 65536, 262144, 1048576, 4194304, 16777216, 67108864};
+    int window = 32;                // Messages in flight during the streaming test
+    ResultsOptions resultsOptions;
+    std::vector<std::string> args;
+    std::string argError;
+    expandArguments(argc, argv, "pingpong", args, argError);
+    for (size_t i = 0; i < args.size() && argError.empty(); ++i) {
+        const std::string& arg = args[i];
+        if (parseBenchmarkOption(arg, harness, argError) || parseResultsOption(arg, resultsOptions, argError))
+            continue;
+        if (arg.rfind("--sizes=", 0) == 0) {
+            if (!parseIntList(arg.substr(8), sizeList) || *std::min_element(sizeList.begin(), sizeList.end()) < 1)
+                argError = "sizes must be positive byte counts or ranges";
+        } else if (arg.rfind("--window=", 0) == 0) {
+            window = std::atoi(arg.c_str() + 9);
+            if (window < 1)
+                argError = "window must be positive";
+        } else {
+            argError = "unknown argument '" + arg + "'";
+        }
+    }
+    if (!argError.empty()) {
+        if (worldRank == kMasterRank)
+            std::cerr << "* * * Error: " << argError << " * * *\n" << kUsage;
+        MPI_Finalize();
+        return 1;
+    }
+
+    // Enforce that this program must run with at least 2 processes (1 master + 1 partner)
+    if (worldRank == kMasterRank && worldSize < 2) {
+        std::cerr << "* * * Error: this program must be run with at least 2 processes * * *\n";
+        std::cerr << kUsage;
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+
+    // Identify every rank's node by the world rank of its node leader
+    MPI_Comm nodeComm;
+    MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, worldRank, MPI_INFO_NULL, &nodeComm);
+    int nodeLeader = worldRank;
+    MPI_Bcast(&nodeLeader, 1, MPI_INT, 0, nodeComm);
+    std::vector<int> nodeOf(worldSize);
+    MPI_Allgather(&nodeLeader, 1, MPI_INT, nodeOf.data(), 1, MPI_INT, MPI_COMM_WORLD);
+    MPI_Comm_free(&nodeComm);
+
+    // Partners of the master: the first rank on its node and the first rank on another node
+    int intraPartner = -1, interPartner = -1;
+    for (int r = 1; r < worldSize; ++r) {
+        if (nodeOf[r] == nodeOf[kMasterRank] && intraPartner < 0)
+            intraPartner = r;
+        if (nodeOf[r] != nodeOf[kMasterRank] && interPartner < 0)
+            interPartner = r;
+    }
+
+    // The eager-limit fit needs the sizes in increasing order
+    std::vector<size_t> sizes(sizeList.begin(), sizeList.end());
+    std::sort(sizes.begin(), sizes.end());
+    sizes.erase(std::unique(sizes.begin(), sizes.end()), sizes.end());
+
+    if (worldRank == kMasterRank) {
+        const unsigned int numCores = std::thread::hardware_concurrency();
+        int numNodes = 0;
+        for (int r = 0; r < worldSize; ++r)
+            numNodes += (nodeOf[r] == r) ? 1 : 0;
+
+        // Display program configurations
+        std::cout << kDoubleLine << "\nMPI Point-to-Point Latency and Bandwidth\n" << kDoubleLine << std::endl;
+        std::cout << "Configuration\n" << kSingleLine << std::endl
+                << "Number of cores: " << numCores << std::endl
+                << "Number of MPI processes: " << worldSize << std::endl
+                << "Number of nodes: " << numNodes << std::endl
+                << "Message sizes: " << formatBytes(sizes.front()) << " to " << formatBytes(sizes.back())
+                << " (" << sizes.size() << " sizes)" << std::endl
+                << "Repetition: " << describeBenchmarkOptions(harness) << std::endl
+                << "Send modes: MPI_Send, MPI_Isend, MPI_Ssend, MPI_Bsend" << std::endl
+                << "Latency: half the round trip, one round trip per run" << std::endl;
+    }
+
+    const std::vector<PairCase> kPairs = {
+        {intraPartner, "intra-node", "Intra-Node Pair (process 0 <-> process " + std::to_string(intraPartner) + ")"},
+        {interPartner, "inter-node", "Inter-Node Pair (process 0 <-> process " + std::to_string(interPartner) + ")"},
+    };
+    ResultsSink sink("mpi_partg_pingpong");
+    for (const PairCase& pair : kPairs) {
+        MPI_Comm pairComm = makePairComm(pair.partner);
+        if (pairComm != MPI_COMM_NULL) {
+            runPair(pairComm, pair.title, sizes, window, harness, pair.group, sink);
+            MPI_Comm_free(&pairComm);
+        }
+        MPI_Barrier(MPI_COMM_WORLD);
+    }
+
+    if (worldRank == kMasterRank) {
+        if (intraPartner < 0)
+            std::cout << "\n- - - Warning: No other process shares the master's node - intra-node pair skipped - - -\n";
+        if (interPartner < 0)
+            std::cout << "\n- - - Warning: All processes share one node - inter-node pair skipped - - -\n";
+    }
+
+    // A failed write or a regression fails every rank
+    bool isPassing = (worldRank == kMasterRank) ? reportResults(sink, resultsOptions) : true;
+    MPI_Bcast(&isPassing, 1, MPI_CXX_BOOL, kMasterRank, MPI_COMM_WORLD);
+
+    // Finalize the MPI environment
+    MPI_Finalize();
+
+    return isPassing ? 0 : 1;
+}
\ No newline at end of file
@@ -1,16 +1,37 @@
+#include <cstdlib>
 #include <iostream>
 #include <limits>
 #include <omp.h>
+#include <string>
 
-int main() {
-    int numThreads;
+int main(int argc, char** argv) {
+    int numThreads = 0;     // 0 -> ask on stdin
     bool hasError = true;
 
+    // Command-line options (--threads=N skips the prompt, for scripted runs)
+    const std::string kUsage = "* * * Usage: ./<program_name> [--threads=N] * * *\n\n";
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg.rfind("--threads=", 0) == 0 && std::atoi(arg.c_str() + 10) > 0) {
+            numThreads = std::atoi(arg.c_str() + 10);
+            hasError = false;
+        } else {
+            std::cerr << "* * * Error: invalid argument '" << arg << "' * * *\n" << kUsage;
+            return 1;
+        }
+    }
+
     // Prompt user to enter number of threads to be created
     while (hasError) {
         std::cout << "Enter number of threads: ";
         std::cin >> numThreads;
 
+        // Input ended without a valid number (e.g. stdin redirected from an empty file)
+        if (std::cin.eof()) {
+            std::cerr << "\n* * * Error: no thread count given * * *\n" << kUsage;
+            return 1;
+        }
+
         // Check for input failure or non-positive integers
         if (std::cin.fail() || numThreads <= 0) {
             // Invalid input
@@ -1,22 +1,132 @@
-#include <chrono>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <iomanip>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <new>
 #include <omp.h>
+#include <sstream>
+#include <stdexcept>
 #include <string>
-#include <thread>
+#include <utility>
 #include <vector>
 
+#include "../common/benchmark.h"
+#include "../common/options.h"
+#include "../common/perfcounters.h"
+#include "../common/results.h"
+#include "../common/trace.h"
+#include "../common/workload.h"
+#include "../common/worksteal.h"
+
+#if defined(__GNUC__) && defined(__SSE2__)
+#include <immintrin.h>
+#define SCHEDULE_HAS_STREAMING_STORES 1
+#endif
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Cache-line aligned allocator that leaves new elements uninitialized.
+ * 
+ * `std::vector::resize` normally value-initializes, which makes the resizing thread
+ * touch (and therefore place) every page. Default-initializing instead defers page
+ * placement to whichever thread writes an element first. Storage starts on a cache
+ * line, so SIMD loads and streaming stores of whole lines are aligned.
+ * 
+ * @tparam T Element type.
+ */
+template <typename T>
+struct FirstTouchAllocator {
+    using value_type = T;
+
+    FirstTouchAllocator() = default;
+    template <typename U>
+    FirstTouchAllocator(const FirstTouchAllocator<U>&) {}
+
+    static constexpr size_t kAlignment = 64;
+
+    T* allocate(size_t count) {
+        // aligned_alloc needs a size that is a multiple of the alignment
+        const size_t kBytes = (count * sizeof(T) + kAlignment - 1) / kAlignment * kAlignment;
+        T* ptr = static_cast<T*>(std::aligned_alloc(kAlignment, std::max(kBytes, kAlignment)));
+        if (ptr == nullptr)
+            throw std::bad_alloc();
+        return ptr;
+    }
+
+    void deallocate(T* ptr, size_t) { std::free(ptr); }
+
+    template <typename U, typename... Args>
+    void construct(U* ptr, Args&&... args) {
+        if constexpr (sizeof...(Args) == 0)
+            ::new (static_cast<void*>(ptr)) U;     // Default-initialize: no write
+        else
+            ::new (static_cast<void*>(ptr)) U(std::forward<Args>(args)...);
+    }
+
+    template <typename U>
+    bool operator==(const FirstTouchAllocator<U>&) const { return true; }
+    template <typename U>
+    bool operator!=(const FirstTouchAllocator<U>&) const { return false; }
+};
+
+using Vector = std::vector<int, FirstTouchAllocator<int>>;
+
 /**
  * @brief Initializes a vector with a fixed sized and value.
  * 
  * Fills the given vector with `size` number of elements, each initialized to `value`.
+ * With a thread count, the elements are written by a static parallel loop so each
+ * page is first touched (and placed on the NUMA node of) the thread whose static
+ * schedule block covers it. Otherwise the calling thread writes every element.
  * 
  * @param vect The vector to initialize.
  * @param size The number of elements to assign.
  * @param value The value to assign to every element.
+ * @param numThreads Optional number of threads for parallel first touch (0 -> serial).
  */
-void initVector(std::vector<int>& vect, int size, int value) {
-    vect.assign(size, value);
+void initVector(Vector& vect, int size, int value, int numThreads = 0) {
+    if (numThreads == 0) {
+        vect.assign(size, value);
+        return;
+    }
+
+    // Reallocate so the old pages are not reused, then touch in parallel
+    Vector().swap(vect);
+    vect.resize(size);
+
+    #pragma omp parallel for schedule(static) num_threads(numThreads)
+    for (int i = 0; i < size; ++i) {
+        vect[i] = value;
+    }
+}
+
+/**
+ * @brief Describes the thread binding policy the next parallel region will use.
+ * 
+ * Binding is an OpenMP runtime setting read once at program start, so it is selected
+ * with the `OMP_PROC_BIND` (close, spread) and `OMP_PLACES` (cores, threads, sockets)
+ * environment variables.
+ * 
+ * @return Binding policy and number of places, e.g. "close (4 places)".
+ */
+std::string describeThreadBinding() {
+    std::string policy;
+    switch (omp_get_proc_bind()) {
+        case omp_proc_bind_false: policy = "none"; break;
+        case omp_proc_bind_true: policy = "true"; break;
+        case omp_proc_bind_master: policy = "primary"; break;
+        case omp_proc_bind_close: policy = "close"; break;
+        case omp_proc_bind_spread: policy = "spread"; break;
+        default: policy = "unknown"; break;
+    }
+    return policy + " (" + std::to_string(omp_get_num_places()) + " places)";
 }
 
 /**
@@ -24,9 +134,10 @@ void initVector(std::vector<int>& vect, int size, int value) {
  * 
  * Used for debugging or visual inspection of a vector's contents.
  * 
- * @param vect The vector to print.
+ * @param vect The vector to print (a Vector or a list of options).
  */
-void printVector(std::vector<int>& vect) {
+template <typename Container>
+void printVector(const Container& vect) {
     for (int num : vect) {
         std::cout << " " << num;
     }
@@ -57,147 +168,790 @@ void printTableRow(const std::vector<std::string>& values, const std::vector<int
     std::cout << "\n";
 }
 
+/**
+ * @brief How a parallel loop hands out its iterations.
+ */
+enum class ScheduleKind { Static, Dynamic, Guided, Auto, Taskloop, Stealing };
+
+const std::vector<ScheduleKind> kAllSchedules = {ScheduleKind::Static, ScheduleKind::Dynamic, ScheduleKind::Guided,
+                                                 ScheduleKind::Auto, ScheduleKind::Taskloop, ScheduleKind::Stealing};
+
+/**
+ * @brief One point of the schedule space: method, chunk size and team size.
+ */
+struct ScheduleConfig {
+    ScheduleKind kind = ScheduleKind::Static;
+    int chunkSize = 0;      // Chunk, taskloop grainsize or stealing grain (0 -> method default)
+    int numThreads = 0;     // 0 -> all available processors
+};
+
+/**
+ * @brief Returns the lower-case name of a scheduling method, as used on the command line.
+ */
+std::string scheduleName(ScheduleKind kind) {
+    switch (kind) {
+        case ScheduleKind::Static: return "static";
+        case ScheduleKind::Dynamic: return "dynamic";
+        case ScheduleKind::Guided: return "guided";
+        case ScheduleKind::Auto: return "auto";
+        case ScheduleKind::Taskloop: return "taskloop";
+        case ScheduleKind::Stealing: return "stealing";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Returns the work-stealing scheduler for a team size, creating it on first use.
+ * 
+ * Keeping one per team size means the deques are allocated once, outside every timed loop.
+ * Call from outside parallel regions only.
+ */
+WorkStealingScheduler& workStealingScheduler(int numThreads) {
+    static std::map<int, std::unique_ptr<WorkStealingScheduler>> schedulers;
+    std::unique_ptr<WorkStealingScheduler>& scheduler = schedulers[numThreads];
+    if (!scheduler)
+        scheduler.reset(new WorkStealingScheduler(numThreads));
+    return *scheduler;
+}
+
+/**
+ * @brief Runs `body(i)` for every i in [0, size) with the given schedule.
+ * 
+ * The `omp for` methods share a single `schedule(runtime)` loop whose kind and chunk are set
+ * with omp_set_schedule(), so every combination is reachable without a pragma per case.
+ * Taskloop and work stealing have their own loop constructs.
+ * 
+ * With an idle profile, the `omp for` loop drops its implicit barrier for a timed explicit
+ * one, and work stealing reports each thread's search for work; taskloop threads wait
+ * while running tasks, so they record nothing.
+ * 
+ * @tparam Body Callable taking the iteration index.
+ * @param config Method, chunk size and thread count.
+ * @param size Number of iterations.
+ * @param body Loop body.
+ * @param idle Receives each thread's wait for the rest of the team (null -> not measured).
+ */
+template <typename Body>
+void parallelLoop(const ScheduleConfig& config, int size, const Body& body, BarrierIdleProfile* idle = nullptr) {
+    const int kThreads = (config.numThreads > 0) ? config.numThreads : omp_get_num_procs();
+    // Taskloop and stealing default to ~16 pieces per thread, like their runtime defaults
+    const int kGrain = (config.chunkSize > 0) ? config.chunkSize : std::max(1, size / (kThreads * 16));
+
+    omp_sched_t ompKind = omp_sched_static;
+    switch (config.kind) {
+        case ScheduleKind::Static: ompKind = omp_sched_static; break;
+        case ScheduleKind::Dynamic: ompKind = omp_sched_dynamic; break;
+        case ScheduleKind::Guided: ompKind = omp_sched_guided; break;
+        case ScheduleKind::Auto: ompKind = omp_sched_auto; break;
+        case ScheduleKind::Taskloop:
+            #pragma omp parallel num_threads(kThreads)
+            #pragma omp single
+            #pragma omp taskloop grainsize(kGrain)
+            for (int i = 0; i < size; ++i)
+                body(i);
+            return;
+        case ScheduleKind::Stealing: {
+            WorkStealingScheduler& scheduler = workStealingScheduler(kThreads);
+            scheduler.parallelFor(0, size, kGrain, [&](int64_t i) { body(static_cast<int>(i)); });
+            for (int t = 0; t < kThreads && idle != nullptr; ++t)
+                idle->add(t, scheduler.lastIdleSeconds(t));
+            return;
+        }
+    }
+
+    // A chunk of 0 selects the kind's default chunk
+    omp_set_schedule(ompKind, config.chunkSize);
+    if (idle == nullptr) {
+        #pragma omp parallel for schedule(runtime) num_threads(kThreads)
+        for (int i = 0; i < size; ++i)
+            body(i);
+        return;
+    }
+
+    #pragma omp parallel num_threads(kThreads)
+    {
+        #pragma omp for schedule(runtime) nowait
+        for (int i = 0; i < size; ++i)
+            body(i);
+        const double kArrival = omp_get_wtime();
+        #pragma omp barrier
+        idle->add(omp_get_thread_num(), omp_get_wtime() - kArrival);
+    }
+}
+
+/**
+ * @brief Pure vector addition: no cost beyond the add itself.
+ */
+struct AddOnlyWorkload {
+    void apply(int) const {}
+};
+
+/**
+ * @brief Vector addition followed by the calibrated spin cost of each iteration.
+ */
+struct SpinWorkload {
+    const uint32_t* units;
+    void apply(int i) const { spinWork(units[i]); }
+};
+
+/**
+ * @brief A workload profile laid out for one vector size.
+ */
+struct Workload {
+    WorkloadProfile profile = WorkloadProfile::Balanced;
+    std::vector<uint32_t> units;        // Spin units per iteration; empty -> pure vector addition
+};
+
+/**
+ * @brief Builds the per-iteration costs of a profile; done outside the timed region.
+ * 
+ * @param profile Cost distribution from common/workload.h.
+ * @param size Number of iterations.
+ * @param meanCostNs Mean spin cost per iteration (0 -> pure vector addition).
+ * @param spinsPerNs Calibrated spin rate.
+ */
+Workload makeWorkload(WorkloadProfile profile, int size, double meanCostNs, double spinsPerNs) {
+    Workload workload;
+    workload.profile = profile;
+    if (meanCostNs > 0)
+        workload.units = buildCostTable(profile, size, meanCostNs, spinsPerNs);
+    return workload;
+}
+
 /**
  * @brief Runs a parallel vector addition using a specific scheduling method.
  * 
- * Supports both static and dynamic shceduling, with optional chunk size and thread count.
- * Results are printed in a formatted table showing thread ID, iteration, and result.
+ * Every thread records (tid, iteration, time) into its own ring while the loop runs;
+ * the records are merged afterwards and printed in start order, so printing no longer
+ * serialises the loop it is meant to show.
  * 
  * @param vect1 First input vector.
  * @param vect2 Second input vector.
  * @param vect3 Output vector to store results.
- * @param scheduleType The scheduling method to use ("static" or "dynamic").
+ * @param config The scheduling method, chunk size and thread count to use.
  * @param kColWidths Column widths for formatted table output display.
- * @param numThreads Optional number of threads (0 -> use all available processors).
- * @param chunkSize Optional chunk size for scheduling (0 -> use default chunk size).
- */
-void runSchedule(const std::vector<int>& vect1, const std::vector<int>& vect2, std::vector<int>& vect3,
-    const std::string& scheduleType, const std::vector<int>& kColWidths, int numThreads = 0, int chunkSize = 0) {
-    // Set default number of threads
-    if (numThreads == 0)
-        numThreads = omp_get_num_procs();
-        
-    const int kSize = vect1.size();
-
-    if (scheduleType == "static") {
-        if (chunkSize > 0) {
-            #pragma omp parallel for schedule(static, chunkSize) num_threads(numThreads)
-            for (int i = 0; i < kSize; ++i) {
-                int tid = omp_get_thread_num();
-                vect3[i] = vect1[i] + vect2[i];
-                #pragma omp critical
-                printTableRow({std::to_string(tid), std::to_string(i), std::to_string(vect3[i])}, kColWidths);
-            }
-        } else {
-            #pragma omp parallel for schedule(static) num_threads(numThreads)
-            for (int i = 0; i < kSize; ++i) {
-                int tid = omp_get_thread_num();
-                vect3[i] = vect1[i] + vect2[i];
-                #pragma omp critical
-                printTableRow({std::to_string(tid), std::to_string(i), std::to_string(vect3[i])}, kColWidths);
-            }
-        }
-    } else if (scheduleType == "dynamic") {
-        if (chunkSize > 0) {
-            #pragma omp parallel for schedule(dynamic, chunkSize) num_threads(numThreads)
-            for (int i = 0; i < kSize; ++i) {
-                int tid = omp_get_thread_num();
-                vect3[i] = vect1[i] + vect2[i];
-                #pragma omp critical
-                printTableRow({std::to_string(tid), std::to_string(i), std::to_string(vect3[i])}, kColWidths);
-            }
-        } else {
-            #pragma omp parallel for schedule(dynamic) num_threads(numThreads)
-            for (int i = 0; i < kSize; ++i) {
-                int tid = omp_get_thread_num();
-                vect3[i] = vect1[i] + vect2[i];
-                #pragma omp critical
-                printTableRow({std::to_string(tid), std::to_string(i), std::to_string(vect3[i])}, kColWidths);
-            }
-        }
+ * @param trace Buffer for the records, with a ring per thread of the team.
+ */
+void runSchedule(const Vector& vect1, const Vector& vect2, Vector& vect3, const ScheduleConfig& config,
+    const std::vector<int>& kColWidths, TraceBuffer& trace) {
+    trace.clear();
+    const int64_t kOrigin = TraceBuffer::now();
+    parallelLoop(config, vect1.size(), [&](int i) {
+        const int64_t kStart = TraceBuffer::now();
+        vect3[i] = vect1[i] + vect2[i];
+        trace.record(omp_get_thread_num(), i, kStart, TraceBuffer::now());
+    });
+
+    for (const TraceEvent& kEvent : trace.merge()) {
+        std::ostringstream start;
+        start << std::fixed << std::setprecision(1) << (kEvent.startNs - kOrigin) / 1000.0;
+        printTableRow({std::to_string(kEvent.tid), std::to_string(kEvent.iteration), std::to_string(vect3[kEvent.iteration]),
+            start.str()}, kColWidths);
     }
 }
 
+/**
+ * @brief Times one vector addition with a compile-time workload.
+ * 
+ * @tparam Policy Type whose `apply(i)` adds the extra cost of iteration i.
+ */
+template <typename Policy>
+double timeSchedule(const Vector& vect1, const Vector& vect2, Vector& vect3, const ScheduleConfig& config,
+    const Policy& policy, BarrierIdleProfile* idle) {
+    const double kStartTime = omp_get_wtime();
+    parallelLoop(config, vect1.size(), [&](int i) {
+        vect3[i] = vect1[i] + vect2[i];
+        policy.apply(i);
+    }, idle);
+    return omp_get_wtime() - kStartTime;
+}
+
 /**
  * @brief Measures execution time of parallel vector addition using a specific scheduling method.
  * 
- * Runs the vector addition using the specified OpenMP scheduling method and returns the time taken.
  * Output is not printed, only computation is measured for accurate performance measurement.
+ * The workload is resolved to a policy type here, so the timed loop carries no branch on it.
  * 
  * @param vect1 First input vector.
  * @param vect2 Second input vector.
  * @param vect3 Output vector to store results.
- * @param scheduleType The scheduling method to use ("static" or "dynamic").
- * @param isBalanced Determines whether to run the test with balanced or imbalanced workload per iteration.
- * @param numThreads Optional number of threads (0 -> use all available processors).
- * @param chunkSize Optional chunk size for scheduling (currently not used).
+ * @param config The scheduling method, chunk size and thread count to use.
+ * @param workload Per-iteration costs, built for the vectors' size.
+ * @param idle Receives each thread's barrier wait (null -> not measured).
  * @return Elapsed time in seconds.
  */
-double measureSchedule(const std::vector<int>& vect1, const std::vector<int>& vect2, std::vector<int>& vect3,
-    const std::string& scheduleType, bool isBalanced, int numThreads = 0, int chunkSize = 0) {
-    // Set default number of threads
-    if (numThreads == 0)
-        numThreads = omp_get_num_procs();
-
-    const int kSize = vect1.size();
-
-    double startTime;
-    double endTime;
-
-    if (scheduleType == "static") {
-        // Static scheduling
-        if (isBalanced) {
-            // Balanced workload per iteration
-            startTime = omp_get_wtime();
-            #pragma omp parallel for schedule(static) num_threads(numThreads)
-            for (int i = 0; i < kSize; ++i) {
-                vect3[i] = vect1[i] + vect2[i];
+double measureSchedule(const Vector& vect1, const Vector& vect2, Vector& vect3, const ScheduleConfig& config,
+    const Workload& workload, BarrierIdleProfile* idle = nullptr) {
+    if (workload.units.empty())
+        return timeSchedule(vect1, vect2, vect3, config, AddOnlyWorkload{}, idle);
+    return timeSchedule(vect1, vect2, vect3, config, SpinWorkload{workload.units.data()}, idle);
+}
+
+/**
+ * @brief Runs a compile-time workload under one schedule with every iteration traced.
+ */
+template <typename Policy>
+void traceSchedule(const Vector& vect1, const Vector& vect2, Vector& vect3, const ScheduleConfig& config,
+    const Policy& policy, TraceBuffer& trace) {
+    parallelLoop(config, vect1.size(), [&](int i) {
+        const int64_t kStart = TraceBuffer::now();
+        vect3[i] = vect1[i] + vect2[i];
+        policy.apply(i);
+        trace.record(omp_get_thread_num(), i, kStart, TraceBuffer::now());
+    });
+}
+
+/**
+ * @brief Writes a Chrome trace with one timeline per scheduling method.
+ * 
+ * Each method runs the workload once at the vectors' full size with every iteration
+ * recorded; the rings hold every iteration, so nothing is dropped.
+ * 
+ * @param vects Input, input and output vectors, already initialized.
+ * @param workload Per-iteration costs, built for the vectors' size.
+ * @param numThreads Number of threads.
+ * @param path Output file.
+ * @return False if the file could not be written.
+ */
+bool writeScheduleTrace(Vector (&vects)[3], const Workload& workload, int numThreads, const std::string& path) {
+    ChromeTraceWriter writer(path);
+    if (!writer.isOpen())
+        return false;
+
+    TraceBuffer trace(numThreads, vects[0].size());
+    for (const ScheduleKind kKind : kAllSchedules) {
+        const ScheduleConfig kConfig = {kKind, 0, numThreads};
+        trace.clear();
+        const int64_t kOrigin = TraceBuffer::now();
+        if (workload.units.empty())
+            traceSchedule(vects[0], vects[1], vects[2], kConfig, AddOnlyWorkload{}, trace);
+        else
+            traceSchedule(vects[0], vects[1], vects[2], kConfig, SpinWorkload{workload.units.data()}, trace);
+        writer.addTimeline(scheduleName(kKind), trace.merge(), kOrigin);
+    }
+    return true;
+}
+
+/**
+ * @brief Sweeps increasing vector sizes for every scheduling method at its default chunk.
+ * 
+ * Prints the median time per method, each measured adaptively by the harness, and the
+ * fastest method for each size.
+ * 
+ * @param vects Input, input and output vectors, resized for every size.
+ * @param sizes Vector sizes to sweep.
+ * @param values Values the three vectors are filled with.
+ * @param profile Per-iteration cost profile.
+ * @param meanCostNs Mean spin cost per iteration (0 -> pure vector addition).
+ * @param spinsPerNs Calibrated spin rate.
+ * @param numThreads Number of threads.
+ * @param harness Warmup and repetition settings per size and method.
+ * @param initThreads Threads used to first-touch the vectors (0 -> serial).
+ * @param sink Receives every measured case.
+ */
+void runSizeSweep(Vector (&vects)[3], const std::vector<int>& sizes, const int (&values)[3], WorkloadProfile profile, double meanCostNs,
+    double spinsPerNs, int numThreads, const BenchmarkOptions& harness, int initThreads, ResultsSink& sink) {
+    std::vector<std::string> headers = {"Size"};
+    std::vector<int> widths = {10};
+    for (const ScheduleKind kKind : kAllSchedules) {
+        headers.push_back(scheduleName(kKind));
+        widths.push_back(12);
+    }
+    headers.push_back("Best");
+    widths.push_back(18);
+    printTableHeader(headers, widths, 100);
+
+    // Conduct comparison over increasing vector sizes
+    for (const int i : sizes) {
+        // Initialize vectors
+        for (int v = 0; v < 3; ++v)
+            initVector(vects[v], i, values[v], initThreads);
+        const Workload kWorkload = makeWorkload(profile, i, meanCostNs, spinsPerNs);
+
+        // Repeat each method until its median is stable
+        std::vector<double> medians;
+        for (const ScheduleKind kKind : kAllSchedules) {
+            const ScheduleConfig kConfig = {kKind, 0, numThreads};
+            BenchmarkResult result;
+            result.group = workloadName(profile);
+            result.name = scheduleName(kKind);
+            result.size = i;
+            result.workers = numThreads;
+            result.stats = runBenchmark(harness, [&]() {
+                return measureSchedule(vects[0], vects[1], vects[2], kConfig, kWorkload);
+            });
+            medians.push_back(result.stats.median);
+            sink.add(result, 1, numThreads);
+        }
+
+        const size_t kBest = std::min_element(medians.begin(), medians.end()) - medians.begin();
+        std::vector<std::string> row = {std::to_string(i)};
+        for (const double kMedian : medians)
+            row.push_back(std::to_string(kMedian));
+        row.push_back(scheduleName(kAllSchedules[kBest]));
+        printTableRow(row, widths);
+    }
+}
+
+/**
+ * @brief Times every method x chunk size x thread count combination at one vector size.
+ * 
+ * One row per method and chunk size, one column of median times per thread count, then
+ * the speedup and parallel efficiency of the largest team over the 1-thread run of the
+ * same row. `auto` leaves the chunk to the runtime, so it only gets a default-chunk row.
+ * The fastest combination is reported after the table.
+ * 
+ * With counters, every case also collects hardware counters and barrier idle time per
+ * run, and the largest team's IPC, LLC misses and slowest thread's wait join the row.
+ * 
+ * @param vects Input, input and output vectors, already initialized to the sweep size.
+ * @param workload Per-iteration costs, built for the sweep size.
+ * @param threadCounts Team sizes to try.
+ * @param chunkSizes Chunk sizes to try (0 -> method default).
+ * @param harness Warmup and repetition settings per combination.
+ * @param sink Receives every measured case.
+ * @param counters Process counters (null -> no counters or idle time).
+ */
+void runConfigSweep(Vector (&vects)[3], const Workload& workload, const std::vector<int>& threadCounts,
+    const std::vector<int>& chunkSizes, const BenchmarkOptions& harness, ResultsSink& sink,
+    const PerfCounters* counters) {
+    const int kMaxThreads = *std::max_element(threadCounts.begin(), threadCounts.end());
+    const std::string kGroup = workloadName(workload.profile);
+    const long long kSize = static_cast<long long>(vects[0].size());
+
+    // Cases run one after another, so they share the idle slots and probes take deltas
+    BarrierIdleProfile idle(kMaxThreads);
+    BarrierIdleProfile* const kIdle = (counters != nullptr) ? &idle : nullptr;
+    setOmptIdleProfile(kIdle);
+
+    // One case per combination; a row's name keys its 1-thread baseline
+    BenchmarkSuite suite(harness);
+    std::vector<std::pair<ScheduleKind, int>> rows;
+    for (const ScheduleKind kKind : kAllSchedules) {
+        for (const int kChunk : chunkSizes) {
+            if (kKind == ScheduleKind::Auto && kChunk != 0)
+                continue;
+            rows.emplace_back(kKind, kChunk);
+            for (const int kThreads : threadCounts) {
+                const ScheduleConfig kConfig = {kKind, kChunk, kThreads};
+                const std::string kName = scheduleName(kKind) + "/" + std::to_string(kChunk);
+                if (counters == nullptr) {
+                    suite.add(kGroup, kName, kSize, kThreads, [&, kConfig]() {
+                        return measureSchedule(vects[0], vects[1], vects[2], kConfig, workload);
+                    });
+                    continue;
+                }
+                // Taskloop threads wait inside the runtime; only OMPT sees those barriers
+                BarrierIdleProfile* const kCaseIdle =
+                    (kKind == ScheduleKind::Taskloop && !hasOmptBarrierTiming()) ? nullptr : kIdle;
+                std::shared_ptr<CounterProbe> probe = std::make_shared<CounterProbe>(counters, kCaseIdle, kThreads);
+                suite.add(kGroup, kName, kSize, kThreads, [&, kConfig, probe]() {
+                    probe->begin();
+                    const double kTime = measureSchedule(vects[0], vects[1], vects[2], kConfig, workload, kIdle);
+                    probe->end();
+                    return kTime;
+                }, [probe](int timedRuns) { return probe->metrics(timedRuns); });
             }
-            endTime = omp_get_wtime();
-        } else {
-            // Imbalanced workload per iteration
-            startTime = omp_get_wtime();
-            #pragma omp parallel for schedule(static) num_threads(numThreads)
-            for (int i = 0; i < kSize; ++i) {
-                vect3[i] = vect1[i] + vect2[i];
-
-                // Simulate imbalanced workload
-                if (i % 100 == 0)
-                    std::this_thread::sleep_for(std::chrono::microseconds(1));
+        }
+    }
+    suite.run();
+    setOmptIdleProfile(nullptr);
+    sink.addSuite(suite);
+
+    std::vector<std::string> headers = {"Schedule", "Chunk"};
+    std::vector<int> widths = {12, 10};
+    for (const int kThreads : threadCounts) {
+        headers.push_back(std::to_string(kThreads) + " thr (s)");
+        widths.push_back(14);
+    }
+    headers.push_back("Speedup@" + std::to_string(kMaxThreads));
+    headers.push_back("Efficiency");
+    widths.push_back(12);
+    widths.push_back(counters != nullptr ? 12 : 10);
+    const std::vector<std::pair<std::string, std::string>> kMetricColumns = {
+        {"ipc", "IPC"}, {"llc_misses", "LLC miss"}, {"idle_max_us", "Idle (us)"}};
+    for (size_t m = 0; m < kMetricColumns.size() && counters != nullptr; ++m) {
+        headers.push_back(kMetricColumns[m].second);
+        widths.push_back(12);
+    }
+    int lineLength = 0;
+    for (const int kWidth : widths)
+        lineLength += kWidth;
+    printTableHeader(headers, widths, std::max(50, lineLength));
+
+    ScheduleConfig best;
+    double bestTime = -1.0;
+    for (const std::pair<ScheduleKind, int>& kRow : rows) {
+        const std::string kName = scheduleName(kRow.first) + "/" + std::to_string(kRow.second);
+        std::vector<std::string> row = {scheduleName(kRow.first), kRow.second == 0 ? "default" : std::to_string(kRow.second)};
+        for (const int kThreads : threadCounts) {
+            const double kMedian = suite.find(kGroup, kName, kSize, kThreads)->stats.median;
+            if (bestTime < 0 || kMedian < bestTime) {
+                bestTime = kMedian;
+                best = {kRow.first, kRow.second, kThreads};
             }
-            endTime = omp_get_wtime();
+            row.push_back(std::to_string(kMedian));
+        }
+
+        const BenchmarkResult* kWidest = suite.find(kGroup, kName, kSize, kMaxThreads);
+        std::ostringstream speedup, efficiency;
+        speedup << std::fixed << std::setprecision(2) << kWidest->speedup << "x";
+        efficiency << std::fixed << std::setprecision(0) << kWidest->efficiency * 100 << "%";
+        row.push_back(kWidest->speedup > 0 ? speedup.str() : "-");
+        row.push_back(kWidest->speedup > 0 ? efficiency.str() : "-");
+        for (size_t m = 0; m < kMetricColumns.size() && counters != nullptr; ++m) {
+            const BenchmarkMetric* kMetric = findMetric(*kWidest, kMetricColumns[m].first);
+            row.push_back(kMetric != nullptr ? formatMetric(kMetric->value) : "-");
         }
-    } else if (scheduleType == "dynamic") {
-        // Dynamic scheduling
-        if (isBalanced) {
-            // Balanced workload per iteration
-            startTime = omp_get_wtime();
-            #pragma omp parallel for schedule(dynamic) num_threads(numThreads)
-            for (int i = 0; i < kSize; ++i) {
-                vect3[i] = vect1[i] + vect2[i];
+        printTableRow(row, widths);
+    }
+
+    std::cout << "Fastest: " << scheduleName(best.kind) << ", chunk "
+        << (best.chunkSize == 0 ? "default" : std::to_string(best.chunkSize)) << ", " << best.numThreads
+        << " thread(s): " << bestTime << " s" << std::endl;
+}
+
+/**
+ * @brief STREAM-style kernels over the three vectors (a, b -> c).
+ */
+enum class StreamKernel { Copy, Add, Triad };
+
+constexpr int kTriadScalar = 3;
+
+/**
+ * @brief Returns the display name of a STREAM kernel.
+ */
+std::string streamKernelName(StreamKernel kernel) {
+    switch (kernel) {
+        case StreamKernel::Copy: return "Copy";
+        case StreamKernel::Add: return "Add";
+        case StreamKernel::Triad: return "Triad";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Bytes a kernel moves per element, counted the STREAM way (write-allocate reads excluded).
+ */
+int streamBytesPerElement(StreamKernel kernel) {
+    return static_cast<int>(sizeof(int)) * (kernel == StreamKernel::Copy ? 2 : 3);
+}
+
+/**
+ * @brief One element (or one SIMD vector of elements) of a kernel.
+ * 
+ * Always inlined and never passing vectors by value, so the AVX2 and AVX-512 clones
+ * run it at their own width without crossing a call compiled for a narrower one.
+ * 
+ * @tparam V int or a GNU vector of ints.
+ */
+template <StreamKernel Kernel, typename V>
+__attribute__((always_inline)) inline void streamCombine(const V& a, const V& b, V& result) {
+    if constexpr (Kernel == StreamKernel::Copy)
+        result = a;
+    else if constexpr (Kernel == StreamKernel::Add)
+        result = a + b;
+    else
+        result = a + kTriadScalar * b;
+}
+
+#ifdef SCHEDULE_HAS_STREAMING_STORES
+/**
+ * @brief Instruction sets the streaming kernels are compiled for, widest last.
+ */
+enum class StreamIsa { Sse2, Avx2, Avx512 };
+
+/**
+ * @brief Returns the widest streaming clone the running CPU can execute.
+ */
+StreamIsa detectStreamIsa() {
+    if (__builtin_cpu_supports("avx512f"))
+        return StreamIsa::Avx512;
+    if (__builtin_cpu_supports("avx2"))
+        return StreamIsa::Avx2;
+    return StreamIsa::Sse2;
+}
+
+/**
+ * @brief Returns the display name of a streaming clone.
+ */
+std::string streamIsaName(StreamIsa isa) {
+    switch (isa) {
+        case StreamIsa::Sse2: return "SSE2, 128-bit";
+        case StreamIsa::Avx2: return "AVX2, 256-bit";
+        case StreamIsa::Avx512: return "AVX-512, 512-bit";
+    }
+    return "unknown";
+}
+
+typedef int StreamVector128 __attribute__((vector_size(16)));
+typedef int StreamVector256 __attribute__((vector_size(32)));
+typedef int StreamVector512 __attribute__((vector_size(64)));
+
+/**
+ * @brief Streams the whole 128-bit vectors of [begin, end); c + begin must be 16-byte aligned.
+ * 
+ * @return First element left for the scalar tail.
+ */
+template <StreamKernel Kernel>
+int streamBlockSse2(const int* a, const int* b, int* c, int begin, int end) {
+    for (; begin + 4 <= end; begin += 4) {
+        StreamVector128 va, vb, vc;
+        std::memcpy(&va, a + begin, sizeof(va));
+        std::memcpy(&vb, b + begin, sizeof(vb));
+        streamCombine<Kernel>(va, vb, vc);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(c + begin), reinterpret_cast<const __m128i&>(vc));
+    }
+    return begin;
+}
+
+/**
+ * @brief AVX2 clone of streamBlockSse2(): 256-bit vectors, c + begin 32-byte aligned.
+ */
+template <StreamKernel Kernel>
+__attribute__((target("avx2")))
+int streamBlockAvx2(const int* a, const int* b, int* c, int begin, int end) {
+    for (; begin + 8 <= end; begin += 8) {
+        StreamVector256 va, vb, vc;
+        std::memcpy(&va, a + begin, sizeof(va));
+        std::memcpy(&vb, b + begin, sizeof(vb));
+        streamCombine<Kernel>(va, vb, vc);
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(c + begin), reinterpret_cast<const __m256i&>(vc));
+    }
+    return begin;
+}
+
+/**
+ * @brief AVX-512 clone of streamBlockSse2(): 512-bit vectors, c + begin 64-byte aligned.
+ */
+template <StreamKernel Kernel>
+__attribute__((target("avx512f")))
+int streamBlockAvx512(const int* a, const int* b, int* c, int begin, int end) {
+    for (; begin + 16 <= end; begin += 16) {
+        StreamVector512 va, vb, vc;
+        std::memcpy(&va, a + begin, sizeof(va));
+        std::memcpy(&vb, b + begin, sizeof(vb));
+        streamCombine<Kernel>(va, vb, vc);
+        _mm512_stream_si512(reinterpret_cast<__m512i*>(c + begin), reinterpret_cast<const __m512i&>(vc));
+    }
+    return begin;
+}
+
+/**
+ * @brief Runs the streaming clone for `isa` over one block.
+ */
+template <StreamKernel Kernel>
+int streamBlock(StreamIsa isa, const int* a, const int* b, int* c, int begin, int end) {
+    switch (isa) {
+        case StreamIsa::Avx512: return streamBlockAvx512<Kernel>(a, b, c, begin, end);
+        case StreamIsa::Avx2: return streamBlockAvx2<Kernel>(a, b, c, begin, end);
+        case StreamIsa::Sse2: break;
+    }
+    return streamBlockSse2<Kernel>(a, b, c, begin, end);
+}
+#endif
+
+/**
+ * @brief Runs one STREAM kernel over [0, size) with one static, cache-line aligned block per thread.
+ * 
+ * With `streaming`, results bypass the cache through non-temporal stores, which saves
+ * the read-for-ownership of every output line once the arrays no longer fit in cache;
+ * otherwise the block is an ordinary `omp simd` loop. The streaming loop is the AVX-512,
+ * AVX2 or SSE2 clone the CPU supports, whatever the build targets; without SSE2 both
+ * paths are the `omp simd` loop.
+ * 
+ * @param a First input vector.
+ * @param b Second input vector (unused by Copy).
+ * @param c Output vector.
+ * @param size Number of elements.
+ * @param numThreads Number of threads.
+ * @param streaming Whether to store with non-temporal hints.
+ */
+template <StreamKernel Kernel>
+void runStreamKernel(const int* a, const int* b, int* c, int size, int numThreads, bool streaming) {
+#ifdef SCHEDULE_HAS_STREAMING_STORES
+    static const StreamIsa kIsa = detectStreamIsa();
+#endif
+    #pragma omp parallel num_threads(numThreads)
+    {
+        // Blocks are whole 64-byte lines, so every block starts aligned like the vectors
+        constexpr int kLineElements = 64 / sizeof(int);
+        const int kThreads = omp_get_num_threads();
+        const int kTid = omp_get_thread_num();
+        const int64_t kLines = (size + kLineElements - 1) / kLineElements;
+        const int kBegin = static_cast<int>(std::min<int64_t>(size, kLines * kTid / kThreads * kLineElements));
+        const int kEnd = static_cast<int>(std::min<int64_t>(size, kLines * (kTid + 1) / kThreads * kLineElements));
+
+        int i = kBegin;
+#ifdef SCHEDULE_HAS_STREAMING_STORES
+        if (streaming) {
+            i = streamBlock<Kernel>(kIsa, a, b, c, kBegin, kEnd);
+            _mm_sfence();       // Streamed lines must be globally visible before the region ends
+        }
+#endif
+        #pragma omp simd
+        for (int j = i; j < kEnd; ++j)
+            streamCombine<Kernel>(a[j], b[j], c[j]);
+    }
+}
+
+/**
+ * @brief Dispatches a runtime kernel choice to its template instantiation.
+ */
+void runStreamKernel(StreamKernel kernel, const int* a, const int* b, int* c, int size, int numThreads, bool streaming) {
+    switch (kernel) {
+        case StreamKernel::Copy: runStreamKernel<StreamKernel::Copy>(a, b, c, size, numThreads, streaming); break;
+        case StreamKernel::Add: runStreamKernel<StreamKernel::Add>(a, b, c, size, numThreads, streaming); break;
+        case StreamKernel::Triad: runStreamKernel<StreamKernel::Triad>(a, b, c, size, numThreads, streaming); break;
+    }
+}
+
+/**
+ * @brief Size of the last-level cache in bytes (32 MiB if the system does not say).
+ */
+size_t lastLevelCacheBytes() {
+    long bytes = 0;
+#if defined(__linux__) && defined(_SC_LEVEL3_CACHE_SIZE)
+    bytes = sysconf(_SC_LEVEL3_CACHE_SIZE);
+    if (bytes <= 0)
+        bytes = sysconf(_SC_LEVEL2_CACHE_SIZE);
+#endif
+    return (bytes > 0) ? static_cast<size_t>(bytes) : (size_t(32) << 20);
+}
+
+/**
+ * @brief Bandwidth of one kernel in GB/s from its fastest run, as in STREAM.
+ * 
+ * @param stats Receives the run-time statistics if not null.
+ */
+double measureBandwidth(StreamKernel kernel, const Vector& a, const Vector& b, Vector& c, int numThreads,
+    bool streaming, const BenchmarkOptions& harness, BenchmarkStats* stats = nullptr) {
+    const BenchmarkStats kStats = runBenchmark(harness, [&]() {
+        const double kStartTime = omp_get_wtime();
+        runStreamKernel(kernel, a.data(), b.data(), c.data(), static_cast<int>(a.size()), numThreads, streaming);
+        return omp_get_wtime() - kStartTime;
+    });
+    if (stats != nullptr)
+        *stats = kStats;
+    return static_cast<double>(streamBytesPerElement(kernel)) * a.size() / std::max(kStats.min, 1e-9) / 1e9;
+}
+
+/**
+ * @brief Reports achieved memory bandwidth per kernel and size against the measured peak.
+ * 
+ * Covers the sweep sizes, then a size well past the last-level cache. Non-temporal
+ * stores are used once the three vectors no longer fit in that cache. The plain loop
+ * is the benchmark's own `parallelLoop` addition with a static schedule.
+ * 
+ * @param vects Input, input and output vectors, resized for every size.
+ * @param sweepSizes Vector sizes below the memory size.
+ * @param values Values the three vectors are filled with.
+ * @param threadCounts Team sizes to report; one table each.
+ * @param harness Warmup and repetition settings per kernel and size; the fastest run counts, as in STREAM.
+ * @param initThreads Threads used to first-touch the vectors (0 -> serial).
+ * @param singleLine Separator printed under each table title.
+ * @param sink Receives every table cell's timing, in group "bandwidth".
+ */
+void runBandwidthSweep(Vector (&vects)[3], const std::vector<int>& sweepSizes, const int (&values)[3], const std::vector<int>& threadCounts,
+    const BenchmarkOptions& harness, int initThreads, const std::string& singleLine, ResultsSink& sink) {
+    const std::vector<StreamKernel> kKernels = {StreamKernel::Copy, StreamKernel::Add, StreamKernel::Triad};
+    const size_t kCacheBytes = lastLevelCacheBytes();
+    // Large enough to leave the cache far behind, bounded so three vectors stay under 768 MiB
+    const size_t kMemoryBytes = std::min<size_t>(std::max<size_t>(4 * kCacheBytes, size_t(64) << 20), size_t(256) << 20);
+    const int kMemorySize = static_cast<int>(kMemoryBytes / sizeof(int));
+    const int kMaxThreads = *std::max_element(threadCounts.begin(), threadCounts.end());
+
+    std::vector<int> sizes = sweepSizes;
+    if (kMemorySize > *std::max_element(sizes.begin(), sizes.end()))
+        sizes.push_back(kMemorySize);
+
+    // Peak: the best any kernel, store type and team size reaches on the largest size
+    for (int v = 0; v < 3; ++v)
+        initVector(vects[v], kMemorySize, values[v], initThreads);
+    double peak = 0;
+    int peakThreads = kMaxThreads;
+    for (const int kThreads : threadCounts) {
+        for (const StreamKernel kKernel : kKernels) {
+            for (const bool kStreaming : {false, true}) {
+                const double kRate = measureBandwidth(kKernel, vects[0], vects[1], vects[2], kThreads, kStreaming, harness);
+                if (kRate > peak) {
+                    peak = kRate;
+                    peakThreads = kThreads;
+                }
             }
-            endTime = omp_get_wtime();
-        } else {
-            // Imbalanced workload per iteration
-            startTime = omp_get_wtime();
-            #pragma omp parallel for schedule(dynamic) num_threads(numThreads)
-            for (int i = 0; i < kSize; ++i) {
-                vect3[i] = vect1[i] + vect2[i];
-
-                // Simulate imbalanced workload
-                if (i % 100 == 0)
-                    std::this_thread::sleep_for(std::chrono::microseconds(1));
+        }
+    }
+
+    // Measure every table first: the rows on the largest size may raise the peak
+    struct BandwidthRow {
+        int size;
+        bool streaming;
+        std::vector<double> rates;      // Loop add, then one per kernel
+    };
+    std::vector<std::vector<BandwidthRow>> tables;
+    for (const int kThreads : threadCounts) {
+        tables.emplace_back();
+        for (const int kSize : sizes) {
+            for (int v = 0; v < 3; ++v)
+                initVector(vects[v], kSize, values[v], initThreads);
+            BandwidthRow row = {kSize, 3 * static_cast<size_t>(kSize) * sizeof(int) > kCacheBytes, {}};
+
+            BenchmarkResult cell;
+            cell.group = "bandwidth";
+            cell.name = "Loop add";
+            cell.size = kSize;
+            cell.workers = kThreads;
+            cell.stats = runBenchmark(harness, [&]() {
+                return measureSchedule(vects[0], vects[1], vects[2], {ScheduleKind::Static, 0, kThreads}, Workload{});
+            });
+            sink.add(cell, 1, kThreads);
+            row.rates.push_back(streamBytesPerElement(StreamKernel::Add) * static_cast<double>(kSize) / std::max(cell.stats.min, 1e-9) / 1e9);
+            for (const StreamKernel kKernel : kKernels) {
+                row.rates.push_back(measureBandwidth(kKernel, vects[0], vects[1], vects[2], kThreads, row.streaming, harness, &cell.stats));
+                cell.name = streamKernelName(kKernel);
+                sink.add(cell, 1, kThreads);
+            }
+
+            if (kSize == kMemorySize) {
+                const double kBest = *std::max_element(row.rates.begin(), row.rates.end());
+                if (kBest > peak) {
+                    peak = kBest;
+                    peakThreads = kThreads;
+                }
             }
-            endTime = omp_get_wtime();
+            tables.back().push_back(row);
         }
     }
 
-    return (endTime - startTime);
+    std::cout << "Last-level cache: " << (kCacheBytes >> 10) << " KiB" << std::endl
+        << "Measured peak: " << peak << " GB/s (" << peakThreads << " thread(s), " << kMemorySize << " elements)" << std::endl
+        << "Best/peak above 100% means the vectors are served from cache" << std::endl
+#ifdef SCHEDULE_HAS_STREAMING_STORES
+        << "Streaming stores: " << streamIsaName(detectStreamIsa()) << " (selected at runtime)" << std::endl;
+#else
+        << "Streaming stores: unavailable (plain stores)" << std::endl;
+#endif
+
+    const std::vector<std::string> kHeaders = {"Size", "Loop add", "Copy", "Add", "Triad", "Best/peak", "Stores"};
+    const std::vector<int> kWidths = {12, 12, 12, 12, 12, 12, 10};
+    for (size_t t = 0; t < threadCounts.size(); ++t) {
+        std::cout << "\n[" << t + 1 << "] Bandwidth (GB/s) with " << threadCounts[t] << " thread(s)\n" << singleLine << std::endl;
+        printTableHeader(kHeaders, kWidths, 82);
+        for (const BandwidthRow& kRow : tables[t]) {
+            std::vector<std::string> cells = {std::to_string(kRow.size)};
+            for (const double kRate : kRow.rates)
+                cells.push_back(std::to_string(kRate));
+            const double kBest = *std::max_element(kRow.rates.begin(), kRow.rates.end());
+            cells.push_back(std::to_string(static_cast<int>(100 * kBest / peak + 0.5)) + "%");
+            cells.push_back(kRow.streaming ? "stream" : "cached");
+            printTableRow(cells, kWidths);
+        }
+    }
 }
 
-int main() {
+int main(int argc, char** argv) {
     /**
-     * OUTLINE: Split program into 2 sections
+     * OUTLINE: Split program into 5 sections
      * @section 1: Scheduling Behaviour
      * Compare distribution of iterations amongst threads with a very low iteration count (e.g. 12) to visually inspect how chunks are assigned.
      * Static:
@@ -206,47 +960,138 @@ int main() {
      * Dynamic:
      * - run with default chunk size (1; threads request single iterations to process as they become available)
      * - run with specified chunk size (threads request fixed-size chunks to process as they become available)
+     * Work stealing:
+     * - each thread starts on its static block and idle threads steal half of a busy thread's remaining range
      * @section 2: Performance Comparison
-     * Compare execution time with increasing iterations
-     * - run with balanced workload per iteration
-     * - run with imbalanced workload per iteration
+     * Compare execution time over the --sizes list for static, dynamic, guided, auto,
+     * taskloop and work-stealing scheduling, once per workload profile (balanced, ramp, Zipf,
+     * bimodal, triangular), each costing the same calibrated spin time on average
+     * @section 3: Configuration Sweep
+     * Time every method x chunk size x thread count at one size, once per workload profile;
+     * --counters adds cycles, instructions, IPC, LLC misses and per-thread barrier idle time
+     * @section 4: Memory Bandwidth
+     * Report GB/s of the plain loop and SIMD/streaming-store Copy, Add and Triad kernels per size
+     * and thread count, against the measured peak, to show where threading meets the memory wall
+     * @section 5: Trace Export (--trace=FILE)
+     * Trace every iteration of each method at the sweep size and write the thread timelines as Chrome trace JSON
+     * Finally, the timings of sections 2-4 go to --results=FILE and are checked against --baseline=FILE
      */
 
     // Console UI elements
     constexpr int kLineLength = 50;
     const std::string kSingleLine(kLineLength, '-');
     const std::string kDoubleLine(kLineLength, '=');
-    const std::vector<std::string> kScheduleHeaders = {"TID", "Iteration", "Result"};
-    const std::vector<std::string> kPerformanceHeaders = {"Size", "Static Total (s)", "Dynamic Total (s)", "Static Average (s)", "Dynamic Average (s)"};
-    const std::vector<int> kScheduleColWidths = {10, 15, 10};
-    const std::vector<int> kPerformanceColWidths = {10, 20, 20, 22, 22};
+    const std::vector<std::string> kScheduleHeaders = {"TID", "Iteration", "Result", "Start (us)"};
+    const std::vector<int> kScheduleColWidths = {10, 15, 10, 12};
 
     // Parallelization configs
-    constexpr int kNumThreads = 4;
     constexpr int kStaticChunkSize = 2;
     constexpr int kDynamicChunkSize = 2;
+    std::vector<int> threadCounts = {1, 2, 4};
+    std::vector<int> chunkSizes = {0, 1, 16, 256};
+    std::vector<int> sweepSizes = {10, 100, 1000, 10000, 100000, 1000000};    // Performance and bandwidth sweeps
+    int sweepSize = 100000;
+    std::vector<WorkloadProfile> profiles = kAllWorkloadProfiles;
+    double meanCostNs = 100.0;
+    std::string tracePath;      // Empty -> no Chrome trace
+
+    // Command-line options (--numa enables parallel first-touch initialization)
+    const std::string kUsage = "* * * Usage: ./<program_name> [--numa] [--threads=LIST] [--chunks=LIST] [--sizes=LIST] [--size=N] "
+        "[--workloads=balanced,ramp,zipf,bimodal,triangular] [--cost-ns=N] [--trace=FILE] [--counters] " + benchmarkUsage() + " "
+        + resultsUsage() + " " + optionsUsage() + " * * *\n"
+        "* * * LIST: comma-separated values and ranges, e.g. 1,2,4 or 1:cores:x2 or 100:1000:+100 * * *\n\n";
+    bool isNumaAware = false;
+    bool withCounters = false;
+    BenchmarkOptions harness;
+    ResultsOptions resultsOptions;
+    std::vector<std::string> args;
+    std::string configError;
+    if (!expandArguments(argc, argv, "schedule", args, configError)) {
+        std::cerr << "* * * Error: " << configError << " * * *\n" << kUsage;
+        return 1;
+    }
+    for (const std::string& arg : args) {
+        std::string optionError;
+        if (parseBenchmarkOption(arg, harness, optionError) || parseResultsOption(arg, resultsOptions, optionError)) {
+            if (!optionError.empty()) {
+                std::cerr << "* * * Error: " << optionError << " * * *\n" << kUsage;
+                return 1;
+            }
+        } else if (arg == "--numa") {
+            isNumaAware = true;
+        } else if (arg == "--counters") {
+            withCounters = true;
+        } else if (arg.rfind("--threads=", 0) == 0) {
+            if (!parseIntList(arg.substr(10), threadCounts) ||
+                *std::min_element(threadCounts.begin(), threadCounts.end()) < 1) {
+                std::cerr << "* * * Error: thread counts must be positive integers * * *\n" << kUsage;
+                return 1;
+            }
+        } else if (arg.rfind("--chunks=", 0) == 0) {
+            if (!parseIntList(arg.substr(9), chunkSizes)) {
+                std::cerr << "* * * Error: chunk sizes must be non-negative integers (0 -> default) * * *\n" << kUsage;
+                return 1;
+            }
+        } else if (arg.rfind("--sizes=", 0) == 0) {
+            if (!parseIntList(arg.substr(8), sweepSizes) ||
+                *std::min_element(sweepSizes.begin(), sweepSizes.end()) < 1) {
+                std::cerr << "* * * Error: sweep sizes must be positive integers or ranges * * *\n" << kUsage;
+                return 1;
+            }
+        } else if (arg.rfind("--size=", 0) == 0) {
+            sweepSize = std::atoi(arg.c_str() + 7);
+            if (sweepSize < 1) {
+                std::cerr << "* * * Error: size must be positive * * *\n" << kUsage;
+                return 1;
+            }
+        } else if (arg.rfind("--workloads=", 0) == 0) {
+            profiles.clear();
+            std::stringstream names(arg.substr(12));
+            std::string name;
+            while (std::getline(names, name, ',')) {
+                WorkloadProfile profile;
+                if (!parseWorkloadProfile(name, profile)) {
+                    std::cerr << "* * * Error: unknown workload '" << name << "' * * *\n" << kUsage;
+                    return 1;
+                }
+                profiles.push_back(profile);
+            }
+            if (profiles.empty()) {
+                std::cerr << "* * * Error: no workload selected * * *\n" << kUsage;
+                return 1;
+            }
+        } else if (arg.rfind("--trace=", 0) == 0) {
+            tracePath = arg.substr(8);
+        } else if (arg.rfind("--cost-ns=", 0) == 0) {
+            meanCostNs = std::atof(arg.c_str() + 10);
+            if (meanCostNs < 0) {
+                std::cerr << "* * * Error: cost must be non-negative * * *\n" << kUsage;
+                return 1;
+            }
+        } else {
+            std::cerr << "* * * Error: unknown argument '" << arg << "' * * *\n" << kUsage;
+            return 1;
+        }
+    }
+
+    // Opened before the first parallel region, so the OpenMP threads inherit the counters
+    std::unique_ptr<PerfCounters> counters;
+    if (withCounters)
+        counters.reset(new PerfCounters());
+
+    // The behaviour tables and size sweeps use the largest team
+    const int kNumThreads = *std::max_element(threadCounts.begin(), threadCounts.end());
 
     // Vector properties
     constexpr int kSize = 12;
-    constexpr int kValue1 = 10;
-    constexpr int kValue2 = 20;
-    constexpr int kValue3 = 0;
+    const int kValues[3] = {10, 20, 0};
 
     // Vectors
-    std::vector<int> vect1;
-    std::vector<int> vect2;
-    std::vector<int> vect3;
-
-    // Timing variables
-    double startTime;
-    double endTime;
-    double staticTime;
-    double dynamicTime;
+    Vector vects[3];
 
     // Initialize vectors
-    initVector(vect1, kSize, kValue1);
-    initVector(vect2, kSize, kValue2);
-    initVector(vect3, kSize, kValue3);
+    for (int v = 0; v < 3; ++v)
+        initVector(vects[v], kSize, kValues[v]);
 
     /**
      * @section Scheduling Behaviour
@@ -257,99 +1102,124 @@ int main() {
     std::cout << "Configuration\n" << kSingleLine << std::endl
         << "Number of threads: " << kNumThreads << std::endl
         << "Vector size: " << kSize << std::endl
-        << "Vector1 value: " << kValue1 << std::endl
-        << "Vector2 value: " << kValue2 << std::endl
-        << "Vector3 value: " << kValue3 << std::endl;
-
-    // Static Scheduling
-    // Default chunk size
-    std::cout << "\n[1.1] Static Scheduling - Default Chunk Size\n" << kSingleLine << std::endl;
-    printTableHeader(kScheduleHeaders, kScheduleColWidths, 50);
-    runSchedule(vect1, vect2, vect3, "static", kScheduleColWidths, kNumThreads);
-    // Specified chunk size
-    std::cout << "\n[1.2] Static Scheduling - Specified Chunk Size (" << kStaticChunkSize << ")\n" << kSingleLine << std::endl;
-    printTableHeader(kScheduleHeaders, kScheduleColWidths, 50);
-    runSchedule(vect1, vect2, vect3, "static", kScheduleColWidths, kNumThreads, kStaticChunkSize);
-
-    // Dynamic schedule
-    // Default chunk size
-    std::cout << "\n[2.1] Dynamic Scheduling - Default Chunk Size\n" << kSingleLine << std::endl;
-    printTableHeader(kScheduleHeaders, kScheduleColWidths, 50);
-    runSchedule(vect1, vect2, vect3, "dynamic", kScheduleColWidths, kNumThreads);
-    // Specified chunk size
-    std::cout << "\n[2.2] Dynamic Scheduling - Specified Chunk Size (" << kDynamicChunkSize << ")\n" << kSingleLine << std::endl;
-    printTableHeader(kScheduleHeaders, kScheduleColWidths, 50);
-    runSchedule(vect1, vect2, vect3, "dynamic", kScheduleColWidths, kNumThreads, kDynamicChunkSize);
+        << "Vector1 value: " << kValues[0] << std::endl
+        << "Vector2 value: " << kValues[1] << std::endl
+        << "Vector3 value: " << kValues[2] << std::endl;
+
+    struct BehaviourCase {
+        std::string title;
+        ScheduleConfig config;
+    };
+    const std::vector<BehaviourCase> kBehaviourCases = {
+        {"[1.1] Static Scheduling - Default Chunk Size", {ScheduleKind::Static, 0, kNumThreads}},
+        {"[1.2] Static Scheduling - Specified Chunk Size (" + std::to_string(kStaticChunkSize) + ")",
+         {ScheduleKind::Static, kStaticChunkSize, kNumThreads}},
+        {"[2.1] Dynamic Scheduling - Default Chunk Size", {ScheduleKind::Dynamic, 0, kNumThreads}},
+        {"[2.2] Dynamic Scheduling - Specified Chunk Size (" + std::to_string(kDynamicChunkSize) + ")",
+         {ScheduleKind::Dynamic, kDynamicChunkSize, kNumThreads}},
+        {"[3] Work Stealing - Grain Size (1)", {ScheduleKind::Stealing, 1, kNumThreads}},
+    };
+    TraceBuffer trace(kNumThreads, kSize);
+    for (const BehaviourCase& kCase : kBehaviourCases) {
+        std::cout << "\n" << kCase.title << "\n" << kSingleLine << std::endl;
+        printTableHeader(kScheduleHeaders, kScheduleColWidths, 50);
+        runSchedule(vects[0], vects[1], vects[2], kCase.config, kScheduleColWidths, trace);
+    }
 
     /**
      * @section Performance Comparison
      */
-    constexpr int kMaxSize = 1000000;
-    constexpr int kStartSize = 10;
-    constexpr int kSizeMultiplication = 10;
-    constexpr int kTestCount = 10;
+    const int kInitThreads = isNumaAware ? kNumThreads : 0;     // 0 -> serial first touch
+    const double kSpinsPerNs = calibrateSpinRate();
+    ResultsSink sink("openmp_partb_schedule");
 
     std::cout << std::endl << kDoubleLine << "\nPERFORMANCE COMPARISON\n" << kDoubleLine << std::endl;
 
     // Display configurations
     std::cout << "Configuration\n" << kSingleLine << std::endl
         << "Number of threads: " << kNumThreads << std::endl
-        << "Test Runs: " << kTestCount << std::endl
-        << "Vector1 value: " << kValue1 << std::endl
-        << "Vector2 value: " << kValue2 << std::endl
-        << "Vector3 value: " << kValue3 << std::endl;
+        << "Vector sizes:";
+    printVector(sweepSizes);
+    std::cout << std::endl
+        << "Repetition: " << describeBenchmarkOptions(harness) << std::endl
+        << "Thread binding: " << describeThreadBinding() << std::endl
+        << "First touch: " << (isNumaAware ? "parallel (static)" : "master") << std::endl
+        << "Methods: static, dynamic, guided, auto, taskloop (grainsize), stealing (Chase-Lev)" << std::endl
+        << "Mean iteration cost: " << meanCostNs << " ns of spin (" << kSpinsPerNs << " units/ns)" << std::endl
+        << "Vector1 value: " << kValues[0] << std::endl
+        << "Vector2 value: " << kValues[1] << std::endl
+        << "Vector3 value: " << kValues[2] << std::endl;
 
-    // Balanced Workload per Iteration
-    std::cout << "\n[1] Performance Over Increasing Sizes (Balanced)\n" << kSingleLine << kSingleLine << std::endl;
-    printTableHeader(kPerformanceHeaders, kPerformanceColWidths, 100);
+    int section = 1;
+    for (const WorkloadProfile kProfile : profiles) {
+        std::cout << "\n[" << section++ << "] Median Time (s) Over Increasing Sizes (" << workloadName(kProfile)
+            << ", binding: " << describeThreadBinding() << ")\n" << kSingleLine << kSingleLine << std::endl;
+        runSizeSweep(vects, sweepSizes, kValues, kProfile, meanCostNs, kSpinsPerNs, kNumThreads, harness, kInitThreads, sink);
+    }
 
-    // Conduct comparison over increasing vector sizes
-    for (int i = kStartSize; i <= kMaxSize; i *= kSizeMultiplication) {
-        const int kCurrentSize = i;
-        double staticTime = 0;
-        double dynamicTime = 0;
+    /**
+     * @section Configuration Sweep
+     */
+    std::cout << std::endl << kDoubleLine << "\nCONFIGURATION SWEEP\n" << kDoubleLine << std::endl;
 
-        // Initialize vectors
-        initVector(vect1, kCurrentSize, kValue1);
-        initVector(vect2, kCurrentSize, kValue2);
-        initVector(vect3, kCurrentSize, kValue3);
-
-        // Repeat test with current size for consistent average results
-        for (int j = 0; j < kTestCount; j++) {
-            // Measure execution time for static and dynamic scheduling
-            staticTime += measureSchedule(vect1, vect2, vect3, "static", true, kNumThreads);
-            dynamicTime += measureSchedule(vect1, vect2, vect3, "dynamic", true, kNumThreads);
-        }
+    // Display configurations
+    std::cout << "Configuration\n" << kSingleLine << std::endl
+        << "Vector size: " << sweepSize << std::endl
+        << "Repetition: " << describeBenchmarkOptions(harness) << std::endl
+        << "Thread counts:";
+    printVector(threadCounts);
+    std::cout << std::endl << "Chunk sizes (0 -> default):";
+    printVector(chunkSizes);
+    std::cout << std::endl;
+    if (counters) {
+        std::cout << "Hardware counters: " << counters->describe() << std::endl
+            << "Barrier idle time: timed barrier (omp for), work search (stealing)"
+            << (hasOmptBarrierTiming() ? ", OMPT implicit barriers" : "") << std::endl;
+        if (!counters->anyAvailable())
+            std::cout << "- - - Warning: hardware counters unavailable, only idle time is reported - - -" << std::endl;
+    }
 
-        printTableRow({std::to_string(i), std::to_string(staticTime), std::to_string(dynamicTime),
-            std::to_string(staticTime / kTestCount), std::to_string(dynamicTime / kTestCount)}, kPerformanceColWidths);
+    for (int v = 0; v < 3; ++v)
+        initVector(vects[v], sweepSize, kValues[v], kInitThreads);
+
+    section = 1;
+    for (const WorkloadProfile kProfile : profiles) {
+        const Workload kWorkload = makeWorkload(kProfile, sweepSize, meanCostNs, kSpinsPerNs);
+        std::cout << "\n[" << section++ << "] Schedule x Chunk x Threads (" << workloadName(kProfile) << ", size "
+            << sweepSize << ", costliest iteration " << costImbalance(kWorkload.units) << "x mean)\n"
+            << kSingleLine << std::endl;
+        runConfigSweep(vects, kWorkload, threadCounts, chunkSizes, harness, sink, counters.get());
     }
 
-    // Imbalanced Workload per Iteration
-    std::cout << "\n[2] Performance Over Increasing Sizes (Imbalanced)\n" << kSingleLine << kSingleLine << std::endl;
-    printTableHeader(kPerformanceHeaders, kPerformanceColWidths, 100);
+    /**
+     * @section Memory Bandwidth
+     */
+    std::cout << std::endl << kDoubleLine << "\nMEMORY BANDWIDTH\n" << kDoubleLine << std::endl;
 
-    // Conduct comparison over increasing vector sizes
-    for (int i = kStartSize; i <= kMaxSize; i *= kSizeMultiplication) {
-        const int kCurrentSize = i;
-        double staticTime = 0;
-        double dynamicTime = 0;
+    // Display configurations
+    std::cout << "Configuration\n" << kSingleLine << std::endl
+        << "Repetition: " << describeBenchmarkOptions(harness) << " (fastest counts)" << std::endl
+        << "Thread counts:";
+    printVector(threadCounts);
+    std::cout << std::endl;
+    runBandwidthSweep(vects, sweepSizes, kValues, threadCounts, harness, kInitThreads, kSingleLine, sink);
 
-        // Initialize vectors
-        initVector(vect1, kCurrentSize, kValue1);
-        initVector(vect2, kCurrentSize, kValue2);
-        initVector(vect3, kCurrentSize, kValue3);
-
-        // Repeat test with current size for consistent average results
-        for (int j = 0; j < kTestCount; j++) {
-            // Measure execution time for static and dynamic scheduling
-            staticTime += measureSchedule(vect1, vect2, vect3, "static", false, kNumThreads);
-            dynamicTime += measureSchedule(vect1, vect2, vect3, "dynamic", false, kNumThreads);
+    /**
+     * @section Trace Export
+     */
+    if (!tracePath.empty()) {
+        std::cout << std::endl << kDoubleLine << "\nTRACE EXPORT\n" << kDoubleLine << std::endl;
+        for (int v = 0; v < 3; ++v)
+            initVector(vects[v], sweepSize, kValues[v], kInitThreads);
+        const Workload kWorkload = makeWorkload(profiles.front(), sweepSize, meanCostNs, kSpinsPerNs);
+        if (!writeScheduleTrace(vects, kWorkload, kNumThreads, tracePath)) {
+            std::cerr << "* * * Error: cannot write trace file '" << tracePath << "' * * *\n";
+            return 1;
         }
-
-        printTableRow({std::to_string(i), std::to_string(staticTime), std::to_string(dynamicTime),
-            std::to_string(staticTime / kTestCount), std::to_string(dynamicTime / kTestCount)}, kPerformanceColWidths);
+        std::cout << "+ + + Wrote " << kAllSchedules.size() << " timelines (" << workloadName(profiles.front()) << ", size "
+            << sweepSize << ", " << kNumThreads << " threads) to " << tracePath << " + + +" << std::endl;
     }
 
-    return 0;
+    // Sections 2-4 as CSV/JSON, and the regression check against a baseline
+    return reportResults(sink, resultsOptions) ? 0 : 1;
 }
\ No newline at end of file
@@ -1,11 +1,64 @@
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
 #include <iomanip>
 #include <iostream>
+#include <memory>
 #include <omp.h>
-#include <random>
 #include <string>
 #include <vector>
 
-using Matrix = std::vector<std::vector<int>>;
+#include "../common/benchmark.h"
+#include "../common/matrix.h"
+#include "../common/options.h"
+#include "../common/perfcounters.h"
+#include "../common/results.h"
+
+/**
+ * @brief Set of reusable result matrices, one per benchmarked kernel.
+ * 
+ * All buffers are allocated and first-touched once per matrix size, then zeroed in
+ * parallel between runs by reset(). Repeated runs therefore time the kernels rather
+ * than the allocator and the page faults of fresh buffers.
+ * 
+ * @tparam T Element type.
+ */
+template <typename T>
+class ResultArena {
+public:
+    /**
+     * @brief Allocates and first-touches `count` result matrices.
+     * 
+     * @param count Number of result matrices.
+     * @param rows Number of rows in each matrix.
+     * @param cols Number of columns in each matrix.
+     * @param numThreads Number of OpenMP threads used for the first touch.
+     */
+    ResultArena(size_t count, int rows, int cols, int numThreads) {
+        buffers_.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            Matrix<T> buffer = Matrix<T>::uninitialized(rows, cols);
+            buffer.zero(numThreads);
+            buffers_.push_back(std::move(buffer));
+        }
+    }
+
+    /**
+     * @brief Zeroes every result matrix in parallel ahead of the next run.
+     * 
+     * @param numThreads Number of OpenMP threads to use.
+     */
+    void reset(int numThreads) {
+        for (Matrix<T>& buffer : buffers_)
+            buffer.zero(numThreads);
+    }
+
+    Matrix<T>& operator[](size_t i) { return buffers_[i]; }
+    size_t size() const { return buffers_.size(); }
+
+private:
+    std::vector<Matrix<T>> buffers_;
+};
 
 /**
  * @brief Prints a formatted table header with fixed column widths.
@@ -20,34 +73,6 @@ void printTableHeader(const std::vector<std::string>& headers, const std::vector
     std::cout << "\n" << std::string(lineLength, '-') << "\n";
 }
 
-/**
- * @brief Prints a grouped table header with main groups and sub-headers.
- * 
- * Creates a two-tier header system with grouped columns for better organization.
- * The first row shows the main group headers, and the second row shows sub-headers.
- * 
- * @param groupHeaders Vector of main group header strings.
- * @param groupWidths Vector of total widths for each group.
- * @param subHeaders Vector of sub-header strings.
- * @param subWidths Vector of widths for each sub-header.
- * @param lineLength The total length of the line separator.
- */
-void printGroupedTableHeader(const std::vector<std::string>& groupHeaders, 
-                            const std::vector<int>& groupWidths,
-                            const std::vector<std::string>& subHeaders, 
-                            const std::vector<int>& subWidths, 
-                            int lineLength) {
-    // Print main group headers
-    for (size_t i = 0; i < groupHeaders.size(); ++i)
-        std::cout << std::left << std::setw(groupWidths[i]) << groupHeaders[i];
-    std::cout << "\n";
-
-    // Print sub-headers
-    for (size_t i = 0; i < subHeaders.size(); ++i)
-        std::cout << std::left << std::setw(subWidths[i]) << subHeaders[i];
-        std::cout << "\n" << std::string(lineLength, '-') << "\n";
-    }
-
 /**
  * @brief Prints a single row in a formatted table.
  * 
@@ -74,195 +99,322 @@ void printVector(const std::vector<int>& vect) {
 }
 
 /**
- * @brief Initializes a matrix with random integer values.
+ * @brief Describes the thread binding policy the next parallel region will use.
  * 
- * Fills the provided matrix with random integers using the given random number
- * generator and distribution. The matrix is filled row by row.
+ * Binding is an OpenMP runtime setting read once at program start, so it is selected
+ * with the `OMP_PROC_BIND` (close, spread) and `OMP_PLACES` (cores, threads, sockets)
+ * environment variables rather than per kernel.
  * 
- * @param rng Reference to a Mersenne Twister random number generator.
- * @param dist Reference to a uniform integer distribution for generating values.
- * @param matrix Reference to the matrix to be initialized.
- * @param rows Number of rows in the matrix.
- * @param cols Number of columns in the matrix.
+ * @return Binding policy and number of places, e.g. "spread (8 places)".
  */
-void initMatrix(std::mt19937& rng, std::uniform_int_distribution<int>& dist,
-    Matrix& matrix, int rows, int cols) {
-    for (int i = 0; i < rows; ++i) {
-        for (int j = 0; j < cols; ++j) {
-            matrix[i][j] = dist(rng);
-        }
+std::string describeThreadBinding() {
+    std::string policy;
+    switch (omp_get_proc_bind()) {
+        case omp_proc_bind_false: policy = "none"; break;
+        case omp_proc_bind_true: policy = "true"; break;
+        case omp_proc_bind_master: policy = "primary"; break;
+        case omp_proc_bind_close: policy = "close"; break;
+        case omp_proc_bind_spread: policy = "spread"; break;
+        default: policy = "unknown"; break;
     }
+    return policy + " (" + std::to_string(omp_get_num_places()) + " places)";
 }
 
+
 /**
- * @brief Performs matrix multiplication using OpenMP with outer loop parallelization.
- * 
- * Multiplies two square matrices using the standard matrix multiplication algorithm
- * with OpenMP parallelization applied to the outermost loop (i-loop). This approach
- * distributes rows of the result matrix across different threads.
- * 
- * @param matrix1 First input matrix (left operand).
- * @param matrix2 Second input matrix (right operand).
- * @param resultMatrix Reference to the output matrix where results are stored.
- * @param size Dimension of the square matrices (size x size).
- * @param numThreads Number of OpenMP threads to use for parallelization.
- * @return Execution time in seconds.
+ * @brief Benchmark parameters shared by every element type run.
  */
-double multiplyOuterParallel(const Matrix& matrix1, const Matrix& matrix2, Matrix& resultMatrix, int size, int numThreads) {
-    double startTime;
-    double endTime;
-
-    startTime = omp_get_wtime();
+struct BenchmarkConfig {
+    std::vector<int> matrixSizes;
+    std::vector<int> numThreads;
+    BenchmarkOptions harness;   // Warmup and adaptive repetition of every kernel x thread count case
+    int tileSize = 0;
+    SimdLevel simdLevel = SimdLevel::Portable;
+    bool numaAware = false;     // First-touch operands in parallel instead of on the master thread
+    int verifyRounds = 0;       // Freivalds rounds per result (0 -> verification disabled)
+    RecursiveParams recursive;  // Cutoff, task depth and Strassen threshold of the task-based kernels
+    const PerfCounters* counters = nullptr;     // Counted around every kernel call (null -> no counters)
+};
 
-    #pragma omp parallel for num_threads(numThreads)
-    for (int i = 0; i < size; ++i) {
-        for (int j = 0; j < size; ++j) {
-            for (int k = 0; k < size; ++k) {
-                resultMatrix[i][j] += matrix1[i][k] * matrix2[k][j];
-            }
-        }
-    }
-
-    endTime = omp_get_wtime();
+/**
+ * @brief A named multiply kernel registered with the benchmark.
+ * 
+ * @tparam T Element type of the matrices.
+ */
+template <typename T>
+struct KernelCase {
+    std::string name;
+    std::function<double(const Matrix<T>&, const Matrix<T>&, Matrix<T>&, int, int)> run;
+};
 
-    return (endTime - startTime);
+/**
+ * @brief Builds the list of multiply kernels compared by the benchmark.
+ * 
+ * @tparam T Element type of the matrices.
+ * @param config Benchmark parameters (tile size and SIMD level).
+ * @return Kernels in table column order.
+ */
+template <typename T>
+std::vector<KernelCase<T>> makeKernelCases(const BenchmarkConfig& config) {
+    const int kTileSize = config.tileSize;
+    const SimdLevel kSimdLevel = config.simdLevel;
+    RecursiveParams kClassicParams = config.recursive;
+    kClassicParams.strassenThreshold = 0;
+    kClassicParams.blockSize = kTileSize;
+    RecursiveParams kStrassenParams = kClassicParams;
+    kStrassenParams.strassenThreshold = config.recursive.strassenThreshold;
+
+    return {
+        {"Outer", multiplyOuterParallel<T>},
+        {"Inner", multiplyInnerParallel<T>},
+        {"InnerPers", multiplyInnerPersistent<T>},
+        {"Collapse", multiplyCollapseParallel<T>},
+        {"Recursive", [=](const Matrix<T>& a, const Matrix<T>& b, Matrix<T>& c, int size, int numThreads) {
+            return multiplyRecursiveTasks(a, b, c, size, numThreads, kClassicParams);
+        }},
+        {"Strassen", [=](const Matrix<T>& a, const Matrix<T>& b, Matrix<T>& c, int size, int numThreads) {
+            return multiplyRecursiveTasks(a, b, c, size, numThreads, kStrassenParams);
+        }},
+        {"Tiled", [=](const Matrix<T>& a, const Matrix<T>& b, Matrix<T>& c, int size, int numThreads) {
+            return multiplyTiledParallel(a, b, c, size, numThreads, kTileSize);
+        }},
+        {"SIMD", [=](const Matrix<T>& a, const Matrix<T>& b, Matrix<T>& c, int size, int numThreads) {
+            return multiplySimdParallel(a, b, c, size, numThreads, kTileSize, kSimdLevel);
+        }},
+    };
 }
 
 /**
- * @brief Performs matrix multiplication using OpenMP with inner loop parallelization.
+ * @brief Runs the full matrix multiplication benchmark for one element type.
  * 
- * Multiplies two square matrices using the standard matrix multiplication algorithm
- * with OpenMP parallelization applied to the middle loop (j-loop). This approach
- * distributes columns of each row across different threads, with the outer loop
- * remaining sequential.
+ * For every matrix size, allocates and initializes the operands and a result arena,
+ * then registers every multiply kernel at every thread count with a BenchmarkSuite
+ * and prints its report, with speedup and efficiency against the 1-thread run of the
+ * same kernel. Each run zeroes its result buffer before and checks it with
+ * verifyFreivalds() after the timed region.
  * 
- * @param matrix1 First input matrix (left operand).
- * @param matrix2 Second input matrix (right operand).
- * @param resultMatrix Reference to the output matrix where results are stored.
- * @param size Dimension of the square matrices (size x size).
- * @param numThreads Number of OpenMP threads to use for parallelization.
- * @return Execution time in seconds.
+ * With counters, each case also reports cycles, instructions, IPC and LLC misses of the
+ * kernel call alone, plus per-thread implicit-barrier idle time when OMPT is built in.
+ * 
+ * The operands are always filled in parallel. In NUMA-aware mode they are also
+ * allocated untouched, so that parallel fill is their first touch and each socket
+ * holds the rows its threads read; otherwise the master thread zeroes (and places)
+ * them first.
+ * 
+ * @tparam T Element type of the matrices.
+ * @param config Benchmark parameters.
+ * @param sink Receives every measured case.
+ * @return False if any kernel produced a wrong result.
  */
-double multiplyInnerParallel(const Matrix& matrix1, const Matrix& matrix2, Matrix& resultMatrix, int size, int numThreads) {
-    double startTime;
-    double endTime;
+template <typename T>
+bool runMatrixBenchmark(const BenchmarkConfig& config, ResultsSink& sink) {
+    const std::vector<KernelCase<T>> kKernels = makeKernelCases<T>(config);
 
-    startTime = omp_get_wtime();
+    // Console UI elements
+    constexpr int kLineLength = 128;
+    const std::string kSingleLine(kLineLength, '-');
+    const std::string kDoubleLine(kLineLength, '=');
 
-    for (int i = 0; i < size; ++i) {
-        #pragma omp parallel for num_threads(numThreads)
-        for (int j = 0; j < size; ++j) {
-            for (int k = 0; k < size; ++k) {
-                resultMatrix[i][j] += matrix1[i][k] * matrix2[k][j];
-            }
-        }
-    }
+    // RNG
+    constexpr uint64_t kSeed = 42;  // Fixed seed; each matrix gets its own derived stream key
 
-    endTime = omp_get_wtime();
+    const int kMaxThreads = *std::max_element(config.numThreads.begin(), config.numThreads.end());
 
-    return (endTime - startTime);
-}
+    std::cout << std::endl << kDoubleLine << "\nELEMENT TYPE: " << ElementTraits<T>::kName
+        << " (SIMD micro-kernel: " << simdLevelName(effectiveSimdLevel<T>(config.simdLevel)) << ")\n" << kDoubleLine << std::endl;
 
-/**
- * @brief Performs matrix multiplication using OpenMP with collapsed loop parallelization.
- * 
- * Multiplies two square matrices using the standard matrix multiplication algorithm
- * with OpenMP parallelization applied using the collapse(2) clause. This approach
- * combines the outer two loops (i and j loops) into a single parallel iteration
- * space, potentially providing better load balancing across threads.
- * 
- * @param matrix1 First input matrix (left operand).
- * @param matrix2 Second input matrix (right operand).
- * @param resultMatrix Reference to the output matrix where results are stored.
- * @param size Dimension of the square matrices (size x size).
- * @param numThreads Number of OpenMP threads to use for parallelization.
- * @return Execution time in seconds.
- */
-double multiplyCollapseParallel(const Matrix& matrix1, const Matrix& matrix2, Matrix& resultMatrix, int size, int numThreads) {
-    double startTime;
-    double endTime;
+    // Experiment with all required matrix sizes
+    for (size_t i = 0; i < config.matrixSizes.size(); ++i) {
+        const int kMatrixSize = config.matrixSizes[i];
 
-    startTime = omp_get_wtime();
+        // Allocate matrices (NUMA-aware mode leaves the first touch to initMatrix)
+        Matrix<T> matrix1 = config.numaAware ? Matrix<T>::uninitialized(kMatrixSize, kMatrixSize) : Matrix<T>(kMatrixSize, kMatrixSize);
+        Matrix<T> matrix2 = config.numaAware ? Matrix<T>::uninitialized(kMatrixSize, kMatrixSize) : Matrix<T>(kMatrixSize, kMatrixSize);
+        ResultArena<T> results(kKernels.size(), kMatrixSize, kMatrixSize, kMaxThreads);
 
-    #pragma omp parallel for collapse(2) num_threads(numThreads)
-    for (int i = 0; i < size; ++i) {
-        for (int j = 0; j < size; ++j) {
-            for (int k = 0; k < size; ++k) {
-                resultMatrix[i][j] += matrix1[i][k] * matrix2[k][j];
+        // Initialize matrices
+        const uint64_t kSizeSeed = kSeed ^ (static_cast<uint64_t>(kMatrixSize) << 32);
+        initMatrix<T>(kSizeSeed, matrix1, kMatrixSize, kMatrixSize, kMaxThreads);
+        initMatrix<T>(kSizeSeed + 1, matrix2, kMatrixSize, kMatrixSize, kMaxThreads);
+
+        std::cout << "\n[" << i + 1 << "] " << kMatrixSize << "x" << kMatrixSize << " Matrix Multiplication"
+            << " - binding: " << describeThreadBinding()
+            << ", first touch: " << (config.numaAware ? "parallel" : "master") << "\n" << kSingleLine << std::endl;
+
+        // Idle time comes only from OMPT here; the kernels do not time their own barriers
+        BarrierIdleProfile idle(kMaxThreads);
+        BarrierIdleProfile* const kIdle = (config.counters != nullptr && hasOmptBarrierTiming()) ? &idle : nullptr;
+        setOmptIdleProfile(kIdle);
+
+        // Register every kernel at every thread count; a wrong result fails the case
+        BenchmarkSuite suite(config.harness);
+        uint64_t verifySeed = kSizeSeed + 2;
+        for (size_t k = 0; k < kKernels.size(); ++k) {
+            for (const int kNumThreads : config.numThreads) {
+                std::shared_ptr<CounterProbe> probe = std::make_shared<CounterProbe>(config.counters, kIdle, kNumThreads);
+                std::function<std::vector<BenchmarkMetric>(int)> metrics;
+                if (config.counters != nullptr)
+                    metrics = [probe](int timedRuns) { return probe->metrics(timedRuns); };
+
+                suite.add(ElementTraits<T>::kName, kKernels[k].name, kMatrixSize, kNumThreads, [&, k, kNumThreads, probe]() {
+                    results[k].zero(kNumThreads);
+                    probe->begin();
+                    const double kElapsed = kKernels[k].run(matrix1, matrix2, results[k], kMatrixSize, kNumThreads);
+                    probe->end();
+
+                    // Verify outside the timed region
+                    if (config.verifyRounds > 0 &&
+                        !verifyFreivalds(matrix1, matrix2, results[k], kMatrixSize, config.verifyRounds, verifySeed++, kNumThreads)) {
+                        std::cerr << "\n* * * Error: " << kKernels[k].name << " kernel produced a wrong result ("
+                            << ElementTraits<T>::kName << ", " << kMatrixSize << "x" << kMatrixSize << ", "
+                            << kNumThreads << " threads) * * *\n\n";
+                        return -1.0;
+                    }
+                    return kElapsed;
+                }, metrics);
             }
         }
-    }
 
-    endTime = omp_get_wtime();
+        const bool kAllCorrect = suite.run();
+        setOmptIdleProfile(nullptr);
+        suite.printReport();
+        sink.addSuite(suite);
+        if (!kAllCorrect)
+            return false;
+
+        if (config.verifyRounds > 0)
+            std::cout << "+ + + All results verified (Freivalds, " << config.verifyRounds << " rounds per run) + + +\n";
+    }
 
-    return (endTime - startTime);
+    return true;
 }
 
-int main() {
+int main(int argc, char** argv) {
     // Console UI elements
     constexpr int kLineLength = 80;
     const std::string kSingleLine(kLineLength, '-');
-    const std::string kDoubleLine(kLineLength, '=');
-    const std::vector<std::string> kGroupHeaders = {"", "Total Time (s)", "Average Time (s)"};
-    const std::vector<int> kGroupWidths = {12, 36, 36};
-    const std::vector<std::string> kSubHeaders = {"NumThreads", "Outer", "Inner", "Collapse", "Outer", "Inner", "Collapse"};
-    const std::vector<int> kSubWidths = {12, 12, 12, 12, 12, 12, 12};
-
-    // RNG
-    std::mt19937 rng(42);   // Mersenne Twister engine with fixed seed
-    std::uniform_int_distribution<int> dist(1, 100);    // Random int from 1-100
 
     // Program configurations
-    const std::vector<int> kMatrixSizeOptions = {50, 500};
-    const std::vector<int> kNumThreadsOptions = {1, 4, 8, 16};
-    constexpr int kTestRuns = 10;
+    BenchmarkConfig config;
+    config.matrixSizes = {50, 500};
+    config.numThreads = {1, 4, 8, 16};
+    config.tileSize = 64;   // Tile edge for the blocked kernels (64x64 ints = 16 KiB per tile)
+    config.simdLevel = detectSimdLevel();
+    config.verifyRounds = 3;
+    config.recursive.cutoff = 128;
+    config.recursive.taskDepth = 4;
+    config.recursive.strassenThreshold = 256;
+
+    // Command-line options
+    const std::string kUsage = "* * * Usage: ./<program_name> [--type=int32|int64|float|double|all] [--sizes=LIST] [--threads=LIST] "
+        "[--numa] [--no-verify] [--cutoff=N] [--task-depth=N] [--strassen-threshold=N] [--counters] " + benchmarkUsage() + " "
+        + resultsUsage() + " " + optionsUsage() + " * * *\n"
+        "* * * LIST: comma-separated values and ranges, e.g. 1,2,4 or 1:cores:x2 or 64:1024:x2 * * *\n\n";
+    std::string elementType = "int32";
+    bool withCounters = false;
+    ResultsOptions resultsOptions;
+    std::vector<std::string> args;
+    std::string configError;
+    if (!expandArguments(argc, argv, "matrix", args, configError)) {
+        std::cerr << "* * * Error: " << configError << " * * *\n" << kUsage;
+        return 1;
+    }
+    for (const std::string& arg : args) {
+        std::string optionError;
+        if (parseBenchmarkOption(arg, config.harness, optionError) || parseResultsOption(arg, resultsOptions, optionError)) {
+            if (!optionError.empty()) {
+                std::cerr << "* * * Error: " << optionError << " * * *\n" << kUsage;
+                return 1;
+            }
+        } else if (arg.rfind("--type=", 0) == 0) {
+            elementType = arg.substr(7);
+        } else if (arg.rfind("--sizes=", 0) == 0) {
+            if (!parseIntList(arg.substr(8), config.matrixSizes) ||
+                *std::min_element(config.matrixSizes.begin(), config.matrixSizes.end()) < 1) {
+                std::cerr << "* * * Error: matrix sizes must be positive integers or ranges * * *\n" << kUsage;
+                return 1;
+            }
+        } else if (arg.rfind("--threads=", 0) == 0) {
+            if (!parseIntList(arg.substr(10), config.numThreads) ||
+                *std::min_element(config.numThreads.begin(), config.numThreads.end()) < 1) {
+                std::cerr << "* * * Error: thread counts must be positive integers or ranges * * *\n" << kUsage;
+                return 1;
+            }
+        } else if (arg == "--numa") {
+            config.numaAware = true;
+        } else if (arg == "--no-verify") {
+            config.verifyRounds = 0;
+        } else if (arg == "--counters") {
+            withCounters = true;
+        } else if (arg.rfind("--cutoff=", 0) == 0) {
+            config.recursive.cutoff = std::atoi(arg.c_str() + 9);
+        } else if (arg.rfind("--task-depth=", 0) == 0) {
+            config.recursive.taskDepth = std::atoi(arg.c_str() + 13);
+        } else if (arg.rfind("--strassen-threshold=", 0) == 0) {
+            config.recursive.strassenThreshold = std::atoi(arg.c_str() + 21);
+        } else {
+            std::cerr << "* * * Error: unknown argument '" << arg << "' * * *\n" << kUsage;
+            return 1;
+        }
+    }
+
+    if (config.recursive.cutoff < 1 || config.recursive.taskDepth < 0 || config.recursive.strassenThreshold < 0) {
+        std::cerr << "* * * Error: cutoff must be positive, task depth and Strassen threshold non-negative * * *\n" << kUsage;
+        return 1;
+    }
+
+    const bool runAll = (elementType == "all");
+    if (!runAll && elementType != "int32" && elementType != "int64" && elementType != "float" && elementType != "double") {
+        std::cerr << "* * * Error: unsupported element type '" << elementType << "' * * *\n" << kUsage;
+        return 1;
+    }
+
+    // Opened before the first parallel region, so the OpenMP threads inherit the counters
+    std::unique_ptr<PerfCounters> counters;
+    if (withCounters) {
+        counters.reset(new PerfCounters());
+        config.counters = counters.get();
+    }
 
     // Display configurations
     std::cout << "Configuration\n" << kSingleLine;
+    std::cout << "\nElement Type: " << elementType;
     std::cout << "\nMatrix Size Options:";
-    printVector(kMatrixSizeOptions);
+    printVector(config.matrixSizes);
     std::cout << "\nNumThreads Options:";
-    printVector(kNumThreadsOptions);
-    std::cout << "\nTest Runs per NumThreads: " << kTestRuns << std::endl;
-
-    // Experiment with all required matrix sizes
-    for (int i = 0; i < kMatrixSizeOptions.size(); ++i) {
-        const int kMatrixSize = kMatrixSizeOptions[i];
-
-        // Allocate matrices
-        Matrix matrix1(kMatrixSize, std::vector<int>(kMatrixSize));
-        Matrix matrix2(kMatrixSize, std::vector<int>(kMatrixSize));
-
-        // Initialize matrices
-        initMatrix(rng, dist, matrix1, kMatrixSize, kMatrixSize);
-        initMatrix(rng, dist, matrix2, kMatrixSize, kMatrixSize);
-
-        // Experiment with all required number of threads
-        std::cout << "\n[" << i + 1 << "] " << kMatrixSize << "x" << kMatrixSize << " Matrix Multiplication\n" << kSingleLine << std::endl;
-        printGroupedTableHeader(kGroupHeaders, kGroupWidths, kSubHeaders, kSubWidths, kLineLength);
-
-        for (const int kNumThreads : kNumThreadsOptions) {
-            double outerTotalTime = 0;
-            double innerTotalTime = 0;
-            double collapseTotalTime = 0;
-
-            // Repeat test to get average result
-            for (int j = 0; j < kTestRuns; ++j) {
-                Matrix outerResult(kMatrixSize, std::vector<int>(kMatrixSize));
-                Matrix innerResult(kMatrixSize, std::vector<int>(kMatrixSize));
-                Matrix collapseResult(kMatrixSize, std::vector<int>(kMatrixSize));
-
-                outerTotalTime += multiplyOuterParallel(matrix1, matrix2, outerResult, kMatrixSize, kNumThreads);
-                innerTotalTime += multiplyInnerParallel(matrix1, matrix2, innerResult, kMatrixSize, kNumThreads);
-                collapseTotalTime += multiplyCollapseParallel(matrix1, matrix2, collapseResult, kMatrixSize, kNumThreads);
-            }
-
-            printTableRow({std::to_string(kNumThreads),
-                std::to_string(outerTotalTime), std::to_string(innerTotalTime), std::to_string(collapseTotalTime),
-                std::to_string((outerTotalTime / kTestRuns)), std::to_string((innerTotalTime / kTestRuns)), std::to_string((collapseTotalTime / kTestRuns))},
-                kSubWidths);
-        }
+    printVector(config.numThreads);
+    std::cout << "\nRepetition: " << describeBenchmarkOptions(config.harness);
+    std::cout << "\nTile Size: " << config.tileSize << "x" << config.tileSize;
+    std::cout << "\nSIMD Micro-kernel: " << simdLevelName(config.simdLevel) << " (" << kMr << "x" << kNr << " register block)";
+    std::cout << "\nNUMA-aware First Touch: " << (config.numaAware ? "on" : "off");
+    std::cout << "\nThread Binding: " << describeThreadBinding();
+    std::cout << "\nRecursive Cutoff: " << config.recursive.cutoff << ", Task Depth: " << config.recursive.taskDepth
+        << ", Strassen Threshold: " << config.recursive.strassenThreshold;
+    std::cout << "\nVerification: " << (config.verifyRounds > 0 ? "Freivalds, " + std::to_string(config.verifyRounds) + " rounds" : "off");
+    std::cout << "\nHardware Counters: " << (counters ? counters->describe() : "off")
+        << (counters && hasOmptBarrierTiming() ? " + OMPT barrier idle time" : "") << std::endl;
+
+    if (counters && !counters->anyAvailable())
+        std::cout << "\n- - - Warning: hardware counters unavailable, no counter columns are reported - - -\n";
+
+    if (config.numaAware && omp_get_proc_bind() == omp_proc_bind_false) {
+        std::cout << "\n- - - Warning: threads are not bound, so first-touch placement can drift - "
+            << "set OMP_PROC_BIND=close|spread and OMP_PLACES=cores - - -\n";
     }
 
-    return 0;
+    // Stop at the first wrong result so a broken kernel cannot report a timing
+    ResultsSink sink("openmp_partc_matrix");
+    bool isCorrect = true;
+    if (isCorrect && (runAll || elementType == "int32"))
+        isCorrect = runMatrixBenchmark<int32_t>(config, sink);
+    if (isCorrect && (runAll || elementType == "int64"))
+        isCorrect = runMatrixBenchmark<int64_t>(config, sink);
+    if (isCorrect && (runAll || elementType == "float"))
+        isCorrect = runMatrixBenchmark<float>(config, sink);
+    if (isCorrect && (runAll || elementType == "double"))
+        isCorrect = runMatrixBenchmark<double>(config, sink);
+
+    // Failed cases are written too
+    const bool kIsPassing = reportResults(sink, resultsOptions);
+    return (isCorrect && kIsPassing) ? 0 : 1;
 }
\ No newline at end of file